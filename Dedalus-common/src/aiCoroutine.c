@@ -0,0 +1,175 @@
+/**
+ * @file aiCoroutine.c
+ * @brief AIs run as coroutines, each one on its own stack.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdint.h>    // uintptr_t
+#include <stdio.h>     // fprintf
+#include <sys/mman.h>  // mmap, mprotect
+#include <unistd.h>    // sysconf
+
+#include "aiCoroutine.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Entry of every coroutine: run the body of the AI.
+ *
+ * @param[in] hi High half of the address of the coroutine.
+ * @param[in] lo Low half of the address of the coroutine.
+ * @note makecontext only passes ints, the address is split in two.
+ */
+void _coro_entry(unsigned int hi, unsigned int lo);
+
+/**
+ * @brief Set the coroutine at the beginning of the body of its AI.
+ *
+ * @param[in,out] pCo The coroutine (its stack is mapped).
+ */
+void _coro_start(coro_t* pCo);
+
+/**
+ * @brief Switch to the AI until it yields (run by budget_run()).
+ *
+ * @param[in,out] arg The coroutine.
+ */
+void _coro_resume(void* arg);
+
+/**
+ * @brief Body of an AI without coroutine: call its policy at each step.
+ *
+ * @param[in,out] pCo The coroutine.
+ */
+void _coro_policy_body(coro_t* pCo);
+
+/**********************************/
+//  Public functions implementation
+
+bool coro_init(coro_t* pCo, ai_t ai, size_t stackSize) {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  if (stackSize == 0) {
+    stackSize = CORO_STACK_SIZE;
+  }
+  stackSize = ((stackSize + page - 1) / page + 1) * page;
+
+  pCo->stack = mmap(NULL, stackSize, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+  if (pCo->stack == MAP_FAILED) {
+    pCo->stack = NULL;
+    return false;
+  }
+  // An overflow hits the guard page instead of the neighbour
+  if (mprotect(pCo->stack, page, PROT_NONE) != 0) {
+    munmap(pCo->stack, stackSize);
+    pCo->stack = NULL;
+    return false;
+  }
+  pCo->stackSize = stackSize;
+  pCo->ai = ai;
+  _coro_start(pCo);
+  return true;
+}
+
+void coro_delete(coro_t* pCo) {
+  if (pCo->stack != NULL) {
+    munmap(pCo->stack, pCo->stackSize);
+  }
+  pCo->stack = NULL;
+  pCo->stackSize = 0;
+}
+
+compass_t coro_propose_move(coro_t* pCo,
+                            character_t* pC,
+                            const map_t* pMap,
+                            const budget_t* pBudget,
+                            bool* pCheated,
+                            bool* pOverrun) {
+  coro_view_t* pView = &(pCo->view);
+  pView->north = character_can_go(pC, pMap, North);
+  pView->east = character_can_go(pC, pMap, East);
+  pView->south = character_can_go(pC, pMap, South);
+  pView->west = character_can_go(pC, pMap, West);
+  pView->comp = pC->targetCompass;
+  pView->distance = pC->targetDistance;
+  pView->ariane = pC->ariadne;
+  pView->rng = &(pC->rng);
+
+  pCo->move = Stay;
+  *pOverrun = false;
+  if (!pCo->over) {
+    *pOverrun = !budget_run(pBudget, &_coro_resume, pCo);
+    if (pCo->over) {
+      // Reported once, the character stays silently from now on
+      fprintf(stderr, "The body of %s (%s) returned: it stays from now on.\n",
+              pC->name, pCo->ai.name);
+    }
+  }
+
+  compass_t move = pCo->move;
+  *pCheated = !((move == Stay) || ((move == North) && pView->north) ||
+                ((move == East) && pView->east) ||
+                ((move == South) && pView->south) ||
+                ((move == West) && pView->west));
+  return move;
+}
+
+const coro_view_t* coro_view(const coro_t* pCo) {
+  return &(pCo->view);
+}
+
+const coro_view_t* coro_yield(coro_t* pCo, compass_t move) {
+  pCo->move = move;
+  swapcontext(&(pCo->ctx), &(pCo->caller));
+  return &(pCo->view);
+}
+
+/**********************************/
+//  Local functions implementation
+
+void _coro_start(coro_t* pCo) {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  pCo->move = Stay;
+  pCo->over = false;
+
+  getcontext(&(pCo->ctx));
+  pCo->ctx.uc_stack.ss_sp = (char*)pCo->stack + page;
+  pCo->ctx.uc_stack.ss_size = pCo->stackSize - page;
+  pCo->ctx.uc_link = &(pCo->caller);
+  uintptr_t addr = (uintptr_t)pCo;
+  makecontext(&(pCo->ctx), (void (*)(void))&_coro_entry, 2,
+              (unsigned int)((uint64_t)addr >> 32),
+              (unsigned int)(addr & 0xffffffffu));
+}
+
+void _coro_resume(void* arg) {
+  coro_t* pCo = (coro_t*)arg;
+  swapcontext(&(pCo->caller), &(pCo->ctx));
+}
+
+void _coro_entry(unsigned int hi, unsigned int lo) {
+  coro_t* pCo = (coro_t*)(uintptr_t)(((uint64_t)hi << 32) | (uint64_t)lo);
+  if (pCo->ai.coroutine != NULL) {
+    (*(pCo->ai.coroutine))(pCo);
+  } else {
+    _coro_policy_body(pCo);
+  }
+  // Back to the caller through uc_link
+  pCo->over = true;
+}
+
+void _coro_policy_body(coro_t* pCo) {
+  const coro_view_t* pView = coro_view(pCo);
+  while (true) {
+    compass_t move =
+        (*(pCo->ai.policy))(pView->north, pView->east, pView->south,
+                            pView->west, pView->comp, pView->distance,
+                            pView->ariane, pView->rng);
+    pView = coro_yield(pCo, move);
+  }
+}
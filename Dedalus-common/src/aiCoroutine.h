@@ -0,0 +1,136 @@
+/**
+ * @file aiCoroutine.h
+ * @brief AIs run as coroutines, each one on its own stack.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * A coroutine runs the body of an AI until it yields a move, then the game
+ * goes on; the next step resumes the body where it stopped. The locals of the
+ * body are kept between steps, without process nor thread: a switch is a
+ * swapcontext(3).
+ *
+ * An AI with a coroutine body (see ai_t) is written as a loop:
+ * @code
+ * void my_ai_body(coro_t* pCo) {
+ *   compass_t heading = North;  // kept from one step to the next
+ *   const coro_view_t* pView = coro_view(pCo);
+ *   while (true) {
+ *     // ... choose a move from pView and heading ...
+ *     pView = coro_yield(pCo, heading);
+ *   }
+ * }
+ * @endcode
+ * Other AIs have their policy called by a generic body at each step. A body
+ * that returns is reported on stderr, its character stays from then on.
+ *
+ * The budget of a coroutine is soft (see moveBudget.h): an AI that overruns
+ * it still yields its move, which is replaced by the penalty, and its body
+ * goes on at the next step. A hung AI hangs the game.
+ */
+#ifndef AI_COROUTINE_H
+#define AI_COROUTINE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "ai.h"
+#include "character.h"
+#include "map.h"
+#include "moveBudget.h"
+#include "rng.h"
+
+/**
+ * @brief Default size of the stack of a coroutine (only the touched pages
+ * use memory).
+ *
+ */
+#define CORO_STACK_SIZE ((size_t)64 * 1024)
+
+/**
+ * @brief What an AI sees at a step (the arguments of a policy).
+ *
+ */
+typedef struct coro_view {
+  bool north;      ///< Can go to the north.
+  bool east;       ///< Can go to the east.
+  bool south;      ///< Can go to the south.
+  bool west;       ///< Can go to the west.
+  compass_t comp;  ///< Direction of the target.
+  float distance;  ///< Distance to the target.
+  string ariane;   ///< Ariadne string of the character.
+  rng_t* rng;      ///< Random generator of the character.
+} coro_view_t;
+
+/**
+ * @brief An AI running as a coroutine.
+ *
+ */
+typedef struct coro {
+  ucontext_t ctx;     ///< Context of the AI, while the game runs.
+  ucontext_t caller;  ///< Context of the game, while the AI runs.
+  void* stack;        ///< Mapping of the stack (a guard page first).
+  size_t stackSize;   ///< Size of the mapping.
+  ai_t ai;            ///< The AI.
+  coro_view_t view;   ///< What the AI sees at the current step.
+  compass_t move;     ///< Last move yielded.
+  bool over;          ///< The body returned (Stay from now on).
+} coro_t;
+
+/**
+ * @brief Create the coroutine of an AI (its body starts at the first resume).
+ *
+ * @param[out] pCo The coroutine.
+ * @param[in] ai The AI.
+ * @param[in] stackSize Size of its stack (0: CORO_STACK_SIZE).
+ * @return true The coroutine is ready.
+ * @return false The stack can not be mapped.
+ */
+bool coro_init(coro_t* pCo, ai_t ai, size_t stackSize);
+
+/**
+ * @brief Free a coroutine (its body is dropped where it stopped).
+ *
+ * @param[in,out] pCo The coroutine.
+ */
+void coro_delete(coro_t* pCo);
+
+/**
+ * @brief Run the AI of a character until it yields its next move.
+ *
+ * @param[in,out] pCo The coroutine of the AI.
+ * @param[in,out] pC The character (its AI may draw numbers).
+ * @param[in] pMap The map.
+ * @param[in] pBudget Time given to the AI.
+ * @param[out] pCheated Is the move impossible?
+ * @param[out] pOverrun Did the AI yield after its budget?
+ * @return compass_t The move yielded (the game applies the penalty of an
+ * overrun).
+ */
+compass_t coro_propose_move(coro_t* pCo,
+                            character_t* pC,
+                            const map_t* pMap,
+                            const budget_t* pBudget,
+                            bool* pCheated,
+                            bool* pOverrun);
+
+/**
+ * @brief What the AI sees at the current step.
+ *
+ * @param[in] pCo The coroutine (from the body of the AI).
+ * @return const coro_view_t* The view, valid until the next yield.
+ */
+const coro_view_t* coro_view(const coro_t* pCo);
+
+/**
+ * @brief Give a move to the game and wait for the next step.
+ *
+ * @param[in,out] pCo The coroutine (from the body of the AI).
+ * @param[in] move The move of this step.
+ * @return const coro_view_t* What the AI sees at the next step.
+ */
+const coro_view_t* coro_yield(coro_t* pCo, compass_t move);
+
+#endif  // End of AI_COROUTINE_H
@@ -0,0 +1,416 @@
+/**
+ * @file aiSandbox.c
+ * @brief Long-lived worker processes running the AIs out of the game process.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <errno.h>      // errno, EINTR
+#include <fcntl.h>      // O_* constants
+#include <poll.h>       // poll
+#include <signal.h>     // kill, signal
+#include <stdint.h>     // uintptr_t
+#include <stdio.h>      // snprintf
+#include <string.h>     // memcpy
+#include <sys/mman.h>   // shm_open, mmap
+#include <sys/prctl.h>  // prctl
+#include <sys/wait.h>   // waitpid
+#include <time.h>       // clock_gettime
+#include <unistd.h>     // fork, pipe
+
+#include "aiSandbox.h"
+#include "display.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Request sent to a worker at each step.
+ *
+ */
+typedef struct sandbox_request {
+  pos_t pos;                ///< Position of the character.
+  compass_t targetCompass;  ///< Direction of the target.
+  float targetDistance;     ///< Distance of the target.
+  compass_t played;         ///< Move played at the previous step.
+  bool hasPlayed;           ///< Is played meaningful for the worker?
+  rng_t rng;                ///< Random generator of the character.
+} sandbox_request_t;
+
+/**
+ * @brief Reply of a worker.
+ *
+ */
+typedef struct sandbox_reply {
+  compass_t move;  ///< The move proposed by the AI.
+  bool overrun;    ///< The AI answered after its budget (the move is Stay).
+  uint64_t ns;     ///< Time taken by the AI (in ns).
+  rng_t rng;       ///< Random generator after the move.
+} sandbox_reply_t;
+
+/**
+ * @brief Read a whole message from a pipe.
+ *
+ * @param[in] fd The pipe.
+ * @param[out] buffer The message.
+ * @param[in] size Size of the message.
+ * @return true The message is read.
+ * @return false The pipe is closed or broken.
+ */
+bool _sandbox_read(int fd, void* buffer, size_t size);
+
+/**
+ * @brief Write a whole message in a pipe.
+ *
+ * @param[in] fd The pipe.
+ * @param[in] buffer The message.
+ * @param[in] size Size of the message.
+ * @return true The message is written.
+ * @return false The pipe is closed or broken.
+ */
+bool _sandbox_write(int fd, const void* buffer, size_t size);
+
+/**
+ * @brief Fork a worker for a character.
+ *
+ * @param[in,out] pBox The sandbox.
+ * @param[in] i Index of the worker.
+ * @param[in] pC The character served by the worker.
+ */
+void _sandbox_spawn(sandbox_t* pBox, size_t i, const character_t* pC);
+
+/**
+ * @brief Main loop of a worker (never returns).
+ *
+ * @param[in] pBox The sandbox (as copied in the worker).
+ * @param[in] reqFd Read end of the requests pipe.
+ * @param[in] repFd Write end of the replies pipe.
+ * @param[in] self Copy of the character served by the worker.
+ */
+void _sandbox_serve(const sandbox_t* pBox,
+                    int reqFd,
+                    int repFd,
+                    character_t self);
+
+/**
+ * @brief Kill a worker and close its pipes.
+ *
+ * @param[in,out] pWorker The worker to stop.
+ */
+void _sandbox_stop(sandbox_worker_t* pWorker);
+
+/**********************************/
+//  Local functions implementation
+
+bool _sandbox_read(int fd, void* buffer, size_t size) {
+  char* p = (char*)buffer;
+  while (size > 0) {
+    ssize_t nb = read(fd, p, size);
+    if (nb < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nb <= 0) {
+      return false;
+    }
+    p += nb;
+    size -= (size_t)nb;
+  }
+  return true;
+}
+
+bool _sandbox_write(int fd, const void* buffer, size_t size) {
+  const char* p = (const char*)buffer;
+  while (size > 0) {
+    ssize_t nb = write(fd, p, size);
+    if (nb < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nb <= 0) {
+      return false;
+    }
+    p += nb;
+    size -= (size_t)nb;
+  }
+  return true;
+}
+
+void _sandbox_spawn(sandbox_t* pBox, size_t i, const character_t* pC) {
+  int req[2];
+  int rep[2];
+  if ((pipe(req) != 0) || (pipe(rep) != 0)) {
+    display_fatal_error(stderr, "Error: can not create AI worker pipes!");
+    exit(EXIT_FAILURE);
+  }
+
+  pid_t pid = fork();
+  if (pid == -1) {
+    display_fatal_error(stderr, "Error: can not fork AI worker!");
+    exit(EXIT_FAILURE);
+  }
+
+  if (pid == 0) {
+    // Die with the game
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+    // Keep only our own pipes, so that other workers see their EOF.
+    close(req[1]);
+    close(rep[0]);
+    for (size_t j = 0; j < pBox->nbWorkers; ++j) {
+      if ((j != i) && (pBox->workerA[j].pid != 0)) {
+        close(pBox->workerA[j].reqFd);
+        close(pBox->workerA[j].repFd);
+      }
+    }
+
+    // The AI can not change the game map nor draw on the game screen.
+    mprotect(pBox->snapshot, pBox->snapshotSize, PROT_READ);
+    int devNull = open("/dev/null", O_RDWR);
+    if (devNull >= 0) {
+      dup2(devNull, STDIN_FILENO);
+      dup2(devNull, STDOUT_FILENO);
+      close(devNull);
+    }
+
+    _sandbox_serve(pBox, req[0], rep[1], *pC);
+  }
+
+  close(req[0]);
+  close(rep[1]);
+  sandbox_worker_t* pWorker = &(pBox->workerA[i]);
+  pWorker->pid = pid;
+  pWorker->reqFd = req[1];
+  pWorker->repFd = rep[0];
+  pWorker->fresh = true;
+  pWorker->pending = false;
+  pWorker->move = Stay;
+}
+
+void _sandbox_serve(const sandbox_t* pBox,
+                    int reqFd,
+                    int repFd,
+                    character_t self) {
+  // View of the shared snapshot as a map
+  map_t view;
+  if (!map_view_init(&view, pBox->snapshot, pBox->pMap->x, pBox->pMap->y)) {
+    _exit(EXIT_FAILURE);
+  }
+
+  sandbox_request_t req;
+  while (_sandbox_read(reqFd, &req, sizeof(req))) {
+    self.pos = req.pos;
+    if (req.hasPlayed) {
+      character_record_move(&self, &view, req.played);
+    }
+    self.targetCompass = req.targetCompass;
+    self.targetDistance = req.targetDistance;
+    self.rng = req.rng;
+
+    bool cheated;  // checked again by the game anyway
+    sandbox_reply_t rep;
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    rep.move = budget_propose_move(&(pBox->budget), &self, &view, &cheated,
+                                   &(rep.overrun));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    rep.ns = (uint64_t)((end.tv_sec - start.tv_sec) * 1000000000L +
+                        (end.tv_nsec - start.tv_nsec));
+    rep.rng = self.rng;
+    if (!_sandbox_write(repFd, &rep, sizeof(rep))) {
+      break;
+    }
+  }
+
+  map_view_delete(&view);
+  // Leave without flushing the streams shared with the game.
+  _exit(EXIT_SUCCESS);
+}
+
+void _sandbox_stop(sandbox_worker_t* pWorker) {
+  if (pWorker->pid != 0) {
+    kill(pWorker->pid, SIGKILL);
+    waitpid(pWorker->pid, NULL, 0);
+    close(pWorker->reqFd);
+    close(pWorker->repFd);
+  }
+  pWorker->pid = 0;
+  pWorker->reqFd = -1;
+  pWorker->repFd = -1;
+  pWorker->pending = false;
+  pWorker->move = Stay;
+}
+
+/**********************************/
+//  Public functions implementation
+
+void sandbox_init(sandbox_t* pBox,
+                  const map_t* pMap,
+                  character_t* const* pCharA,
+                  size_t nbChar,
+                  const budget_t* pBudget) {
+  pBox->pMap = pMap;
+  pBox->nbWorkers = nbChar;
+  pBox->budget = *pBudget;
+
+  // A dead worker must not kill the game when we write its pipe.
+  signal(SIGPIPE, SIG_IGN);
+
+  // Shared snapshot of the map. The name is removed at once, the mapping is
+  // inherited by the workers.
+  char name[64];
+  snprintf(name, sizeof(name), "/dedalus-%d-%lx", (int)getpid(),
+           (unsigned long)(uintptr_t)pBox);
+  int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    display_fatal_error(stderr, "Error: can not open shared memory!");
+    exit(EXIT_FAILURE);
+  }
+  shm_unlink(name);
+  pBox->snapshotSize = (pMap->x + 1) * pMap->y;
+  if (ftruncate(fd, (off_t)pBox->snapshotSize) != 0) {
+    display_fatal_error(stderr, "Error: can not size shared memory!");
+    exit(EXIT_FAILURE);
+  }
+  pBox->snapshot = (char*)mmap(NULL, pBox->snapshotSize,
+                               PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (pBox->snapshot == MAP_FAILED) {
+    display_fatal_error(stderr, "Error: can not map shared memory!");
+    exit(EXIT_FAILURE);
+  }
+  sandbox_snapshot(pBox);
+
+  // NOTE: malloc(0) return NULL so it is ok
+  pBox->workerA =
+    (sandbox_worker_t*)malloc(nbChar * sizeof(sandbox_worker_t));
+  if ((nbChar > 0) && (pBox->workerA == NULL)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < nbChar; ++i) {
+    pBox->workerA[i].pid = 0;
+  }
+  for (size_t i = 0; i < nbChar; ++i) {
+    _sandbox_spawn(pBox, i, pCharA[i]);
+  }
+}
+
+void sandbox_snapshot(sandbox_t* pBox) {
+  size_t rowSize = pBox->pMap->x + 1;
+  for (size_t r = 0; r < pBox->pMap->y; ++r) {
+    memcpy(&(pBox->snapshot[r * rowSize]), pBox->pMap->m[r], rowSize);
+  }
+}
+
+void sandbox_request(sandbox_t* pBox,
+                     size_t i,
+                     const character_t* pC,
+                     compass_t played) {
+  sandbox_worker_t* pWorker = &(pBox->workerA[i]);
+  if (pWorker->pid == 0) {
+    // Fork again a worker that failed, it starts from the current character.
+    _sandbox_spawn(pBox, i, pC);
+  }
+
+  sandbox_request_t req;
+  req.pos = pC->pos;
+  req.targetCompass = pC->targetCompass;
+  req.targetDistance = pC->targetDistance;
+  req.played = played;
+  req.hasPlayed = !pWorker->fresh;
+  req.rng = pC->rng;
+  pWorker->fresh = false;
+
+  pWorker->move = Stay;
+  pWorker->overrun = false;
+  pWorker->ns = 0;
+  pWorker->rng = pC->rng;
+  if (_sandbox_write(pWorker->reqFd, &req, sizeof(req))) {
+    pWorker->pending = true;
+  } else {
+    _sandbox_stop(pWorker);
+  }
+}
+
+void sandbox_wait(sandbox_t* pBox) {
+  struct timespec deadline;
+  budget_deadline(&(pBox->budget), &deadline);
+
+  struct pollfd fds[pBox->nbWorkers + 1];
+  size_t idx[pBox->nbWorkers + 1];
+  bool waiting = true;
+  while (waiting) {
+    size_t nb = 0;
+    for (size_t i = 0; i < pBox->nbWorkers; ++i) {
+      if (pBox->workerA[i].pending) {
+        fds[nb].fd = pBox->workerA[i].repFd;
+        fds[nb].events = POLLIN;
+        fds[nb].revents = 0;
+        idx[nb] = i;
+        ++nb;
+      }
+    }
+
+    int left = budget_time_left(&deadline);
+    if ((nb == 0) || (left == 0)) {
+      waiting = false;
+    } else {
+      int res = poll(fds, (nfds_t)nb, left);
+      if ((res < 0) && (errno != EINTR)) {
+        display_fatal_error(stderr, "Error: poll on AI workers failed!");
+        exit(EXIT_FAILURE);
+      }
+      for (size_t k = 0; (res > 0) && (k < nb); ++k) {
+        if (fds[k].revents != 0) {
+          sandbox_worker_t* pWorker = &(pBox->workerA[idx[k]]);
+          sandbox_reply_t rep;
+          if (_sandbox_read(pWorker->repFd, &rep, sizeof(rep))) {
+            pWorker->move = rep.move;
+            pWorker->overrun = rep.overrun;
+            pWorker->ns = rep.ns;
+            pWorker->rng = rep.rng;
+            pWorker->pending = false;
+          } else {
+            _sandbox_stop(pWorker);
+          }
+        }
+      }
+    }
+  }
+
+  // Too late: the hard deadline
+  for (size_t i = 0; i < pBox->nbWorkers; ++i) {
+    if (pBox->workerA[i].pending) {
+      _sandbox_stop(&(pBox->workerA[i]));
+      pBox->workerA[i].overrun = true;
+    }
+  }
+}
+
+compass_t sandbox_reply(const sandbox_t* pBox,
+                        size_t i,
+                        rng_t* pRng,
+                        bool* pOverrun,
+                        uint64_t* pNs) {
+  *pRng = pBox->workerA[i].rng;
+  *pOverrun = pBox->workerA[i].overrun;
+  *pNs = pBox->workerA[i].ns;
+  return pBox->workerA[i].move;
+}
+
+void sandbox_delete(sandbox_t* pBox) {
+  for (size_t i = 0; i < pBox->nbWorkers; ++i) {
+    _sandbox_stop(&(pBox->workerA[i]));
+  }
+  free(pBox->workerA);
+  pBox->workerA = NULL;
+  pBox->nbWorkers = 0;
+
+  munmap(pBox->snapshot, pBox->snapshotSize);
+  pBox->snapshot = NULL;
+  pBox->snapshotSize = 0;
+  pBox->pMap = NULL;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file aiSandbox.h
+ * @brief Long-lived worker processes running the AIs out of the game process.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef AI_SANDBOX_H
+#define AI_SANDBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include "character.h"
+#include "map.h"
+#include "moveBudget.h"
+#include "rng.h"
+
+/**
+ * @brief A worker process dedicated to one character.
+ *
+ */
+typedef struct sandbox_worker {
+  pid_t pid;       ///< Pid of the process (0 if not running).
+  int reqFd;       ///< Write end of the requests pipe.
+  int repFd;       ///< Read end of the replies pipe.
+  bool fresh;      ///< Forked since the last move played by the character.
+  bool pending;    ///< A reply is expected.
+  compass_t move;  ///< Last reply (Stay if none came in time).
+  bool overrun;    ///< The AI did not answer within its budget.
+  uint64_t ns;     ///< Time taken by the AI (in ns, 0 if no reply).
+  rng_t rng;       ///< Random generator of the character after the reply.
+} sandbox_worker_t;
+
+/**
+ * @brief The set of AI workers of a game.
+ *
+ * Each step the game copies the map in a shared memory snapshot (read only for
+ * the workers) and sends the character state through a pipe. The worker keeps
+ * its own copy of the character, including its Ariadne string, and answers
+ * with the move proposed by the AI and whether it overran its budget. A
+ * worker that still does not answer BUDGET_SLACK_MS after the budget, or that
+ * fails, is killed and forked again at its next request: a hung AI costs its
+ * budget, never more.
+ */
+typedef struct sandbox {
+  const map_t* pMap;           ///< The game map.
+  char* snapshot;              ///< Shared copy of the map (rows of x+1 chars).
+  size_t snapshotSize;         ///< Size of the snapshot (in bytes).
+  sandbox_worker_t* workerA;   ///< Array of workers (one per character).
+  size_t nbWorkers;            ///< Number of workers.
+  budget_t budget;             ///< Time given to the AIs at each step.
+} sandbox_t;
+
+/**
+ * @brief Initialize the sandbox and fork the workers.
+ *
+ * @param[out] pBox The sandbox to initialize.
+ * @param[in] pMap The game map.
+ * @param[in] pCharA Array of pointers to the characters (one per worker).
+ * @param[in] nbChar Number of characters.
+ * @param[in] pBudget Time given to the AIs at each step.
+ */
+void sandbox_init(sandbox_t* pBox,
+                  const map_t* pMap,
+                  character_t* const* pCharA,
+                  size_t nbChar,
+                  const budget_t* pBudget);
+
+/**
+ * @brief Copy the current map in the shared snapshot.
+ *
+ * @param[in,out] pBox The sandbox.
+ * @note Must be called before the requests of a step.
+ */
+void sandbox_snapshot(sandbox_t* pBox);
+
+/**
+ * @brief Ask a worker for the move of its character.
+ *
+ * @param[in,out] pBox The sandbox.
+ * @param[in] i Index of the worker.
+ * @param[in] pC The character (as known by the game).
+ * @param[in] played Move played by the character at the previous step.
+ */
+void sandbox_request(sandbox_t* pBox,
+                     size_t i,
+                     const character_t* pC,
+                     compass_t played);
+
+/**
+ * @brief Wait for the replies of all pending requests.
+ *
+ * @param[in,out] pBox The sandbox.
+ * @note Workers still silent when the budget (and the slack) expires are
+ * killed: their AI overran and their move is Stay.
+ */
+void sandbox_wait(sandbox_t* pBox);
+
+/**
+ * @brief Get the move replied by a worker.
+ *
+ * @param[in] pBox The sandbox.
+ * @param[in] i Index of the worker.
+ * @param[out] pRng Random generator of the character after the move
+ * (unchanged if the worker did not answer).
+ * @param[out] pOverrun Did the AI overrun its budget?
+ * @param[out] pNs Time taken by the AI (in ns, 0 if the worker did not
+ * answer).
+ * @return compass_t The move (not checked, it may be a cheat).
+ */
+compass_t sandbox_reply(const sandbox_t* pBox,
+                        size_t i,
+                        rng_t* pRng,
+                        bool* pOverrun,
+                        uint64_t* pNs);
+
+/**
+ * @brief Stop all workers and clear the sandbox.
+ *
+ * @param[in,out] pBox The sandbox to clear.
+ */
+void sandbox_delete(sandbox_t* pBox);
+
+#endif  // End of AI_SANDBOX_H
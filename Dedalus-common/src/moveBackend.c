@@ -0,0 +1,501 @@
+/**
+ * @file moveBackend.c
+ * @brief Backends asking the AIs for their moves (see backend_t).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <errno.h>     // errno
+#include <poll.h>      // poll
+#include <signal.h>    // kill
+#include <stdio.h>     // stderr
+#include <sys/mman.h>  // mmap
+#include <sys/wait.h>  // waitpid
+#include <unistd.h>    // fork, pipe, sysconf
+
+#include "display.h"
+#include "moveBackend.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Shared argument of the move proposition tasks.
+ *
+ */
+typedef struct moves_job {
+  const moves_backend_t* pBackend;  ///< The backend (read only).
+  moves_prop_t* pMoves;             ///< Propositions to fill (one per task).
+} moves_job_t;
+
+/**
+ * @brief Ask the AI of one character for its move (pool task).
+ *
+ * @param[in,out] arg The moves_job_t of the step.
+ * @param[in] i Index of the character in the propositions.
+ */
+void _backend_propose_move_task(void* arg, size_t i);
+
+/**
+ * @brief The functions of a backend.
+ *
+ */
+typedef struct backend_ops {
+  /// Start the backend before the first step (NULL: nothing to start).
+  void (*start)(moves_backend_t* pBackend, moves_prop_t* pMoves, size_t nbChar);
+  /// Fill the propositions of a step.
+  void (*propose)(moves_backend_t* pBackend,
+                  moves_prop_t* pMoves,
+                  size_t nbChar);
+  /// Stop the backend after the last step (NULL: nothing to stop).
+  void (*stop)(moves_backend_t* pBackend, size_t nbChar);
+} backend_ops_t;
+
+/**
+ * @brief Ask the AIs one after the other (sequential backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in,out] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_sequential_propose(moves_backend_t* pBackend,
+                                 moves_prop_t* pMoves,
+                                 size_t nbChar);
+
+/**
+ * @brief Map the replies shared with the forked processes (fork backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_fork_start(moves_backend_t* pBackend,
+                         moves_prop_t* pMoves,
+                         size_t nbChar);
+
+/**
+ * @brief Fork a process per character to ask its AI (fork backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in,out] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ * @note A process that crashes proposes Stay.
+ */
+void _backend_fork_propose(moves_backend_t* pBackend,
+                           moves_prop_t* pMoves,
+                           size_t nbChar);
+
+/**
+ * @brief Unmap the shared replies (fork backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_fork_stop(moves_backend_t* pBackend, size_t nbChar);
+
+/**
+ * @brief Fork the AI workers once for the whole game (workers backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] pMoves Vector of propositions (one worker per character).
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_workers_start(moves_backend_t* pBackend,
+                            moves_prop_t* pMoves,
+                            size_t nbChar);
+
+/**
+ * @brief Get all moves propositions from the AI workers (workers backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in,out] pMoves Vector of propositions (holds the moves played at the
+ * previous step).
+ * @param[in] nbChar Number of character considered.
+ * @note Only alive characters have a worker, others are asked directly.
+ */
+void _backend_workers_propose(moves_backend_t* pBackend,
+                              moves_prop_t* pMoves,
+                              size_t nbChar);
+
+/**
+ * @brief Stop the AI workers (workers backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_workers_stop(moves_backend_t* pBackend, size_t nbChar);
+
+/**
+ * @brief Start the threads (threads backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_threads_start(moves_backend_t* pBackend,
+                            moves_prop_t* pMoves,
+                            size_t nbChar);
+
+/**
+ * @brief Ask the AIs through the pool of threads (threads backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in,out] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_threads_propose(moves_backend_t* pBackend,
+                              moves_prop_t* pMoves,
+                              size_t nbChar);
+
+/**
+ * @brief Stop the threads (threads backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_threads_stop(moves_backend_t* pBackend, size_t nbChar);
+
+/**
+ * @brief Create a coroutine per character (coroutines backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] pMoves Vector of propositions (one coroutine per character).
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_coroutines_start(moves_backend_t* pBackend,
+                               moves_prop_t* pMoves,
+                               size_t nbChar);
+
+/**
+ * @brief Resume the coroutine of each AI until it yields its move
+ * (coroutines backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in,out] pMoves Vector of propositions.
+ * @param[in] nbChar Number of character considered.
+ * @note Only alive characters are resumed, others are asked directly.
+ */
+void _backend_coroutines_propose(moves_backend_t* pBackend,
+                                 moves_prop_t* pMoves,
+                                 size_t nbChar);
+
+/**
+ * @brief Free the coroutines (coroutines backend).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] nbChar Number of character considered.
+ */
+void _backend_coroutines_stop(moves_backend_t* pBackend, size_t nbChar);
+
+/**
+ * @brief The backends, in the order of backend_t.
+ *
+ */
+static const backend_ops_t BACKEND_OPS_A[BACKEND_NB] = {
+    {NULL, &_backend_sequential_propose, NULL},
+    {&_backend_fork_start, &_backend_fork_propose, &_backend_fork_stop},
+    {&_backend_workers_start, &_backend_workers_propose,
+     &_backend_workers_stop},
+    {&_backend_threads_start, &_backend_threads_propose,
+     &_backend_threads_stop},
+    {&_backend_coroutines_start, &_backend_coroutines_propose,
+     &_backend_coroutines_stop}};
+
+/**********************************/
+//  Public functions implementation
+
+void backend_init(moves_backend_t* pBackend,
+                  backend_t backend,
+                  size_t nbThreads,
+                  const budget_t* pBudget,
+                  overrun_t overrun) {
+  pBackend->backend = backend;
+  pBackend->nbThreads = nbThreads;
+  pBackend->budget = *pBudget;
+  pBackend->overrun = overrun;
+  pBackend->pMap = NULL;
+  pBackend->pProfiler = NULL;
+  pBackend->replyA = NULL;
+  pBackend->coroA = NULL;
+}
+
+void backend_start(moves_backend_t* pBackend,
+                   const map_t* pMap,
+                   profiler_t* pProfiler,
+                   moves_prop_t* pMoves,
+                   size_t nbChar) {
+  pBackend->pMap = pMap;
+  pBackend->pProfiler = pProfiler;
+  const backend_ops_t* pOps = &(BACKEND_OPS_A[pBackend->backend]);
+  if (pOps->start != NULL) {
+    pOps->start(pBackend, pMoves, nbChar);
+  }
+}
+
+void backend_propose(moves_backend_t* pBackend,
+                     moves_prop_t* pMoves,
+                     size_t nbChar) {
+  BACKEND_OPS_A[pBackend->backend].propose(pBackend, pMoves, nbChar);
+
+  // Same penalty whatever the backend
+  for (size_t i = 0; i < nbChar; ++i) {
+    if (pMoves[i].overrun) {
+      pMoves[i].c->nbOverrun += 1;
+      pMoves[i].move = Stay;
+      pMoves[i].cheated = (pBackend->overrun == OVERRUN_CHEAT);
+    }
+  }
+}
+
+void backend_stop(moves_backend_t* pBackend, size_t nbChar) {
+  const backend_ops_t* pOps = &(BACKEND_OPS_A[pBackend->backend]);
+  if (pOps->stop != NULL) {
+    pOps->stop(pBackend, nbChar);
+  }
+  pBackend->pMap = NULL;
+  pBackend->pProfiler = NULL;
+}
+
+/**********************************/
+//  Local functions implementation
+
+void _backend_propose_move_task(void* arg, size_t i) {
+  moves_job_t* pJob = (moves_job_t*)arg;
+  const moves_backend_t* pBackend = pJob->pBackend;
+  moves_prop_t* pMove = &(pJob->pMoves[i]);
+  // Each task counts in the histogram of its own character
+  uint64_t start = profiler_now(pBackend->pProfiler);
+  pMove->move =
+      budget_propose_move(&(pBackend->budget), pMove->c, pBackend->pMap,
+                          &(pMove->cheated), &(pMove->overrun));
+  profiler_policy(pBackend->pProfiler, i, start);
+}
+
+void _backend_sequential_propose(moves_backend_t* pBackend,
+                                 moves_prop_t* pMoves,
+                                 size_t nbChar) {
+  for (size_t i = 0; i < nbChar; ++i) {
+    uint64_t start = profiler_now(pBackend->pProfiler);
+    pMoves[i].move =
+        budget_propose_move(&(pBackend->budget), pMoves[i].c, pBackend->pMap,
+                            &(pMoves[i].cheated), &(pMoves[i].overrun));
+    profiler_policy(pBackend->pProfiler, i, start);
+  }
+}
+
+void _backend_fork_start(moves_backend_t* pBackend,
+                         moves_prop_t* pMoves,
+                         size_t nbChar) {
+  (void)pMoves;  // unused
+  // Anonymous shared memory survives the exit of the children
+  void* shared = mmap(NULL, (nbChar + 1) * sizeof(fork_reply_t),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1,
+                      0);
+  if (shared == MAP_FAILED) {
+    display_fatal_error(stderr, "Error: can not share the replies!\n");
+    exit(EXIT_FAILURE);
+  }
+  pBackend->replyA = (fork_reply_t*)shared;
+}
+
+void _backend_fork_propose(moves_backend_t* pBackend,
+                           moves_prop_t* pMoves,
+                           size_t nbChar) {
+  // The children hold the write end of a pipe: it hangs up once all exited
+  int exited[2];
+  if (pipe(exited) != 0) {
+    display_fatal_error(stderr, "Error: can not create a pipe!\n");
+    exit(EXIT_FAILURE);
+  }
+  pid_t pid[nbChar + 1];
+  for (size_t i = 0; i < nbChar; ++i) {
+    fork_reply_t* pReply = &(pBackend->replyA[i]);
+    pReply->done = false;
+    pid[i] = fork();
+    if (pid[i] == -1) {
+      display_fatal_error(stderr, "Error: fork failed!\n");
+      exit(EXIT_FAILURE);
+    }
+    if (pid[i] == 0) {
+      close(exited[0]);
+      character_t* pC = pMoves[i].c;
+      uint64_t start = profiler_now(pBackend->pProfiler);
+      pReply->move =
+          budget_propose_move(&(pBackend->budget), pC, pBackend->pMap,
+                              &(pReply->cheated), &(pReply->overrun));
+      pReply->ns = profiler_now(pBackend->pProfiler) - start;
+      pReply->rng = pC->rng;
+      pReply->done = true;
+      _exit(EXIT_SUCCESS);  // Nothing of the game is flushed twice
+    }
+  }
+  close(exited[1]);
+
+  // Hard deadline: the children still running are killed
+  struct timespec deadline;
+  budget_deadline(&(pBackend->budget), &deadline);
+  struct pollfd fd;
+  fd.fd = exited[0];
+  fd.events = POLLIN;
+  bool waiting = true;
+  while (waiting) {
+    int left = budget_time_left(&deadline);
+    int res = (left > 0) ? poll(&fd, 1, left) : 0;
+    waiting = (res < 0) && (errno == EINTR);
+  }
+  close(exited[0]);
+
+  for (size_t i = 0; i < nbChar; ++i) {
+    bool killed = (waitpid(pid[i], NULL, WNOHANG) == 0);
+    if (killed) {
+      kill(pid[i], SIGKILL);
+      while ((waitpid(pid[i], NULL, 0) == -1) && (errno == EINTR)) {
+        // Interrupted, wait again
+      }
+    }
+    const fork_reply_t* pReply = &(pBackend->replyA[i]);
+    if (pReply->done) {
+      pMoves[i].move = pReply->move;
+      pMoves[i].cheated = pReply->cheated;
+      pMoves[i].overrun = pReply->overrun;
+      pMoves[i].c->rng = pReply->rng;
+      profiler_policy_ns(pBackend->pProfiler, i, pReply->ns);
+    } else {
+      // Killed at the deadline, or crashed (not timed)
+      pMoves[i].move = Stay;
+      pMoves[i].cheated = false;
+      pMoves[i].overrun = killed;
+    }
+  }
+}
+
+void _backend_fork_stop(moves_backend_t* pBackend, size_t nbChar) {
+  munmap(pBackend->replyA, (nbChar + 1) * sizeof(fork_reply_t));
+  pBackend->replyA = NULL;
+}
+
+void _backend_workers_start(moves_backend_t* pBackend,
+                            moves_prop_t* pMoves,
+                            size_t nbChar) {
+  character_t* charA[nbChar + 1];
+  for (size_t i = 0; i < nbChar; ++i) {
+    charA[i] = pMoves[i].c;
+  }
+  sandbox_init(&(pBackend->sandbox), pBackend->pMap, charA, nbChar,
+               &(pBackend->budget));
+}
+
+void _backend_workers_propose(moves_backend_t* pBackend,
+                              moves_prop_t* pMoves,
+                              size_t nbChar) {
+  sandbox_snapshot(&(pBackend->sandbox));
+  for (size_t i = 0; i < nbChar; ++i) {
+    const character_t* pC = pMoves[i].c;
+    if ((pC->type == PLAYER) || (pC->type == MINOTAUR)) {
+      sandbox_request(&(pBackend->sandbox), i, pC, pMoves[i].move);
+    }
+  }
+  sandbox_wait(&(pBackend->sandbox));
+
+  for (size_t i = 0; i < nbChar; ++i) {
+    character_t* pC = pMoves[i].c;
+    if ((pC->type == PLAYER) || (pC->type == MINOTAUR)) {
+      // Never trust a worker
+      uint64_t ns = 0;
+      pMoves[i].move = sandbox_reply(&(pBackend->sandbox), i, &(pC->rng),
+                                     &(pMoves[i].overrun), &ns);
+      if (ns > 0) {
+        profiler_policy_ns(pBackend->pProfiler, i, ns);
+      }
+      pMoves[i].cheated =
+          !character_is_valid_move(pC, pBackend->pMap, pMoves[i].move);
+    } else {
+      pMoves[i].move =
+          character_propose_move(pC, pBackend->pMap, &(pMoves[i].cheated));
+      pMoves[i].overrun = false;
+    }
+  }
+}
+
+void _backend_workers_stop(moves_backend_t* pBackend, size_t nbChar) {
+  (void)nbChar;  // unused
+  sandbox_delete(&(pBackend->sandbox));
+}
+
+void _backend_threads_start(moves_backend_t* pBackend,
+                            moves_prop_t* pMoves,
+                            size_t nbChar) {
+  (void)pMoves;  // unused
+  size_t nbThreads = pBackend->nbThreads;
+  if (nbThreads == 0) {
+    // One per online CPU: more threads than CPUs only take turns
+    long nbCpu = sysconf(_SC_NPROCESSORS_ONLN);
+    nbThreads = (nbCpu > 0) ? (size_t)nbCpu : 1;
+  }
+  if (nbThreads > nbChar) {
+    nbThreads = nbChar;  // Idle threads would only wake up for nothing
+  }
+  pool_init(&(pBackend->pool), nbThreads);
+}
+
+void _backend_threads_propose(moves_backend_t* pBackend,
+                              moves_prop_t* pMoves,
+                              size_t nbChar) {
+  // Nothing changes the map nor the characters until all AIs answered, so the
+  // workers share them read only. Each task writes its own proposition.
+  moves_job_t job;
+  job.pBackend = pBackend;
+  job.pMoves = pMoves;
+  pool_run(&(pBackend->pool), &_backend_propose_move_task, &job, nbChar);
+}
+
+void _backend_threads_stop(moves_backend_t* pBackend, size_t nbChar) {
+  (void)nbChar;  // unused
+  pool_delete(&(pBackend->pool));
+}
+
+void _backend_coroutines_start(moves_backend_t* pBackend,
+                               moves_prop_t* pMoves,
+                               size_t nbChar) {
+  pBackend->coroA = (coro_t*)malloc((nbChar + 1) * sizeof(coro_t));
+  if (pBackend->coroA == NULL) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < nbChar; ++i) {
+    if (!coro_init(&(pBackend->coroA[i]), pMoves[i].c->ai, 0)) {
+      display_fatal_error(stderr, "Error: can not map a coroutine stack!\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+void _backend_coroutines_propose(moves_backend_t* pBackend,
+                                 moves_prop_t* pMoves,
+                                 size_t nbChar) {
+  for (size_t i = 0; i < nbChar; ++i) {
+    character_t* pC = pMoves[i].c;
+    if ((pC->type == PLAYER) || (pC->type == MINOTAUR)) {
+      uint64_t start = profiler_now(pBackend->pProfiler);
+      pMoves[i].move = coro_propose_move(
+          &(pBackend->coroA[i]), pC, pBackend->pMap, &(pBackend->budget),
+          &(pMoves[i].cheated), &(pMoves[i].overrun));
+      profiler_policy(pBackend->pProfiler, i, start);
+    } else {
+      pMoves[i].move =
+          character_propose_move(pC, pBackend->pMap, &(pMoves[i].cheated));
+      pMoves[i].overrun = false;
+    }
+  }
+}
+
+void _backend_coroutines_stop(moves_backend_t* pBackend, size_t nbChar) {
+  for (size_t i = 0; i < nbChar; ++i) {
+    coro_delete(&(pBackend->coroA[i]));
+  }
+  free(pBackend->coroA);
+  pBackend->coroA = NULL;
+}
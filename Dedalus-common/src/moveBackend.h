@@ -0,0 +1,137 @@
+/**
+ * @file moveBackend.h
+ * @brief Backends asking the AIs for their moves (see backend_t).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Whatever the backend, each AI gets the same map and character, and its
+ * random generator is updated as if it ran in the game process: a game plays
+ * the same with every backend. The time of the AIs is bounded by a budget
+ * (see moveBudget.h) and an AI out of time plays the penalty (see overrun_t).
+ *
+ * The backends are shared by the versions of the game, each one builds them
+ * against its own headers, which must provide:
+ * - character.h: a character_t with the fields type, pos, targetCompass,
+ *   targetDistance, ariadne, ai, rng and nbOverrun, and the functions
+ *   character_propose_move(), character_can_go(),
+ *   character_is_valid_move() and character_record_move();
+ * - ai.h: an ai_t with a policy drawing from a rng_t and a coroutine body
+ *   (NULL for a plain policy, see aiCoroutine.h);
+ * - map.h: a map_t with the fields m, x and y, and map_view_init() and
+ *   map_view_delete() over rows of x + 1 chars;
+ * - display.h: display_fatal_error().
+ */
+#ifndef MOVE_BACKEND_H
+#define MOVE_BACKEND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "aiCoroutine.h"
+#include "aiSandbox.h"
+#include "character.h"
+#include "map.h"
+#include "moveBudget.h"
+#include "moveOptions.h"
+#include "profiler.h"
+#include "rng.h"
+#include "workerPool.h"
+
+/**
+ * @brief Structure to store moves propositions.
+ *
+ */
+typedef struct moves_prop {
+  character_t* c;  ///< Pointer to the character concerned.
+  compass_t move;  ///< The move proposition
+  bool cheated;    ///< Is this a cheat move.
+  bool overrun;    ///< The AI was out of time.
+} moves_prop_t;
+
+/**
+ * @brief Move written back by a process forked for one character.
+ *
+ */
+typedef struct fork_reply {
+  compass_t move;  ///< The move proposed by the AI.
+  bool cheated;    ///< Is this a cheat move.
+  bool overrun;    ///< The AI answered after its budget.
+  bool done;       ///< Set by the process (false if it crashed).
+  uint64_t ns;     ///< Time taken by the AI (in ns).
+  rng_t rng;       ///< Random generator of the character after the move.
+} fork_reply_t;
+
+/**
+ * @brief A backend and its state for a game.
+ *
+ */
+typedef struct moves_backend {
+  backend_t backend;      ///< How the AIs are asked for their moves.
+  size_t nbThreads;       ///< Threads asking AIs for moves (0: one per CPU).
+  budget_t budget;        ///< Time given to an AI for a move.
+  overrun_t overrun;      ///< Penalty of an AI out of time.
+  const map_t* pMap;      ///< The map of the game (set by backend_start()).
+  profiler_t* pProfiler;  ///< Timings of the AIs (NULL if not profiled).
+  pool_t pool;            ///< The threads (threads backend).
+  sandbox_t sandbox;      ///< The AI workers (workers backend).
+  fork_reply_t* replyA;   ///< Shared replies (fork backend).
+  coro_t* coroA;          ///< Coroutines of the AIs (coroutines backend).
+} moves_backend_t;
+
+/**
+ * @brief Initialize a backend (nothing is started yet).
+ *
+ * @param[out] pBackend The backend.
+ * @param[in] backend Which backend.
+ * @param[in] nbThreads Threads asking AIs for moves (0: one per CPU).
+ * @param[in] pBudget Time given to an AI for a move.
+ * @param[in] overrun Penalty of an AI out of time.
+ */
+void backend_init(moves_backend_t* pBackend,
+                  backend_t backend,
+                  size_t nbThreads,
+                  const budget_t* pBudget,
+                  overrun_t overrun);
+
+/**
+ * @brief Start the backend before the first step (threads, processes,
+ * stacks or shared memory are kept for the whole game).
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] pMap The map of the game (the AIs look at it at each step).
+ * @param[in,out] pProfiler Timings of the AIs (NULL if not profiled).
+ * @param[in] pMoves Vector of propositions (one per character).
+ * @param[in] nbChar Number of character considered.
+ */
+void backend_start(moves_backend_t* pBackend,
+                   const map_t* pMap,
+                   profiler_t* pProfiler,
+                   moves_prop_t* pMoves,
+                   size_t nbChar);
+
+/**
+ * @brief Get all moves propositions for each character.
+ *
+ * @param[in,out] pBackend The started backend.
+ * @param[in,out] pMoves Vector of propositions (holds the moves played at the
+ * previous step).
+ * @param[in] nbChar Number of character considered.
+ * @note An AI out of time plays the penalty, and its character counts an
+ * overrun.
+ */
+void backend_propose(moves_backend_t* pBackend,
+                     moves_prop_t* pMoves,
+                     size_t nbChar);
+
+/**
+ * @brief Stop the backend after the last step.
+ *
+ * @param[in,out] pBackend The backend.
+ * @param[in] nbChar Number of character considered.
+ */
+void backend_stop(moves_backend_t* pBackend, size_t nbChar);
+
+#endif  // End of MOVE_BACKEND_H
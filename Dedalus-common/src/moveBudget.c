@@ -0,0 +1,108 @@
+/**
+ * @file moveBudget.c
+ * @brief Time budget of the AIs for each move.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include "moveBudget.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Argument of the move of a character (see _budget_propose()).
+ *
+ */
+typedef struct budget_move {
+  character_t* pC;    ///< The character.
+  const map_t* pMap;  ///< The map.
+  compass_t move;     ///< The move proposed.
+  bool cheated;       ///< Is the move impossible?
+} budget_move_t;
+
+/**
+ * @brief Ask the AI of a character (run by budget_run()).
+ *
+ * @param[in,out] arg The budget_move_t.
+ */
+void _budget_propose(void* arg);
+
+/**
+ * @brief Time elapsed between two instants.
+ *
+ * @param[in] pStart The first instant.
+ * @param[in] pEnd The second instant.
+ * @return long The time (in ns).
+ */
+long _budget_elapsed(const struct timespec* pStart,
+                     const struct timespec* pEnd);
+
+/**********************************/
+//  Public functions implementation
+
+bool budget_run(const budget_t* pBudget, void (*fn)(void* arg), void* arg) {
+  // A coroutine keeps the thread: its CPU clock is still the right one
+  clockid_t id = (pBudget->clock == BUDGET_CPU) ? CLOCK_THREAD_CPUTIME_ID
+                                                : CLOCK_MONOTONIC;
+  struct timespec start;
+  struct timespec end;
+  clock_gettime(id, &start);
+  (*fn)(arg);
+  clock_gettime(id, &end);
+  return _budget_elapsed(&start, &end) <= (long)pBudget->ms * 1000000;
+}
+
+compass_t budget_propose_move(const budget_t* pBudget,
+                              character_t* pC,
+                              const map_t* pMap,
+                              bool* pCheated,
+                              bool* pOverrun) {
+  budget_move_t job;
+  job.pC = pC;
+  job.pMap = pMap;
+  job.move = Stay;
+  job.cheated = false;
+  *pOverrun = !budget_run(pBudget, &_budget_propose, &job);
+  if (*pOverrun) {
+    job.move = Stay;
+    job.cheated = false;
+  }
+  *pCheated = job.cheated;
+  return job.move;
+}
+
+void budget_deadline(const budget_t* pBudget, struct timespec* pDeadline) {
+  clock_gettime(CLOCK_MONOTONIC, pDeadline);
+  int timeout = pBudget->ms + BUDGET_SLACK_MS;
+  pDeadline->tv_sec += timeout / 1000;
+  pDeadline->tv_nsec += (long)(timeout % 1000) * 1000000;
+  if (pDeadline->tv_nsec >= 1000000000) {
+    pDeadline->tv_sec += 1;
+    pDeadline->tv_nsec -= 1000000000;
+  }
+}
+
+int budget_time_left(const struct timespec* pDeadline) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  long ms = _budget_elapsed(&now, pDeadline) / 1000000;
+  return (ms > 0) ? (int)ms : 0;
+}
+
+/**********************************/
+//  Local functions implementation
+
+void _budget_propose(void* arg) {
+  budget_move_t* pJob = (budget_move_t*)arg;
+  pJob->move = character_propose_move(pJob->pC, pJob->pMap, &(pJob->cheated));
+}
+
+long _budget_elapsed(const struct timespec* pStart,
+                     const struct timespec* pEnd) {
+  return (pEnd->tv_sec - pStart->tv_sec) * 1000000000L +
+         (pEnd->tv_nsec - pStart->tv_nsec);
+}
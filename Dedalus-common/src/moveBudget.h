@@ -0,0 +1,93 @@
+/**
+ * @file moveBudget.h
+ * @brief Time budget of the AIs for each move.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * The time of an AI is measured on the wall clock or on the CPU clock of the
+ * calling thread. An AI that answers after its budget overruns it, and the
+ * game replaces its move by the penalty (see overrun_t).
+ *
+ * Where the AI runs in the game process (sequential, threads and coroutines
+ * backends) the budget is soft: nothing can safely leave an AI in the middle
+ * of its code, so the call always finishes and is only counted as an overrun.
+ * These backends can not bound a hung AI: it hangs the game.
+ *
+ * Where the AI runs in its own process (fork and workers backends) the budget
+ * is also hard: a process still silent BUDGET_SLACK_MS after the budget is
+ * killed, its move is the penalty (see budget_deadline()).
+ */
+#ifndef MOVE_BUDGET_H
+#define MOVE_BUDGET_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "character.h"
+#include "moveOptions.h"
+#include "map.h"
+
+/**
+ * @brief Extra time (in ms) given to an AI process to reply after its budget,
+ * before it is killed.
+ *
+ */
+#define BUDGET_SLACK_MS 50
+
+/**
+ * @brief Time budget of a move.
+ *
+ */
+typedef struct budget {
+  int ms;                ///< Time (in ms) given for a move (at least 1).
+  budget_clock_t clock;  ///< Clock of the time.
+} budget_t;
+
+/**
+ * @brief Run a function and tell whether it returned within a budget.
+ *
+ * @param[in] pBudget The budget.
+ * @param[in] fn The function (always run to its end).
+ * @param[in,out] arg Argument of fn.
+ * @return true fn returned within the budget.
+ * @return false fn overran the budget.
+ */
+bool budget_run(const budget_t* pBudget, void (*fn)(void* arg), void* arg);
+
+/**
+ * @brief Ask a character the move she wants to play, within a budget.
+ *
+ * @param[in] pBudget The budget.
+ * @param[in,out] pC The considered character (its AI may draw numbers).
+ * @param[in] pMap The map.
+ * @param[out] pCheated Is the move impossible?
+ * @param[out] pOverrun Did the AI answer after its budget?
+ * @return compass_t The move (Stay if the AI overran).
+ */
+compass_t budget_propose_move(const budget_t* pBudget,
+                              character_t* pC,
+                              const map_t* pMap,
+                              bool* pCheated,
+                              bool* pOverrun);
+
+/**
+ * @brief Deadline of a process running an AI, from now.
+ *
+ * @param[in] pBudget The budget.
+ * @param[out] pDeadline Now plus the budget and BUDGET_SLACK_MS (monotonic
+ * clock, whatever the clock of the budget).
+ */
+void budget_deadline(const budget_t* pBudget, struct timespec* pDeadline);
+
+/**
+ * @brief Milliseconds left before a deadline.
+ *
+ * @param[in] pDeadline The deadline (monotonic clock).
+ * @return int The time left (0 if the deadline is passed).
+ */
+int budget_time_left(const struct timespec* pDeadline);
+
+#endif  // End of MOVE_BUDGET_H
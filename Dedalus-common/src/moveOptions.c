@@ -0,0 +1,54 @@
+/**
+ * @file moveOptions.c
+ * @brief Options of the moves of the AIs: backend, clock and penalty.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>  // strcmp
+
+#include "moveOptions.h"
+
+/**
+ * @brief Names of the backends.
+ *
+ */
+static const char* const BACKEND_NAME[BACKEND_NB] = {
+    "sequential", "fork", "workers", "threads", "coroutines"};
+
+/**
+ * @brief Names of the penalties for overruns.
+ *
+ */
+static const char* const OVERRUN_NAME[OVERRUN_NB] = {"stay", "cheat"};
+
+/**********************************/
+//  Public functions implementation
+
+const char* options_backend_name(backend_t backend) {
+  return BACKEND_NAME[backend];
+}
+
+bool options_backend_parse(const char* name, backend_t* pBackend) {
+  for (size_t b = 0; b < BACKEND_NB; ++b) {
+    if (strcmp(name, BACKEND_NAME[b]) == 0) {
+      *pBackend = (backend_t)b;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool options_overrun_parse(const char* name, overrun_t* pOverrun) {
+  for (size_t o = 0; o < OVERRUN_NB; ++o) {
+    if (strcmp(name, OVERRUN_NAME[o]) == 0) {
+      *pOverrun = (overrun_t)o;
+      return true;
+    }
+  }
+  return false;
+}
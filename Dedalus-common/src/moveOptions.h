@@ -0,0 +1,79 @@
+/**
+ * @file moveOptions.h
+ * @brief Options of the moves of the AIs: backend, clock and penalty.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Plain enumerations, read by the configuration of each version of the game
+ * (see moveBackend.h and moveBudget.h for what they change).
+ */
+#ifndef MOVE_OPTIONS_H
+#define MOVE_OPTIONS_H
+
+#include <stdbool.h>
+
+/**
+ * @brief How the AIs are asked for their moves at each step.
+ *
+ */
+typedef enum backend {
+  BACKEND_SEQUENTIAL = 0,  ///< One after the other, in the game process.
+  BACKEND_FORK = 1,        ///< One process forked per character and step.
+  BACKEND_WORKERS = 2,     ///< Long-lived sandboxed worker processes.
+  BACKEND_THREADS = 3,     ///< A persistent pool of threads.
+  BACKEND_COROUTINES = 4,  ///< A coroutine per AI, in the game process.
+  BACKEND_NB = 5           ///< Number of backends.
+} backend_t;
+
+/**
+ * @brief Clock measuring the time an AI takes for a move.
+ *
+ */
+typedef enum budget_clock {
+  BUDGET_WALL = 0,  ///< Elapsed time (bounds the steps latency).
+  BUDGET_CPU = 1,   ///< CPU time of the AI (fair on a loaded machine).
+  BUDGET_NB = 2     ///< Number of clocks.
+} budget_clock_t;
+
+/**
+ * @brief What an AI that overruns its budget plays.
+ *
+ */
+typedef enum overrun {
+  OVERRUN_STAY = 0,   ///< It stays where it is.
+  OVERRUN_CHEAT = 1,  ///< It is punished as a cheater.
+  OVERRUN_NB = 2      ///< Number of penalties.
+} overrun_t;
+
+/**
+ * @brief Name of a backend.
+ *
+ * @param[in] backend The backend.
+ * @return const char* Its name (as read by options_backend_parse()).
+ */
+const char* options_backend_name(backend_t backend);
+
+/**
+ * @brief Read the name of a backend.
+ *
+ * @param[in] name The name ("sequential", "fork", "workers", "threads" or
+ * "coroutines").
+ * @param[out] pBackend The backend, if the name is known.
+ * @return true The name is known.
+ * @return false Unknown name (pBackend is unchanged).
+ */
+bool options_backend_parse(const char* name, backend_t* pBackend);
+
+/**
+ * @brief Read the name of a penalty for overruns.
+ *
+ * @param[in] name The name ("stay" or "cheat").
+ * @param[out] pOverrun The penalty, if the name is known.
+ * @return true The name is known.
+ * @return false Unknown name (pOverrun is unchanged).
+ */
+bool options_overrun_parse(const char* name, overrun_t* pOverrun);
+
+#endif  // End of MOVE_OPTIONS_H
@@ -0,0 +1,132 @@
+/**
+ * @file moveSolver.c
+ * @brief Solver of the conflicts between the moves of a step.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdint.h>  // SIZE_MAX
+#include <stdio.h>
+
+#include "display.h"  // display_fatal_error
+#include "gps.h"      // gps_compute_move
+#include "moveSolver.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Find (or add) a cell in the occupancy table.
+ *
+ * @param[in,out] pSolver The solver.
+ * @param[in] key Index of the cell in the map.
+ * @return moves_cell_t* The entry of the cell.
+ */
+moves_cell_t* _solver_cell(moves_solver_t* pSolver, size_t key);
+
+/**********************************/
+//  Local functions implementation
+
+moves_cell_t* _solver_cell(moves_solver_t* pSolver, size_t key) {
+  size_t mask = pSolver->capacity - 1;
+  size_t h = (key * 0x9E3779B97F4A7C15ull) & mask;
+  while ((pSolver->cells[h].key != key) &&
+         (pSolver->cells[h].key != SIZE_MAX)) {
+    h = (h + 1) & mask;
+  }
+  if (pSolver->cells[h].key == SIZE_MAX) {
+    pSolver->cells[h].key = key;
+    pSolver->cells[h].owner = SIZE_MAX;
+    pSolver->cells[h].staying = false;
+  }
+  return &(pSolver->cells[h]);
+}
+
+/**********************************/
+//  Public functions implementation
+
+void solver_init(moves_solver_t* pSolver, size_t nbChar) {
+  // Each character uses at most two cells (its position and its target),
+  // keep the load factor under 1/2.
+  pSolver->capacity = 1;
+  while (pSolver->capacity < 4 * nbChar) {
+    pSolver->capacity *= 2;
+  }
+  pSolver->cells =
+      (moves_cell_t*)malloc(pSolver->capacity * sizeof(moves_cell_t));
+  pSolver->todo = (size_t*)malloc((2 * nbChar + 1) * sizeof(size_t));
+  if ((pSolver->cells == NULL) || (pSolver->todo == NULL)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+}
+
+void solver_delete(moves_solver_t* pSolver) {
+  free(pSolver->cells);
+  pSolver->cells = NULL;
+  free(pSolver->todo);
+  pSolver->todo = NULL;
+  pSolver->capacity = 0;
+}
+
+void solver_solve(moves_solver_t* pSolver,
+                  const map_t* pMap,
+                  moves_prop_t* moves,
+                  size_t nbChar) {
+  for (size_t h = 0; h < pSolver->capacity; ++h) {
+    pSolver->cells[h].key = SIZE_MAX;
+  }
+
+  // Fix position of staying char
+  for (size_t i = 0; i < nbChar; ++i) {
+    character_t* pC = moves[i].c;
+    // Only alive characters are interested
+    if ((moves[i].move == Stay) &&
+        ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
+      _solver_cell(pSolver, pC->pos.y * pMap->x + pC->pos.x)->staying = true;
+    }
+  }
+
+  // Reserve targets in order: only the first character targeting a cell may
+  // go there, and nobody may go where a character stays.
+  size_t nbTodo = 0;
+  for (size_t i = 0; i < nbChar; ++i) {
+    character_t* pC = moves[i].c;
+    if ((moves[i].move != Stay) &&
+        ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
+      pos_t nextPos = gps_compute_move(pC->pos, moves[i].move);
+      if ((nextPos.x >= pMap->x) || (nextPos.y >= pMap->y)) {
+        continue;  // Out of the map (cheater): nobody else can go there.
+      }
+      moves_cell_t* pCell =
+          _solver_cell(pSolver, nextPos.y * pMap->x + nextPos.x);
+      if (pCell->owner == SIZE_MAX) {
+        pCell->owner = i;
+      }
+      if (pCell->staying || (pCell->owner != i)) {
+        pSolver->todo[nbTodo++] = i;
+      }
+    }
+  }
+
+  // Refused moves free nothing but block their own cell.
+  while (nbTodo > 0) {
+    size_t i = pSolver->todo[--nbTodo];
+    if (moves[i].move == Stay) {
+      continue;  // Already refused.
+    }
+    moves[i].move = Stay;
+
+    character_t* pC = moves[i].c;
+    moves_cell_t* pCell =
+        _solver_cell(pSolver, pC->pos.y * pMap->x + pC->pos.x);
+    pCell->staying = true;
+    if (pCell->owner != SIZE_MAX) {
+      // The others were already refused.
+      pSolver->todo[nbTodo++] = pCell->owner;
+    }
+  }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file moveSolver.h
+ * @brief Solver of the conflicts between the moves of a step.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * A conflict occurs when two characters want to go at the same position: only
+ * one character moves (players firsts and in order of declaration after).
+ * Besides the headers listed in moveBackend.h, the version of the game must
+ * provide gps_compute_move() in gps.h.
+ */
+#ifndef MOVE_SOLVER_H
+#define MOVE_SOLVER_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "map.h"
+#include "moveBackend.h"
+
+/**
+ * @brief A cell in the occupancy table of the conflict solver.
+ *
+ */
+typedef struct moves_cell {
+  size_t key;    ///< Cell index in the map (SIZE_MAX if the slot is free).
+  size_t owner;  ///< First moving character that targets the cell.
+  bool staying;  ///< Is a character staying on the cell?
+} moves_cell_t;
+
+/**
+ * @brief Working memory of the conflict solver, allocated once per game.
+ *
+ */
+typedef struct moves_solver {
+  moves_cell_t* cells;  ///< Open addressing table of the used cells.
+  size_t capacity;      ///< Size of the table (a power of two).
+  size_t* todo;         ///< Characters that may have to stay.
+} moves_solver_t;
+
+/**
+ * @brief Allocate the working memory of the conflict solver.
+ *
+ * @param[out] pSolver The solver to initialize.
+ * @param[in] nbChar Number of characters in the game.
+ */
+void solver_init(moves_solver_t* pSolver, size_t nbChar);
+
+/**
+ * @brief Clear the working memory of the conflict solver.
+ *
+ * @param[in,out] pSolver The solver to clear.
+ */
+void solver_delete(moves_solver_t* pSolver);
+
+/**
+ * @brief Solve conflicts between an array of move propositions.
+ *
+ * @param[in,out] pSolver Working memory of the solver.
+ * @param[in] pMap The map of the game.
+ * @param[in,out] moves The array of moves propositions to clear.
+ * @param[in] nbChar Number of character considered.
+ *
+ * A character that has to stay may block the characters moving to its cell,
+ * and so on. Conflicts only grow, so all of them are settled with a worklist
+ * in O(nbChar) without any allocation.
+ */
+void solver_solve(moves_solver_t* pSolver,
+                  const map_t* pMap,
+                  moves_prop_t* moves,
+                  size_t nbChar);
+
+#endif  // End of MOVE_SOLVER_H
@@ -0,0 +1,118 @@
+/**
+ * @file pacer.c
+ * @brief Pace of the steps of a game on the monotonic clock.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <errno.h>  // EINTR
+
+#include "pacer.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Current time.
+ *
+ * @return uint64_t Time on the monotonic clock (in ns).
+ */
+uint64_t _pacer_now();
+
+/**
+ * @brief Sleep until a time of the monotonic clock.
+ *
+ * @param[in] ns The time (in ns).
+ */
+void _pacer_sleep_until(uint64_t ns);
+
+/**********************************/
+//  Public functions implementation
+
+void pacer_start(pacer_t* pPacer, int periodUs) {
+  pPacer->period = (periodUs > 0) ? (uint64_t)periodUs * 1000u : 0;
+  pPacer->last = _pacer_now();
+  pPacer->deadline = pPacer->last + pPacer->period;
+  pPacer->elapsed = 0;
+  pPacer->nbTick = 0;
+  pPacer->nbMissed = 0;
+  pPacer->nbSkipped = 0;
+  pPacer->skipRow = 0;
+}
+
+bool pacer_wait(pacer_t* pPacer) {
+  ++(pPacer->nbTick);
+  if (pPacer->period == 0) {
+    return true;
+  }
+
+  uint64_t now = _pacer_now();
+  bool onTime = (now <= pPacer->deadline);
+  uint64_t tick = pPacer->deadline;
+  if (onTime) {
+    _pacer_sleep_until(tick);
+  } else {
+    ++(pPacer->nbMissed);
+    if (now - pPacer->deadline > pPacer->period) {
+      // Too late to catch up: start again from now
+      tick = now;
+    }
+  }
+  pPacer->elapsed += tick - pPacer->last;
+  pPacer->last = tick;
+  pPacer->deadline = tick + pPacer->period;
+  return onTime;
+}
+
+void pacer_resume(pacer_t* pPacer) {
+  pPacer->last = _pacer_now();
+  pPacer->deadline = pPacer->last + pPacer->period;
+}
+
+bool pacer_frame(pacer_t* pPacer) {
+  if ((pPacer->period == 0) || (_pacer_now() <= pPacer->deadline) ||
+      (pPacer->skipRow >= PACER_MAX_SKIP)) {
+    pPacer->skipRow = 0;
+    return true;
+  }
+  ++(pPacer->skipRow);
+  ++(pPacer->nbSkipped);
+  return false;
+}
+
+void pacer_report(const pacer_t* pPacer, FILE* stream) {
+  if ((pPacer->period == 0) || (pPacer->elapsed == 0)) {
+    return;
+  }
+  double seconds = (double)pPacer->elapsed / 1e9;
+  fprintf(stream,
+          "Pace: %llu ticks in %.3f s, %.2f ticks/s (target %.2f), %llu "
+          "missed deadlines, %llu frames skipped.\n",
+          (unsigned long long)pPacer->nbTick, seconds,
+          (double)pPacer->nbTick / seconds, 1e9 / (double)pPacer->period,
+          (unsigned long long)pPacer->nbMissed,
+          (unsigned long long)pPacer->nbSkipped);
+}
+
+/**********************************/
+//  Local functions implementation
+
+uint64_t _pacer_now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void _pacer_sleep_until(uint64_t ns) {
+  struct timespec ts;
+  ts.tv_sec = (time_t)(ns / 1000000000ull);
+  ts.tv_nsec = (long)(ns % 1000000000ull);
+  // An absolute deadline: a signal does not make the sleep longer
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) ==
+         EINTR) {
+    // Interrupted, sleep again
+  }
+}
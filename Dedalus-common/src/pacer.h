@@ -0,0 +1,93 @@
+/**
+ * @file pacer.h
+ * @brief Pace of the steps of a game on the monotonic clock.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Each tick (a step or a round of a fight) has a deadline, one period after
+ * the previous one: the pacer sleeps until it (clock_nanosleep(2) with
+ * TIMER_ABSTIME), so the time taken by the tick itself does not add up to the
+ * period and the rate does not drift.
+ *
+ * A tick that starts after its deadline is missed. The pacer does not try to
+ * catch up a lag longer than a period (no burst of ticks): the next deadlines
+ * start again from now. While ticks run late, their frames are skipped (the
+ * game goes on), but never more than PACER_MAX_SKIP frames in a row.
+ */
+#ifndef PACER_H
+#define PACER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Most frames skipped in a row (the display still moves when late).
+ *
+ */
+#define PACER_MAX_SKIP 8
+
+/**
+ * @brief The pace of a game.
+ *
+ */
+typedef struct pacer {
+  uint64_t period;     ///< Time (in ns) between two ticks (0: no pace).
+  uint64_t deadline;   ///< Deadline of the next tick.
+  uint64_t last;       ///< Start of the last tick (or end of a pause).
+  uint64_t elapsed;    ///< Time (in ns) of the ticks, pauses excluded.
+  uint64_t nbTick;     ///< Number of ticks.
+  uint64_t nbMissed;   ///< Ticks started after their deadline.
+  uint64_t nbSkipped;  ///< Frames not displayed.
+  unsigned skipRow;    ///< Frames skipped since the last displayed one.
+} pacer_t;
+
+/**
+ * @brief Start a pace: the first tick is one period away.
+ *
+ * @param[out] pPacer The pacer.
+ * @param[in] periodUs Time (in us) between two ticks (0: no pace).
+ */
+void pacer_start(pacer_t* pPacer, int periodUs);
+
+/**
+ * @brief Wait for the deadline of the next tick.
+ *
+ * @param[in,out] pPacer The pacer.
+ * @return true The tick is on time.
+ * @return false The deadline was already missed (no wait).
+ */
+bool pacer_wait(pacer_t* pPacer);
+
+/**
+ * @brief Go on after a pause (user input, animation): the next tick is one
+ * period away and the pause is not a missed deadline.
+ *
+ * @param[in,out] pPacer The pacer.
+ */
+void pacer_resume(pacer_t* pPacer);
+
+/**
+ * @brief Should the frame of the current tick be displayed?
+ *
+ * @param[in,out] pPacer The pacer.
+ * @return true The tick is within its period (or too many frames were
+ * skipped).
+ * @return false The tick runs late: skip its frame.
+ */
+bool pacer_frame(pacer_t* pPacer);
+
+/**
+ * @brief Print the achieved rate, the missed deadlines and skipped frames.
+ *
+ * @param[in] pPacer The pacer.
+ * @param[in,out] stream Where to print.
+ * @note Nothing is printed without pace or tick.
+ */
+void pacer_report(const pacer_t* pPacer, FILE* stream);
+
+#endif  // End of PACER_H
@@ -0,0 +1,222 @@
+/**
+ * @file profiler.c
+ * @brief Time spent in each phase of the steps of a game.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <string.h>  // memset, strncpy
+
+#include "profiler.h"
+
+/**
+ * @brief Names of the phases (in the report and the trace).
+ *
+ */
+static const char* const PROFILER_PHASE_NAME[PROFILER_NB_PHASE] = {
+    "fight_before", "proposals", "solve",      "record",
+    "play",         "ui",        "fight_after"};
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Bucket of a duration.
+ *
+ * @param[in] ns The duration.
+ * @return size_t Index of its bucket.
+ */
+size_t _profiler_bucket(uint64_t ns);
+
+/**
+ * @brief Longest duration of a bucket.
+ *
+ * @param[in] b Index of the bucket.
+ * @return uint64_t The last duration counted in it.
+ */
+uint64_t _profiler_bucket_max(size_t b);
+
+/**
+ * @brief Print a line of the report.
+ *
+ * @param[in,out] stream Where to print.
+ * @param[in] name Name of the line.
+ * @param[in] pHisto The durations.
+ */
+void _profiler_report_line(FILE* stream,
+                           const char* name,
+                           const profiler_histo_t* pHisto);
+
+/**********************************/
+//  Public functions implementation
+
+profiler_t* profiler_new(size_t nbPolicy, const char* tracePath) {
+  profiler_t* pProf = (profiler_t*)calloc(1, sizeof(profiler_t));
+  if (pProf == NULL) {
+    return NULL;
+  }
+  pProf->nbPolicy = nbPolicy;
+  pProf->policyA =
+      (profiler_policy_t*)calloc(nbPolicy + 1, sizeof(profiler_policy_t));
+  if (pProf->policyA == NULL) {
+    profiler_delete(pProf);
+    return NULL;
+  }
+
+  pProf->trace = NULL;
+  if (tracePath != NULL) {
+    pProf->trace = fopen(tracePath, "w");
+    if (pProf->trace == NULL) {
+      profiler_delete(pProf);
+      return NULL;
+    }
+    fputs("step", pProf->trace);
+    for (size_t p = 0; p < PROFILER_NB_PHASE; ++p) {
+      fprintf(pProf->trace, ",%s_ns", PROFILER_PHASE_NAME[p]);
+    }
+    fputs(",step_ns\n", pProf->trace);
+  }
+  return pProf;
+}
+
+void profiler_delete(profiler_t* pProf) {
+  if (pProf == NULL) {
+    return;
+  }
+  if (pProf->trace != NULL) {
+    fclose(pProf->trace);
+  }
+  free(pProf->policyA);
+  free(pProf);
+}
+
+void profiler_policy_name(profiler_t* pProf, size_t i, const char* name) {
+  if (pProf == NULL) {
+    return;
+  }
+  char* dst = pProf->policyA[i].name;
+  strncpy(dst, name, sizeof(pProf->policyA[i].name) - 1);
+  dst[sizeof(pProf->policyA[i].name) - 1] = '\0';
+}
+
+void profiler_histo_add(profiler_histo_t* pHisto, uint64_t ns) {
+  ++(pHisto->countA[_profiler_bucket(ns)]);
+  ++(pHisto->count);
+  pHisto->sum += ns;
+  if (ns > pHisto->max) {
+    pHisto->max = ns;
+  }
+}
+
+uint64_t profiler_histo_percentile(const profiler_histo_t* pHisto, double q) {
+  if (pHisto->count == 0) {
+    return 0;
+  }
+  // Rank of the percentile (from 1 to count)
+  uint64_t rank = (uint64_t)(q * (double)pHisto->count + 0.5);
+  if (rank < 1) {
+    rank = 1;
+  }
+  uint64_t seen = 0;
+  for (size_t b = 0; b < PROFILER_NB_BUCKET; ++b) {
+    seen += pHisto->countA[b];
+    if (seen >= rank) {
+      uint64_t bound = _profiler_bucket_max(b);
+      return (bound < pHisto->max) ? bound : pHisto->max;
+    }
+  }
+  return pHisto->max;
+}
+
+uint64_t profiler_step_begin(profiler_t* pProf) {
+  if (pProf == NULL) {
+    return 0;
+  }
+  memset(pProf->lapA, 0, sizeof(pProf->lapA));
+  memset(pProf->nbLapA, 0, sizeof(pProf->nbLapA));
+  pProf->stepStart = profiler_now(pProf);
+  return pProf->stepStart;
+}
+
+void profiler_step_end(profiler_t* pProf, int step, uint64_t end) {
+  if (pProf == NULL) {
+    return;
+  }
+  for (size_t p = 0; p < PROFILER_NB_PHASE; ++p) {
+    if (pProf->nbLapA[p] > 0) {
+      profiler_histo_add(&(pProf->phaseA[p]), pProf->lapA[p]);
+    }
+  }
+  profiler_histo_add(&(pProf->step), end - pProf->stepStart);
+
+  if (pProf->trace != NULL) {
+    fprintf(pProf->trace, "%d", step);
+    for (size_t p = 0; p < PROFILER_NB_PHASE; ++p) {
+      fprintf(pProf->trace, ",%llu", (unsigned long long)pProf->lapA[p]);
+    }
+    fprintf(pProf->trace, ",%llu\n",
+            (unsigned long long)(end - pProf->stepStart));
+  }
+}
+
+void profiler_report(const profiler_t* pProf, FILE* stream) {
+  if (pProf == NULL) {
+    return;
+  }
+  fprintf(stream, "%-24s %10s %10s %10s %10s %10s\n", "phase (us)", "count",
+          "mean", "p50", "p99", "max");
+  for (size_t p = 0; p < PROFILER_NB_PHASE; ++p) {
+    if (pProf->phaseA[p].count > 0) {
+      _profiler_report_line(stream, PROFILER_PHASE_NAME[p],
+                            &(pProf->phaseA[p]));
+    }
+  }
+  _profiler_report_line(stream, "step", &(pProf->step));
+  for (size_t i = 0; i < pProf->nbPolicy; ++i) {
+    _profiler_report_line(stream, pProf->policyA[i].name,
+                          &(pProf->policyA[i].histo));
+  }
+}
+
+/**********************************/
+//  Local functions implementation
+
+size_t _profiler_bucket(uint64_t ns) {
+  const uint64_t nbSub = 1u << PROFILER_SUB_BITS;
+  if (ns < nbSub) {
+    return (size_t)ns;  // Exact
+  }
+  unsigned msb = 63;
+  while ((ns >> msb) == 0) {
+    --msb;
+  }
+  unsigned shift = msb - PROFILER_SUB_BITS;
+  return (size_t)(((shift + 1) << PROFILER_SUB_BITS) + ((ns >> shift) - nbSub));
+}
+
+uint64_t _profiler_bucket_max(size_t b) {
+  const uint64_t nbSub = 1u << PROFILER_SUB_BITS;
+  if (b < nbSub) {
+    return b;
+  }
+  unsigned shift = (unsigned)(b >> PROFILER_SUB_BITS) - 1;
+  uint64_t sub = (uint64_t)b & (nbSub - 1);
+  return (((nbSub + sub + 1) << shift) - 1);
+}
+
+void _profiler_report_line(FILE* stream,
+                           const char* name,
+                           const profiler_histo_t* pHisto) {
+  double mean = 0.0;
+  if (pHisto->count > 0) {
+    mean = (double)pHisto->sum / (double)pHisto->count;
+  }
+  fprintf(stream, "%-24s %10llu %10.1f %10.1f %10.1f %10.1f\n", name,
+          (unsigned long long)pHisto->count, mean / 1000.0,
+          (double)profiler_histo_percentile(pHisto, 0.50) / 1000.0,
+          (double)profiler_histo_percentile(pHisto, 0.99) / 1000.0,
+          (double)pHisto->max / 1000.0);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file profiler.h
+ * @brief Time spent in each phase of the steps of a game.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Durations are read on the monotonic clock, in ns, and counted in log-scale
+ * histograms: 8 buckets per power of two, so a percentile is known within
+ * 12.5%. Each phase of a step may be timed several times (its laps are
+ * summed), the step is then closed and its phases are counted.
+ *
+ * Every function accepts a NULL profiler and does nothing: a game without a
+ * profiler only pays a test per lap.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Number of buckets per power of two (log2).
+ *
+ */
+#define PROFILER_SUB_BITS 3
+
+/**
+ * @brief Number of buckets of a histogram (any 64 bits duration).
+ *
+ */
+#define PROFILER_NB_BUCKET ((64 - PROFILER_SUB_BITS + 1) << PROFILER_SUB_BITS)
+
+/**
+ * @brief Phases of a step.
+ *
+ */
+typedef enum profiler_phase {
+  PROFILER_FIGHT_BEFORE = 0,  ///< Fights before the moves.
+  PROFILER_PROPOSALS = 1,     ///< The AIs propose their moves.
+  PROFILER_SOLVE = 2,         ///< Conflicts between moves are solved.
+  PROFILER_RECORD = 3,        ///< The step is written in the replay.
+  PROFILER_PLAY = 4,          ///< The moves are applied.
+  PROFILER_UI = 5,            ///< The displays are refreshed.
+  PROFILER_FIGHT_AFTER = 6,   ///< Fights after the moves.
+  PROFILER_NB_PHASE = 7       ///< Number of phases.
+} profiler_phase_t;
+
+/**
+ * @brief Log-scale histogram of durations.
+ *
+ */
+typedef struct profiler_histo {
+  uint64_t countA[PROFILER_NB_BUCKET];  ///< Number of durations per bucket.
+  uint64_t count;                       ///< Number of durations.
+  uint64_t sum;                         ///< Sum of the durations (in ns).
+  uint64_t max;                         ///< Longest duration (in ns).
+} profiler_histo_t;
+
+/**
+ * @brief Policy calls of a character.
+ *
+ */
+typedef struct profiler_policy {
+  char name[48];           ///< Name of the character in the report.
+  profiler_histo_t histo;  ///< Durations of its calls.
+} profiler_policy_t;
+
+/**
+ * @brief A profiler of the steps of a game.
+ *
+ */
+typedef struct profiler {
+  profiler_histo_t phaseA[PROFILER_NB_PHASE];  ///< Durations of each phase.
+  profiler_histo_t step;                       ///< Durations of the steps.
+  profiler_policy_t* policyA;                  ///< Calls of each character.
+  size_t nbPolicy;                             ///< Number of characters.
+  uint64_t lapA[PROFILER_NB_PHASE];            ///< Phase times in the step.
+  unsigned nbLapA[PROFILER_NB_PHASE];          ///< Phase laps in the step.
+  uint64_t stepStart;                          ///< Start of the step.
+  FILE* trace;                                 ///< CSV trace (or NULL).
+} profiler_t;
+
+/**
+ * @brief Create a profiler.
+ *
+ * @param[in] nbPolicy Number of characters whose policy calls are timed.
+ * @param[in] tracePath Where to write a CSV line per step (NULL for none).
+ * @return profiler_t* The profiler, NULL if allocation failed or the trace
+ * can not be written.
+ */
+profiler_t* profiler_new(size_t nbPolicy, const char* tracePath);
+
+/**
+ * @brief Free a profiler.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ */
+void profiler_delete(profiler_t* pProf);
+
+/**
+ * @brief Name a character in the report.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @param[in] i Index of the character.
+ * @param[in] name Its name (truncated if too long).
+ */
+void profiler_policy_name(profiler_t* pProf, size_t i, const char* name);
+
+/**
+ * @brief Current time of the profiler.
+ *
+ * @param[in] pProf The profiler (may be NULL).
+ * @return uint64_t Time on the monotonic clock (in ns), 0 without profiler.
+ */
+static inline uint64_t profiler_now(const profiler_t* pProf) {
+  if (pProf == NULL) {
+    return 0;
+  }
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Count a duration in a histogram.
+ *
+ * @param[in,out] pHisto The histogram.
+ * @param[in] ns The duration (in ns).
+ */
+void profiler_histo_add(profiler_histo_t* pHisto, uint64_t ns);
+
+/**
+ * @brief Percentile of a histogram.
+ *
+ * @param[in] pHisto The histogram.
+ * @param[in] q The percentile (in [0, 1]).
+ * @return uint64_t Upper bound of the bucket of the percentile (at most the
+ * longest duration), 0 for an empty histogram.
+ */
+uint64_t profiler_histo_percentile(const profiler_histo_t* pHisto, double q);
+
+/**
+ * @brief Start a step.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @return uint64_t The start of the step (see profiler_now()).
+ */
+uint64_t profiler_step_begin(profiler_t* pProf);
+
+/**
+ * @brief End a lap of a phase.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @param[in] phase The phase.
+ * @param[in] start Start of the lap (see profiler_now()).
+ * @return uint64_t End of the lap, to start the next one.
+ */
+static inline uint64_t profiler_lap(profiler_t* pProf,
+                                    profiler_phase_t phase,
+                                    uint64_t start) {
+  if (pProf == NULL) {
+    return 0;
+  }
+  uint64_t now = profiler_now(pProf);
+  pProf->lapA[phase] += now - start;
+  ++(pProf->nbLapA[phase]);
+  return now;
+}
+
+/**
+ * @brief Count a policy call of a character.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @param[in] i Index of the character.
+ * @param[in] start Start of the call (see profiler_now()).
+ */
+static inline void profiler_policy(profiler_t* pProf,
+                                   size_t i,
+                                   uint64_t start) {
+  if (pProf != NULL) {
+    profiler_histo_add(&(pProf->policyA[i].histo),
+                       profiler_now(pProf) - start);
+  }
+}
+
+/**
+ * @brief Count a policy call of a character, timed by another process.
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @param[in] i Index of the character.
+ * @param[in] ns Duration of the call (in ns).
+ */
+static inline void profiler_policy_ns(profiler_t* pProf,
+                                      size_t i,
+                                      uint64_t ns) {
+  if (pProf != NULL) {
+    profiler_histo_add(&(pProf->policyA[i].histo), ns);
+  }
+}
+
+/**
+ * @brief End a step: count its phases (and trace them).
+ *
+ * @param[in,out] pProf The profiler (may be NULL).
+ * @param[in] step Number of the step.
+ * @param[in] end End of the step (the end of its last lap).
+ * @note Phases without lap in the step are not counted.
+ */
+void profiler_step_end(profiler_t* pProf, int step, uint64_t end);
+
+/**
+ * @brief Print p50, p99 and max of each phase, of the steps and of the
+ * policy calls.
+ *
+ * @param[in] pProf The profiler (may be NULL).
+ * @param[in,out] stream Where to print.
+ */
+void profiler_report(const profiler_t* pProf, FILE* stream);
+
+#endif  // End of PROFILER_H
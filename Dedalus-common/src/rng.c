@@ -0,0 +1,40 @@
+/**
+ * @file rng.c
+ * @brief Small seeded random generator (PCG32).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include "rng.h"
+
+/**********************************/
+//  Public functions implementation
+
+void rng_seed(rng_t* pRng, uint64_t seed, uint64_t stream) {
+  pRng->state = 0;
+  pRng->inc = (stream << 1) | 1u;
+  rng_next(pRng);
+  pRng->state += seed;
+  rng_next(pRng);
+}
+
+uint32_t rng_next(rng_t* pRng) {
+  uint64_t old = pRng->state;
+  pRng->state = old * 6364136223846793005ull + pRng->inc;
+  uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+  uint32_t rot = (uint32_t)(old >> 59);
+  return (xorShifted >> rot) | (xorShifted << ((-rot) & 31));
+}
+
+uint32_t rng_below(rng_t* pRng, uint32_t bound) {
+  // Reject the low values that would make the modulo biased
+  uint32_t threshold = (uint32_t)(-bound) % bound;
+  uint32_t r = rng_next(pRng);
+  while (r < threshold) {
+    r = rng_next(pRng);
+  }
+  return r % bound;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file rng.h
+ * @brief Small seeded random generator (PCG32).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * @brief State of a random generator.
+ *
+ * Each generator is independent (no global state): two generators seeded the
+ * same way always give the same sequence.
+ */
+typedef struct rng {
+  uint64_t state;  ///< Current state.
+  uint64_t inc;    ///< Stream selector (always odd).
+} rng_t;
+
+/**
+ * @brief Seed a generator.
+ *
+ * @param[out] pRng The generator.
+ * @param[in] seed The seed.
+ * @param[in] stream Stream number (generators with the same seed and
+ * different streams give unrelated sequences).
+ */
+void rng_seed(rng_t* pRng, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Next random number.
+ *
+ * @param[in,out] pRng The generator.
+ * @return uint32_t A uniform number in [0, 2^32[.
+ */
+uint32_t rng_next(rng_t* pRng);
+
+/**
+ * @brief Next random number below a bound.
+ *
+ * @param[in,out] pRng The generator.
+ * @param[in] bound The bound (must not be 0).
+ * @return uint32_t A uniform number in [0, bound[ (no modulo bias).
+ */
+uint32_t rng_below(rng_t* pRng, uint32_t bound);
+
+#endif  // End of RNG_H
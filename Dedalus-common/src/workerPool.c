@@ -0,0 +1,145 @@
+/**
+ * @file workerPool.c
+ * @brief Persistent pool of worker threads running indexed tasks.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdio.h>  // stderr
+
+#include "display.h"
+#include "workerPool.h"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Run tasks of the current batch until none is left.
+ *
+ * @param[in,out] pPool The pool (its lock must be held, it is held again on
+ * return).
+ */
+void _pool_work(pool_t* pPool);
+
+/**
+ * @brief Main loop of a helper thread.
+ *
+ * @param[in,out] arg The pool.
+ * @return void* Always NULL.
+ */
+void* _pool_helper(void* arg);
+
+/**********************************/
+//  Local functions implementation
+
+void _pool_work(pool_t* pPool) {
+  while (pPool->next < pPool->nbTasks) {
+    size_t i = pPool->next;
+    ++(pPool->next);
+
+    pthread_mutex_unlock(&(pPool->lock));
+    (*(pPool->task))(pPool->arg, i);
+    pthread_mutex_lock(&(pPool->lock));
+
+    ++(pPool->nbDone);
+    if (pPool->nbDone == pPool->nbTasks) {
+      pthread_cond_signal(&(pPool->done));
+    }
+  }
+}
+
+void* _pool_helper(void* arg) {
+  pool_t* pPool = (pool_t*)arg;
+  unsigned long seen = 0;
+
+  pthread_mutex_lock(&(pPool->lock));
+  while (!pPool->stop) {
+    if (pPool->generation == seen) {
+      pthread_cond_wait(&(pPool->start), &(pPool->lock));
+    } else {
+      seen = pPool->generation;
+      _pool_work(pPool);
+    }
+  }
+  pthread_mutex_unlock(&(pPool->lock));
+  return NULL;
+}
+
+/**********************************/
+//  Public functions implementation
+
+void pool_init(pool_t* pPool, size_t nbThreads) {
+  pPool->nbThreads = (nbThreads == 0) ? 1 : nbThreads;
+  pPool->task = NULL;
+  pPool->arg = NULL;
+  pPool->nbTasks = 0;
+  pPool->next = 0;
+  pPool->nbDone = 0;
+  pPool->generation = 0;
+  pPool->stop = false;
+
+  if ((pthread_mutex_init(&(pPool->lock), NULL) != 0) ||
+      (pthread_cond_init(&(pPool->start), NULL) != 0) ||
+      (pthread_cond_init(&(pPool->done), NULL) != 0)) {
+    display_fatal_error(stderr, "Error: can not init pool locks!");
+    exit(EXIT_FAILURE);
+  }
+
+  // NOTE: malloc(0) return NULL so it is ok
+  size_t nbHelpers = pPool->nbThreads - 1;
+  pPool->threadA = (pthread_t*)malloc(nbHelpers * sizeof(pthread_t));
+  if ((nbHelpers > 0) && (pPool->threadA == NULL)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < nbHelpers; ++i) {
+    if (pthread_create(&(pPool->threadA[i]), NULL, &_pool_helper, pPool) !=
+        0) {
+      display_fatal_error(stderr, "Error: can not create pool thread!");
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+void pool_run(pool_t* pPool, pool_task_t task, void* arg, size_t nbTasks) {
+  if (nbTasks == 0) {
+    return;
+  }
+
+  pthread_mutex_lock(&(pPool->lock));
+  pPool->task = task;
+  pPool->arg = arg;
+  pPool->nbTasks = nbTasks;
+  pPool->next = 0;
+  pPool->nbDone = 0;
+  ++(pPool->generation);
+  pthread_cond_broadcast(&(pPool->start));
+
+  // Work as well rather than just waiting
+  _pool_work(pPool);
+  while (pPool->nbDone < pPool->nbTasks) {
+    pthread_cond_wait(&(pPool->done), &(pPool->lock));
+  }
+  pthread_mutex_unlock(&(pPool->lock));
+}
+
+void pool_delete(pool_t* pPool) {
+  pthread_mutex_lock(&(pPool->lock));
+  pPool->stop = true;
+  pthread_cond_broadcast(&(pPool->start));
+  pthread_mutex_unlock(&(pPool->lock));
+
+  for (size_t i = 0; i + 1 < pPool->nbThreads; ++i) {
+    pthread_join(pPool->threadA[i], NULL);
+  }
+  free(pPool->threadA);
+  pPool->threadA = NULL;
+  pPool->nbThreads = 0;
+
+  pthread_cond_destroy(&(pPool->done));
+  pthread_cond_destroy(&(pPool->start));
+  pthread_mutex_destroy(&(pPool->lock));
+}
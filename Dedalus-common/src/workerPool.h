@@ -0,0 +1,74 @@
+/**
+ * @file workerPool.h
+ * @brief Persistent pool of worker threads running indexed tasks.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @brief A task run by the pool.
+ *
+ * @param[in,out] arg Shared argument given to pool_run.
+ * @param[in] i Index of the task, in [0, nbTasks[.
+ * @note A task must only write results owned by its index, so the results do
+ * not depend on which thread ran which task.
+ */
+typedef void (*pool_task_t)(void* arg, size_t i);
+
+/**
+ * @brief A pool of threads waiting for batches of tasks.
+ *
+ * The calling thread always takes part to a batch, so a pool of one thread
+ * creates no thread at all and runs everything sequentially.
+ */
+typedef struct pool {
+  pthread_t* threadA;       ///< Array of helper threads.
+  size_t nbThreads;         ///< Number of threads (helpers and caller).
+  pthread_mutex_t lock;     ///< Protects all the fields below.
+  pthread_cond_t start;     ///< Signaled when a batch is submitted.
+  pthread_cond_t done;      ///< Signaled when the last task ends.
+  pool_task_t task;         ///< Task of the current batch.
+  void* arg;                ///< Argument of the current batch.
+  size_t nbTasks;           ///< Number of tasks in the current batch.
+  size_t next;              ///< Next task index to hand out.
+  size_t nbDone;            ///< Number of finished tasks.
+  unsigned long generation; ///< Batch counter (wakes up the helpers).
+  bool stop;                ///< Asks the helpers to leave.
+} pool_t;
+
+/**
+ * @brief Start a pool.
+ *
+ * @param[out] pPool The pool to start.
+ * @param[in] nbThreads Number of threads running tasks, including the caller
+ * of pool_run (0 is read as 1).
+ */
+void pool_init(pool_t* pPool, size_t nbThreads);
+
+/**
+ * @brief Run a batch of tasks and wait for all of them.
+ *
+ * @param[in,out] pPool The pool to use.
+ * @param[in] task The task to run.
+ * @param[in,out] arg Argument given to each task.
+ * @param[in] nbTasks Number of tasks (task is called for 0 .. nbTasks-1).
+ */
+void pool_run(pool_t* pPool, pool_task_t task, void* arg, size_t nbTasks);
+
+/**
+ * @brief Stop the helper threads and clear the pool.
+ *
+ * @param[in,out] pPool The pool to clear.
+ */
+void pool_delete(pool_t* pPool);
+
+#endif  // End of WORKER_POOL_H
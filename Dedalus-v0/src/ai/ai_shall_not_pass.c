@@ -23,6 +23,7 @@
  * @param[in] comp Unused parameter.
  * @param[in] distance Unused parameter.
  * @param[in] ariane Unused parameter.
+ * @param[in,out] rng Unused parameter.
  * @return compass_t I stay here!
  */
 compass_t _ai_shall_not_pass_policy(bool north,
@@ -31,7 +32,8 @@ compass_t _ai_shall_not_pass_policy(bool north,
                                     bool west,
                                     compass_t comp,
                                     float distance,
-                                    string ariane) {
+                                    string ariane,
+                                    rng_t* rng) {
   // remove unused param
   (void)north;
   (void)east;
@@ -39,6 +41,7 @@ compass_t _ai_shall_not_pass_policy(bool north,
   (void)west;
   (void)distance;
   (void)ariane;
+  (void)rng;
   (void)comp;
   return Stay;
 }
@@ -50,6 +53,7 @@ const char* ai_shall_not_pass_get_name() {
 ai_t ai_shall_not_pass_new() {
   ai_t res;
   res.policy = &_ai_shall_not_pass_policy;
+  res.coroutine = NULL;
   res.name = ai_shall_not_pass_get_name();
   return res;
 }
@@ -14,23 +14,28 @@
 #include "gps.h"
 
 /**
- * @brief Linked list used to model the Ariadne string.
- * @warning The last move made is recorded in the first item in the list, and
-  the first move made is at the last item in the list. As customary, the list is
-  empty when Theseus has not moved yet (ie when positionned at the dedalus
-  entrance).
+ * @brief Growable stack of packed moves used to model the Ariadne string.
+ * @warning The last move made is the first item of the string (see
+  string_move), and the first move made is the last item. As customary, the
+  string is empty when Theseus has not moved yet (ie when positionned at the
+  dedalus entrance).
+ * @note Moves are stored oldest first, two per byte (Stay is recorded as well,
+ * so a move needs 4 bits). The buffer is shared by copies of the string: only
+ * the character owning it may modify it, AIs must only read it.
+ * @note With loop erasure (see string_erase_loops_init) the string also keeps
+ * the cell reached after each move, and a table from cells to depths, so that
+ * it always stays a simple path back to the start.
  */
-typedef struct link {
-  compass_t c;        ///< Last move made
-  struct link* next;  ///< Link to the previous move. NULL if beginning of
-                      ///< the string.
-} link_t;
-
-/**
- * @brief A string is a pointer to a link_t. NULL if the string is empty.
- * 
- */
-typedef link_t* string;
+typedef struct ariadne_string {
+  unsigned char* moves;  ///< Packed moves, oldest first. NULL if never used.
+  size_t size;           ///< Number of moves in the string.
+  size_t capacity;       ///< Number of moves the buffer can hold.
+  size_t* cellA;         ///< Cell after each move (cellA[0] is the start).
+                         ///< NULL without loop erasure.
+  size_t* depthTable;    ///< Open addressing table of the depths of the cells
+                         ///< (SIZE_MAX if the slot is free).
+  size_t depthCapacity;  ///< Size of depthTable (a power of two).
+} string;
 
 /**
  * @brief Create a new string.
@@ -82,4 +87,49 @@ bool string_can_go_back(const string s);
  */
 size_t string_size(const string s);
 
+/**
+ * @brief Turn on loop erasure for a string.
+ *
+ * @param[in, out] pS The string (must be empty).
+ * @param[in] cell Index of the start cell in the map.
+ * @return true Loop erasure is on.
+ * @return false Internal error. Operation failed.
+ * @note The moves must then be recorded with string_walk.
+ */
+bool string_erase_loops_init(string* pS, size_t cell);
+
+/**
+ * @brief Check if a string erases its loops.
+ *
+ * @param[in] s The string to check.
+ * @return true Loop erasure is on.
+ * @return false The string keeps every move.
+ */
+bool string_erases_loops(const string s);
+
+/**
+ * @brief Add a move in a string that erases its loops.
+ *
+ * If the cell reached is already on the string, the loop from that cell is
+ * cut off (in time linear in the length of the loop) instead.
+ *
+ * @param[in, out] pS The string to modify.
+ * @param[in] c From where we come from.
+ * @param[in] cell Index in the map of the cell reached by the move.
+ * @return true Modification ok.
+ * @return false Internal error. Operation failed.
+ */
+bool string_walk(string* pS, compass_t c, size_t cell);
+
+/**
+ * @brief Get a move of the string, starting from the last move made.
+ *
+ * @param[in] s The string.
+ * @param[in] i Index of the move (0 for the last move made, string_size(s) - 1
+ * for the first one).
+ * @return compass_t The move.
+ * @warning i must be lower than string_size(s).
+ */
+compass_t string_move(const string s, size_t i);
+
 #endif  // End of ARIADNE_H
@@ -23,13 +23,39 @@
 /**
  * @brief Is it possible to go in a given direction?
  *
- * @param[in] map The considered map.
+ * @param[in] pMap The considered map.
  * @param[in] pos The stating position.
  * @param[in] c The considered direction.
  * @return true Yes you can.
  * @return false No you can not.
  */
-bool _character_can_go(map_t map, pos_t pos, compass_t c);
+bool _character_can_go(const map_t* pMap, pos_t pos, compass_t c);
+
+/**
+ * @brief Flag of a direction in map_passable_around().
+ *
+ * @param[in] c The direction.
+ * @return unsigned Its map_around_t flag (0 for Stay).
+ */
+unsigned _character_around_flag(compass_t c);
+
+/**
+ * @brief The directions a character can go to from a position.
+ *
+ * @param[in] pMap The considered map.
+ * @param[in] pos The starting position.
+ * @param[out] pN Is it possible to go north?
+ * @param[out] pE Is it possible to go east?
+ * @param[out] pS Is it possible to go south?
+ * @param[out] pW Is it possible to go west?
+ * @note The passability layer is used if the map has one.
+ */
+void _character_around(const map_t* pMap,
+                       pos_t pos,
+                       bool* pN,
+                       bool* pE,
+                       bool* pS,
+                       bool* pW);
 
 /**
  * @brief Is a move provided by an AI valid, considering the valid directions?
@@ -70,7 +96,7 @@ pid_t _character_get_child_pid(pid_t pid);
 /**********************************/
 //  Local functions implementation
 
-bool _character_can_go(map_t map, pos_t pos, compass_t c) {
+bool _character_can_go(const map_t* pMap, pos_t pos, compass_t c) {
   size_t x = pos.x;
   size_t y = pos.y;
 
@@ -79,28 +105,63 @@ bool _character_can_go(map_t map, pos_t pos, compass_t c) {
   switch (c) {
     case North:
       if (pos.y > 0) {
-        e = map.m[y - 1][x];
+        e = map_get(pMap, x, y - 1);
       }
       break;
     case East:
-      if (x < map.x - 1) {
-        e = map.m[y][x + 1];
+      if (x < pMap->x - 1) {
+        e = map_get(pMap, x + 1, y);
       }
       break;
     case South:
-      if (y < map.y - 1) {
-        e = map.m[y + 1][x];
+      if (y < pMap->y - 1) {
+        e = map_get(pMap, x, y + 1);
       }
       break;
     case West:
       if (x > 0) {
-        e = map.m[y][x - 1];
+        e = map_get(pMap, x - 1, y);
       }
       break;
     default:
       break;
   }
-  return (e == PATH || e == EXIT || e == DEAD);
+  return map_is_passable(e);
+}
+
+unsigned _character_around_flag(compass_t c) {
+  switch (c) {
+    case North:
+      return AROUND_NORTH;
+    case East:
+      return AROUND_EAST;
+    case South:
+      return AROUND_SOUTH;
+    case West:
+      return AROUND_WEST;
+    default:
+      return 0;
+  }
+}
+
+void _character_around(const map_t* pMap,
+                       pos_t pos,
+                       bool* pN,
+                       bool* pE,
+                       bool* pS,
+                       bool* pW) {
+  if (pMap->pass != NULL) {
+    unsigned around = map_passable_around(pMap, pos);
+    *pN = (around & AROUND_NORTH) != 0;
+    *pE = (around & AROUND_EAST) != 0;
+    *pS = (around & AROUND_SOUTH) != 0;
+    *pW = (around & AROUND_WEST) != 0;
+  } else {
+    *pN = _character_can_go(pMap, pos, North);
+    *pE = _character_can_go(pMap, pos, East);
+    *pS = _character_can_go(pMap, pos, South);
+    *pW = _character_can_go(pMap, pos, West);
+  }
 }
 
 bool _character_is_valid_move(compass_t c, bool n, bool e, bool s, bool w) {
@@ -114,27 +175,27 @@ void _character_make_move(map_t* pMap,
                           bool* pExited) {
   // Restore tile
   if ((pC->type == PLAYER) || (pC->type == MINOTAUR)) {
-    pMap->m[pC->pos.y][pC->pos.x] = (char)pC->walkOn;
+    map_set(pMap, pC->pos.x, pC->pos.y, (char)pC->walkOn);
   }
 
   // Move
   pC->pos = gps_compute_move(pC->pos, c);
   // Check exit
-  if (pMap->m[pC->pos.y][pC->pos.x] == EXIT) {
+  if (map_get(pMap, pC->pos.x, pC->pos.y) == EXIT) {
     *pExited = true;
   }
 
   // Save target tile
-  pC->walkOn = (map_content_t)pMap->m[pC->pos.y][pC->pos.x];
+  pC->walkOn = (map_content_t)map_get(pMap, pC->pos.x, pC->pos.y);
   //  Set character
   // Deads are below
   if ((pC->type != DEAD) ||
       ((pC->walkOn != PLAYER) && (pC->walkOn != MINOTAUR))) {
-    pMap->m[pC->pos.y][pC->pos.x] = (char)pC->type;
+    map_set(pMap, pC->pos.x, pC->pos.y, (char)pC->type);
   }
 
   if (pC->pMask != NULL) {
-    map_mask_add(pC->pMask, pC->pos);
+    map_mask_add(pC->pMask, pMap, pC->pos);
   }
 }
 
@@ -222,7 +283,7 @@ character_t character_init(map_content_t type,
   c.targetCompass = Stay;
   c.targetDistance = 0;
 
-  c.ariadne = NULL;
+  c.ariadne = string_new();
   c.ai = ai;
   c.walkOn = PATH;
 
@@ -260,24 +321,61 @@ character_t character_init(map_content_t type,
   c.ending = EC_NO_ENDING;
 
   c.pMask = NULL;
+  rng_seed(&(c.rng), 0, 0);  // NOTE: seeded by the game
+  c.nbOverrun = 0;
   return c;
 }
 
-compass_t character_propose_move(const character_t* pC,
+compass_t character_propose_move(character_t* pC,
                                  const map_t* pMap,
                                  bool* pCheated) {
-  bool goNorth = _character_can_go(*pMap, pC->pos, North);
-  bool goEast = _character_can_go(*pMap, pC->pos, East);
-  bool goSouth = _character_can_go(*pMap, pC->pos, South);
-  bool goWest = _character_can_go(*pMap, pC->pos, West);
+  bool goNorth;
+  bool goEast;
+  bool goSouth;
+  bool goWest;
+  _character_around(pMap, pC->pos, &goNorth, &goEast, &goSouth, &goWest);
 
   compass_t move =
       (*(pC->ai.policy))(goNorth, goEast, goSouth, goWest, pC->targetCompass,
-                         pC->targetDistance, pC->ariadne);
+                         pC->targetDistance, pC->ariadne, &(pC->rng));
   *pCheated = !_character_is_valid_move(move, goNorth, goEast, goSouth, goWest);
   return move;
 }
 
+bool character_can_go(const character_t* pC, const map_t* pMap, compass_t c) {
+  if (pMap->pass != NULL) {
+    return (map_passable_around(pMap, pC->pos) & _character_around_flag(c)) !=
+           0;
+  }
+  return _character_can_go(pMap, pC->pos, c);
+}
+
+bool character_is_valid_move(const character_t* pC,
+                             const map_t* pMap,
+                             compass_t move) {
+  bool goNorth;
+  bool goEast;
+  bool goSouth;
+  bool goWest;
+  _character_around(pMap, pC->pos, &goNorth, &goEast, &goSouth, &goWest);
+
+  return _character_is_valid_move(move, goNorth, goEast, goSouth, goWest);
+}
+
+void character_record_move(character_t* pC,
+                           const map_t* pMap,
+                           compass_t move) {
+  if (string_erases_loops(pC->ariadne)) {
+    string_walk(&(pC->ariadne), move, pC->pos.y * pMap->x + pC->pos.x);
+  } else {
+    if (string_can_go_back(pC->ariadne)) {
+      string_remove_link(&(pC->ariadne));
+      string_remove_link(&(pC->ariadne));
+    }
+    string_add_link(&(pC->ariadne), move);
+  }
+}
+
 void character_play(character_t* pC,
                     compass_t move,
                     pos_t targetPos,
@@ -288,12 +386,7 @@ void character_play(character_t* pC,
   (void)steps;  // Unused;
 
   _character_make_move(pMap, pC, move, pExited);
-
-  if (string_can_go_back(pC->ariadne)) {
-    string_remove_link(&(pC->ariadne));
-    string_remove_link(&(pC->ariadne));
-  }
-  string_add_link(&(pC->ariadne), move);
+  character_record_move(pC, pMap, move);
 
   // Update info
   gps_direction(pC->pos, targetPos, &(pC->targetCompass),
@@ -316,13 +409,35 @@ void character_is_dead(map_t* pMap, character_t* pC) {
   pC->type = DEAD;
   pC->ai = ai_new("dead");
   pC->health = 0;
-  pMap->m[pC->pos.y][pC->pos.x] = DEAD;
+  map_set(pMap, pC->pos.x, pC->pos.y, DEAD);
 }
 
 void character_is_out(map_t* pMap, character_t* pC) {
   pC->type = EXIT;
   pC->ai = ai_new("out");
-  pMap->m[pC->pos.y][pC->pos.x] = EXIT;
+  map_set(pMap, pC->pos.x, pC->pos.y, EXIT);
+}
+
+const char* character_ending_name(ending_char_t ending) {
+  switch (ending) {
+    case EC_NO_ENDING:
+      return "no_ending";
+    case EC_KILL_BY_M:
+      return "kill_by_minotaur";
+    case EC_STARVE_MINOTAUR:
+      return "starve_minotaur";
+    case EC_STARVE_NO_MINOTAUR:
+      return "starve_no_minotaur";
+    case EC_CHEAT_MINOTAUR:
+      return "cheat_minotaur";
+    case EC_CHEAT_NO_MINOTAUR:
+      return "cheat_no_minotaur";
+    case EC_ESCAPE:
+      return "escape";
+    case EC_WIN:
+      return "win";
+  }
+  return "unknown";
 }
 
 void character_delete(map_t* pMap, character_t* pC) {
@@ -330,11 +445,11 @@ void character_delete(map_t* pMap, character_t* pC) {
   pC->id = -1;
   pC->health = -1;
 
-  pMap->m[pC->pos.y][pC->pos.x] = (char)pC->walkOn;
+  map_set(pMap, pC->pos.x, pC->pos.y, (char)pC->walkOn);
 
   string_delete(&(pC->ariadne));
 
-  map_delete(pC->pMask);
+  map_mask_delete(pC->pMask);
   free(pC->pMask);
 
   fclose(pC->stream);
@@ -51,7 +51,9 @@ typedef struct character {
   ai_t ai;                  ///< AI for the character
   FILE* stream;             ///< The stream for the character display.
   ending_char_t ending;     ///< What is the ending for the character.
-  map_t* pMask;             ///< Mask of what is seen by the character.
+  map_mask_t* pMask;        ///< What is seen (NULL without a display).
+  rng_t rng;                ///< Random generator of the character AI.
+  size_t nbOverrun;         ///< Moves not proposed within the time budget.
 } character_t;
 
 /**
@@ -75,15 +77,51 @@ character_t character_init(map_content_t type,
 /**
  * @brief Ask a character the move she wants to play.
  *
- * @param[in] pC The considered character.
+ * @param[in,out] pC The considered character (its AI may draw numbers).
  * @param[in] pMap The map.
  * @param[out] pCheated Says if the AI tries to cheat?
  * @return compass_t The desired move.
  */
-compass_t character_propose_move(const character_t* pC,
+compass_t character_propose_move(character_t* pC,
                                  const map_t* pMap,
                                  bool* pCheated);
 
+/**
+ * @brief Says if a character can go in a direction.
+ *
+ * @param[in] pC The considered character.
+ * @param[in] pMap The map.
+ * @param[in] c The direction.
+ * @return true The next position in this direction is free.
+ * @return false There is a wall (or the border of the map).
+ */
+bool character_can_go(const character_t* pC, const map_t* pMap, compass_t c);
+
+/**
+ * @brief Check a move proposed by an AI for a character.
+ *
+ * @param[in] pC The considered character.
+ * @param[in] pMap The map.
+ * @param[in] move The proposed move.
+ * @return true The move is allowed.
+ * @return false The AI tries to cheat.
+ */
+bool character_is_valid_move(const character_t* pC,
+                             const map_t* pMap,
+                             compass_t move);
+
+/**
+ * @brief Record a played move in the Ariadne string of a character.
+ *
+ * @param[in,out] pC The considered character (at its new position).
+ * @param[in] pMap The map.
+ * @param[in] move The played move.
+ * @note character_play already records the move.
+ */
+void character_record_move(character_t* pC,
+                           const map_t* pMap,
+                           compass_t move);
+
 /**
  * @brief Play a move for a character.
  *
@@ -123,6 +161,14 @@ void character_is_dead(map_t* pMap, character_t* pC);
  */
 void character_is_out(map_t* pMap, character_t* pC);
 
+/**
+ * @brief Short name of a character ending (for machine readable outputs).
+ *
+ * @param[in] ending The ending of the character.
+ * @return const char* The name of the ending.
+ */
+const char* character_ending_name(ending_char_t ending);
+
 /**
  * @brief Clear a character structure.
  *
@@ -23,7 +23,6 @@ config_t config_init() {
   config_t conf;
 
   conf.mapFile = NULL;
-  conf.mapMaxXSize = 1000;
 
   conf.color = COLOR;
   conf.debug = DEBUG;
@@ -32,6 +31,19 @@ config_t config_init() {
   conf.delay = 100000;
   conf.interactive = true;
   conf.maxMoves = 1000;
+  conf.mazeGps = false;
+  conf.eraseLoops = false;
+  conf.headless = false;
+  conf.thinking = true;
+  conf.seed = 0;
+  conf.replayFile = NULL;
+  conf.profile = false;
+  conf.traceFile = NULL;
+  conf.backend = BACKEND_WORKERS;
+  conf.nbThreads = 0;
+  conf.moveTimeout = 1000;
+  conf.moveClock = BUDGET_WALL;
+  conf.overrun = OVERRUN_STAY;
 
   conf.displayPidA = NULL;
   conf.nbDisplay = 0;
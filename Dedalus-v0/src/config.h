@@ -14,6 +14,8 @@
 #include <stdbool.h>    // bool, true, false
 #include <sys/types.h>  // pid_t
 
+#include "moveOptions.h"  // backend_t, budget_clock_t, overrun_t
+
 // Configuration
 extern const bool
     COLOR;  ///< Game in vintage colors if true and in B&W otherwise
@@ -26,15 +28,27 @@ extern const bool
  */
 typedef struct config {
   const char* mapFile;  ///< Path to the map file.
-  size_t mapMaxXSize;   ///< Max width of a map.
 
   bool color;     ///< Display with color?
   bool debug;     ///< Display in debug mode (no cleaning)?
   bool gameInfo;  ///< Display more game informations?
 
-  int delay;         ///< Time (in us) between frames.
-  bool interactive;  ///< Ask for interactive actions from GM.
-  int maxMoves;      ///< Maximum number of moves for players.
+  int delay;           ///< Time (in us) between the starts of two steps.
+  bool interactive;    ///< Ask for interactive actions from GM.
+  int maxMoves;        ///< Maximum number of moves for players.
+  bool mazeGps;        ///< Guide players with path distances (not compass).
+  bool eraseLoops;     ///< Ariadne strings without loops.
+  bool thinking;       ///< Simulate AIs thinking time (display only).
+  unsigned long seed;  ///< Seed of the random generators of the game.
+  bool headless;       ///< No display nor delay (batch runs).
+  const char* replayFile;  ///< Where to record a replay (NULL for none).
+  bool profile;            ///< Time the phases of the steps.
+  const char* traceFile;   ///< Where to trace the steps (NULL for none).
+  backend_t backend;       ///< How the AIs are asked for their moves.
+  size_t nbThreads;        ///< Threads asking AIs for moves (0: one per CPU).
+  int moveTimeout;         ///< Time (in ms) given to an AI for a move.
+  budget_clock_t moveClock;  ///< Clock measuring the time of a move.
+  overrun_t overrun;         ///< Penalty of an AI too slow for a move.
 
   size_t nbDisplay;    ///< Number of display for players.
   pid_t* displayPidA;  ///< Array of pid of terminals to display players.
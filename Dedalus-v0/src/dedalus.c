@@ -14,7 +14,7 @@
 #include <limits.h>   // INT_MAX
 #include <stdbool.h>  // bool, true, false
 #include <stdio.h>    // printf
-#include <stdlib.h>   // malloc, rand, srand
+#include <stdlib.h>   // malloc, strtoul
 #include <string.h>   // strcpy, strlen
 #include <time.h>     // time
 
@@ -49,15 +49,13 @@ void usage();
  * @return int Dedalus success.
  */
 int main(int argc, char* argv[]) {
-  // INIT Srand
-  srand((unsigned int)time(NULL));
-
-  // acquiring program parameters
+  // acquiring program parameters (the seed changes at each run by default)
   config_t config = config_init();
+  config.seed = (unsigned long)time(NULL);
   read_parameters(argc, argv, &config);
 
   map_t map;
-  bool mapLoaded = map_reader(config.mapFile, &map, config.mapMaxXSize);
+  bool mapLoaded = map_reader(config.mapFile, &map);
   if (!mapLoaded) {
     display_fatal_error(stderr, "Invalid map !\n");
     return EXIT_FAILURE;
@@ -74,10 +72,15 @@ int main(int argc, char* argv[]) {
   }
 
   // Start game
-  display_wait_user(stdout, "Press any key to start...", game.interactive);
-  game_start(&game);
+  if (config.headless) {
+    game_start(&game);
+    game_summary(stdout, &game);
+  } else {
+    display_wait_user(stdout, "Press any key to start...", game.interactive);
+    game_start(&game);
 
-  display_wait_user(stdout, "Press any key to finish...", game.interactive);
+    display_wait_user(stdout, "Press any key to finish...", game.interactive);
+  }
 
   // Clear at the end
   game_delete(&game);
@@ -93,7 +96,7 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
   int mandatory = 0;
   unsigned long tmp = 0;
 
-  while ((c = getopt(argc, argv, "had:m:M:p:")) != -1) {
+  while ((c = getopt(argc, argv, "habcgilqd:e:I:m:M:p:P:r:R:s:t:T:")) != -1) {
     switch (c) {
       case 'h':  // help.
         usage();
@@ -125,9 +128,68 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
         }
         pConfig->delay = (int)tmp;
         break;
+      case 'R':  // steps per second.
+        tmp = strtoul(optarg, NULL, 0);
+        if ((tmp < 1) || (tmp > 1000000)) {
+          ++errflg;
+        } else {
+          pConfig->delay = (int)(1000000 / tmp);
+        }
+        break;
       case 'a':  // automatic mode (not interactive).
         pConfig->interactive = false;
         break;
+      case 'b':  // batch mode (headless).
+        pConfig->headless = true;
+        pConfig->interactive = false;
+        break;
+      case 'q':  // quick: no thinking time.
+        pConfig->thinking = false;
+        break;
+      case 's':  // seed.
+        pConfig->seed = strtoul(optarg, NULL, 0);
+        break;
+      case 'g':  // maze-aware GPS.
+        pConfig->mazeGps = true;
+        break;
+      case 'l':  // loop-erased Ariadne strings.
+        pConfig->eraseLoops = true;
+        break;
+      case 'r':  // replay file.
+        pConfig->replayFile = optarg;
+        break;
+      case 'e':  // backend asking AIs for moves.
+        if (!options_backend_parse(optarg, &(pConfig->backend))) {
+          fprintf(stderr, "Unknown backend: %s\n", optarg);
+          ++errflg;
+        }
+        break;
+      case 't':  // number of threads asking AIs for moves.
+        pConfig->nbThreads = strtoul(optarg, NULL, 0);
+        break;
+      case 'T':  // time given to an AI for a move.
+        tmp = strtoul(optarg, NULL, 0);
+        if ((tmp < 1) || (tmp > INT_MAX)) {
+          ++errflg;
+        }
+        pConfig->moveTimeout = (int)tmp;
+        break;
+      case 'c':  // time of the AIs on the CPU clock.
+        pConfig->moveClock = BUDGET_CPU;
+        break;
+      case 'P':  // penalty of an AI out of time.
+        if (!options_overrun_parse(optarg, &(pConfig->overrun))) {
+          fprintf(stderr, "Unknown penalty: %s\n", optarg);
+          ++errflg;
+        }
+        break;
+      case 'i':  // timings of the steps.
+        pConfig->profile = true;
+        break;
+      case 'I':  // trace of the timings.
+        pConfig->profile = true;
+        pConfig->traceFile = optarg;
+        break;
       case ':': /* option without operand */
         fprintf(stderr, "Option -%c requires an operand\n", optopt);
         ++errflg;
@@ -150,14 +212,51 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
 
 void usage() {
   fprintf(stderr,
-          "Usage: ./Dedalus [-h] -m arg [-M arg] [-d arg] [-a] [-p arg -p arg  "
-          "...]    \n");
+          "Usage: ./Dedalus [-h] -m arg [-M arg] [-d arg] [-R arg] [-s arg] "
+          "[-e arg] [-t arg] [-T arg] [-c] [-P arg] [-a] [-b] [-g] [-l] "
+          "[-q] [-r arg] [-i] [-I arg] [-p arg -p arg ...]    \n");
   fprintf(stderr, "\n");
   fprintf(stderr, "Options: \n");
   fprintf(stderr, "\t -m arg \t (Mandatory) file of the map.\n");
   fprintf(stderr, "\t -p arg \t (Multiple) PID of the player terminal.\n");
-  fprintf(stderr, "\t -d arg \t [100000] Delay (in μs).\n");
+  fprintf(stderr,
+          "\t -d arg \t [100000] Period (in μs) of a step, whatever it "
+          "takes.\n");
+  fprintf(stderr, "\t -R arg \t [10] Steps per second (sets -d).\n");
+  fprintf(stderr,
+          "\t -e arg \t [workers] Backend asking AIs for moves: "
+          "sequential, fork, workers, threads or coroutines (only fork and "
+          "workers stop a hung AI).\n");
+  fprintf(stderr,
+          "\t -t arg \t [0] Threads asking AIs for moves (0: one per "
+          "CPU, at most one per character).\n");
+  fprintf(stderr,
+          "\t -T arg \t [1000] Time (in ms) given to an AI for a move (an AI "
+          "process still running 50 ms later is killed).\n");
+  fprintf(stderr,
+          "\t -c     \t [false] Time of the AIs on the CPU clock (not the "
+          "wall clock).\n");
+  fprintf(stderr,
+          "\t -P arg \t [stay] Penalty of an AI out of time: stay or "
+          "cheat.\n");
   fprintf(stderr, "\t -a     \t [false] Automatic mode (not interactive).\n");
+  fprintf(stderr,
+          "\t -b     \t [false] Batch mode: no display nor delay, print a "
+          "summary.\n");
+  fprintf(stderr,
+          "\t -g     \t [false] Maze-aware GPS (path distance to target).\n");
+  fprintf(stderr,
+          "\t -l     \t [false] Erase loops from the Ariadne strings.\n");
+  fprintf(stderr,
+          "\t -q     \t [false] Quick: AIs do not pretend to think.\n");
+  fprintf(stderr, "\t -s arg \t [time] Seed of the random generators.\n");
+  fprintf(stderr, "\t -r arg \t [none] Record a replay in this file.\n");
+  fprintf(stderr,
+          "\t -i     \t [false] Time the phases of the steps (report at the "
+          "end).\n");
+  fprintf(stderr,
+          "\t -I arg \t [none] Time the steps and trace them in this CSV "
+          "file.\n");
   fprintf(stderr, "\t -M arg \t [1000] Maximum number of steps for players.\n");
   fprintf(stderr, "\t -h     \t Display this message.	\n");
 }
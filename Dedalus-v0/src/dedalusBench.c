@@ -0,0 +1,772 @@
+/**
+ * @file dedalusBench.c
+ * @brief Benchmarks of the engine: map loading, steps, conflicts, rendering.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Each benchmark repeats an operation, doubling the number of repetitions
+ * until it runs long enough, and reports the time and the allocations per
+ * operation. Allocations are counted by wrapping malloc, calloc and realloc
+ * at link time (see CMakeLists.txt). The peak RSS is the peak of the process
+ * so far: benchmarks run from the smallest map to the largest one.
+ *
+ * The fight manager is a local function of the game: the game controller is
+ * compiled in this file to reach it (its object is then not taken from the
+ * engine library).
+ */
+
+#include <getopt.h>        /* Getopt */
+#include <limits.h>        // INT_MAX
+#include <stdbool.h>       // bool, true, false
+#include <stdio.h>         // printf
+#include <stdlib.h>        // malloc, strtoul
+#include <string.h>        // memcpy, strcmp
+#include <sys/resource.h>  // getrusage
+#include <time.h>          // clock_gettime
+#include <unistd.h>        // unlink
+
+#include "ai.h"
+#include "ai/ai_random.h"
+#include "config.h"   // configuration
+#include "display.h"  // rendering
+#include "frame.h"    // frame buffers
+#include "game.c"     // game controller, with its local functions
+#include "gps.h"      // gps_locator
+#include "map.h"      // manage the map
+#include "mazeGen.h"  // generated mazes
+
+/**
+ * @brief Name of the engine in the reports.
+ *
+ */
+#define BENCH_ENGINE "v0"
+
+#ifndef BENCH_BUILD_TYPE
+/**
+ * @brief Build type in the reports (set by CMake).
+ *
+ */
+#define BENCH_BUILD_TYPE ""
+#endif
+
+/**
+ * @brief Maximum number of generated maze sizes.
+ *
+ */
+#define BENCH_MAX_SIZES 16
+
+/**
+ * @brief Counters of the allocations of the process.
+ *
+ */
+typedef struct bench_allocs {
+  size_t count;  ///< Number of allocations.
+  size_t bytes;  ///< Number of bytes asked.
+} bench_allocs_t;
+
+/**
+ * @brief Allocations since the start (updated by the malloc wrappers).
+ *
+ */
+bench_allocs_t benchAllocs = {0, 0};
+
+/**
+ * @brief Context of the benchmarks of a map.
+ *
+ */
+typedef struct bench_ctx {
+  const char* mapFile;    ///< Path to the map.
+  const char* label;      ///< Name of the map in the reports.
+  map_t map;              ///< The map, loaded once.
+  game_t game;            ///< A headless game of a copy of the map.
+  moves_prop_t* moves;    ///< Moves proposed at the start of the game.
+  moves_prop_t* work;     ///< Copy of the moves given to the solver.
+  size_t nbChar;          ///< Number of characters.
+  moves_solver_t solver;  ///< Conflict solver of the game.
+  frame_t frame;          ///< Frame of the game master view.
+  FILE* sink;             ///< Where frames are written (/dev/null).
+  unsigned long seed;     ///< Seed of the next full game.
+} bench_ctx_t;
+
+/**
+ * @brief Result of a benchmark.
+ *
+ */
+typedef struct bench_result {
+  const char* name;       ///< Name of the benchmark.
+  const char* map;        ///< Path to the map.
+  size_t cells;           ///< Number of cells of the map.
+  size_t runs;            ///< Number of repetitions of the operation.
+  size_t ops;             ///< Number of operations (steps for full games).
+  double ns;              ///< Total time (in ns).
+  bench_allocs_t allocs;  ///< Allocations of all repetitions.
+  long peakRss;           ///< Peak resident set size (in kB).
+} bench_result_t;
+
+/**
+ * @brief A benchmarked operation.
+ *
+ * @param[in,out] pCtx The context of the map.
+ * @return size_t Number of operations done (1, or steps for full games).
+ */
+typedef size_t (*bench_fn_t)(bench_ctx_t* pCtx);
+
+/**
+ * @brief Options of the benchmarks.
+ *
+ */
+typedef struct bench_options {
+  long minNs;                     ///< Minimum time of a benchmark (in ns).
+  size_t sizeA[BENCH_MAX_SIZES];  ///< Sides of the generated mazes.
+  size_t nbSizes;                 ///< Number of generated mazes.
+  bool json;                      ///< Report in JSON (CSV else).
+  const char* output;             ///< Report file (NULL for stdout).
+} bench_options_t;
+
+/**
+ * @brief Real malloc (see the link options).
+ *
+ */
+void* __real_malloc(size_t size);
+
+/**
+ * @brief Real calloc (see the link options).
+ *
+ */
+void* __real_calloc(size_t nmemb, size_t size);
+
+/**
+ * @brief Real realloc (see the link options).
+ *
+ */
+void* __real_realloc(void* ptr, size_t size);
+
+/**
+ * @brief Counting malloc.
+ *
+ * @param[in] size Number of bytes.
+ * @return void* As malloc.
+ */
+void* __wrap_malloc(size_t size);
+
+/**
+ * @brief Counting calloc.
+ *
+ * @param[in] nmemb Number of members.
+ * @param[in] size Size of a member.
+ * @return void* As calloc.
+ */
+void* __wrap_calloc(size_t nmemb, size_t size);
+
+/**
+ * @brief Counting realloc.
+ *
+ * @param[in] ptr Block to resize.
+ * @param[in] size Number of bytes.
+ * @return void* As realloc.
+ */
+void* __wrap_realloc(void* ptr, size_t size);
+
+/**
+ * @brief Parse parameters to build the options of the benchmarks.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @param[out] pOptions The options.
+ * @return int Index of the first map file in argv.
+ */
+int read_parameters(int argc, char* argv[], bench_options_t* pOptions);
+
+/**
+ * @brief Display the program usage.
+ *
+ */
+void usage();
+
+/**
+ * @brief Current time of the monotonic clock (in ns).
+ *
+ * @return long long The time.
+ */
+long long _bench_now();
+
+/**
+ * @brief Write a generated maze in a file.
+ *
+ * @param[in] path Path of the file.
+ * @param[in] side Number of rows and columns.
+ * @return true The file is written.
+ * @return false It can not be written.
+ * @note The maze is the same at each run: one player, one Minotaur, one exit
+ * and a few loops.
+ */
+bool _bench_write_maze(const char* path, size_t side);
+
+/**
+ * @brief Prepare the context of a map.
+ *
+ * @param[out] pCtx The context.
+ * @param[in] mapFile Path to the map.
+ * @param[in] label Name of the map in the reports.
+ * @return true The context is ready.
+ * @return false The map is invalid.
+ */
+bool _bench_ctx_init(bench_ctx_t* pCtx,
+                     const char* mapFile,
+                     const char* label);
+
+/**
+ * @brief Clear the context of a map.
+ *
+ * @param[in,out] pCtx The context.
+ */
+void _bench_ctx_delete(bench_ctx_t* pCtx);
+
+/**
+ * @brief Build the configuration of a headless game.
+ *
+ * @param[in] mapFile Path to the map.
+ * @param[in] seed Seed of the game.
+ * @return config_t The configuration.
+ */
+config_t _bench_config(const char* mapFile, unsigned long seed);
+
+/**
+ * @brief Run a benchmark until it lasts long enough.
+ *
+ * @param[in] name Name of the benchmark.
+ * @param[in,out] pCtx The context of the map.
+ * @param[in] fn The operation.
+ * @param[in] minNs Minimum duration (in ns).
+ * @return bench_result_t The result of the last (and longest) run.
+ */
+bench_result_t _bench_run(const char* name,
+                          bench_ctx_t* pCtx,
+                          bench_fn_t fn,
+                          long minNs);
+
+/**
+ * @brief Load and free the map.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_map_reader(bench_ctx_t* pCtx);
+
+/**
+ * @brief Locate the players of the map.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_gps_locator(bench_ctx_t* pCtx);
+
+/**
+ * @brief Solve the conflicts between the first moves of the game.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_solve_conflicts(bench_ctx_t* pCtx);
+
+/**
+ * @brief Look for fights at the start of the game.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_fight_manager(bench_ctx_t* pCtx);
+
+/**
+ * @brief Render the whole game master view.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_render_full(bench_ctx_t* pCtx);
+
+/**
+ * @brief Render the game master view when nothing changed.
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t 1.
+ */
+size_t _bench_render_diff(bench_ctx_t* pCtx);
+
+/**
+ * @brief Play a full headless game (loading its map).
+ *
+ * @param[in,out] pCtx The context.
+ * @return size_t Number of steps of the game.
+ */
+size_t _bench_game(bench_ctx_t* pCtx);
+
+/**
+ * @brief Write the results as CSV (one row per benchmark and map).
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] resultA The results.
+ * @param[in] nbResults Number of results.
+ */
+void _bench_write_csv(FILE* stream,
+                      const bench_result_t* resultA,
+                      size_t nbResults);
+
+/**
+ * @brief Write a string as a JSON string.
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] s The string.
+ */
+void _bench_write_json_string(FILE* stream, const char* s);
+
+/**
+ * @brief Write the results as JSON.
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] resultA The results.
+ * @param[in] nbResults Number of results.
+ */
+void _bench_write_json(FILE* stream,
+                       const bench_result_t* resultA,
+                       size_t nbResults);
+
+/**
+ * @brief Main of the benchmarks.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @return int Benchmarks success.
+ */
+int main(int argc, char* argv[]) {
+  bench_options_t options;
+  options.minNs = 200 * 1000 * 1000;
+  options.sizeA[0] = 64;
+  options.sizeA[1] = 256;
+  options.sizeA[2] = 1024;
+  options.nbSizes = 3;
+  options.json = false;
+  options.output = NULL;
+  int first = read_parameters(argc, argv, &options);
+
+  // Given maps, then generated mazes (smallest first)
+  size_t nbFiles = (size_t)(argc - first);
+  size_t nbMaps = nbFiles + options.nbSizes;
+  char** mapA = (char**)malloc((nbMaps + 1) * sizeof(char*));
+  char** labelA = (char**)malloc((nbMaps + 1) * sizeof(char*));
+  if ((mapA == NULL) || (labelA == NULL)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < nbFiles; ++i) {
+    mapA[i] = argv[first + (int)i];
+    labelA[i] = argv[first + (int)i];
+  }
+  for (size_t i = nbFiles; i < nbMaps; ++i) {
+    size_t side = options.sizeA[i - nbFiles];
+    mapA[i] = (char*)malloc(64);
+    labelA[i] = (char*)malloc(64);
+    if ((mapA[i] == NULL) || (labelA[i] == NULL)) {
+      display_fatal_error(stderr, "Error: malloc failed!");
+      return EXIT_FAILURE;
+    }
+    snprintf(mapA[i], 64, "/tmp/dedalus_bench_%zu_%ld", side, (long)getpid());
+    snprintf(labelA[i], 64, "maze_%zux%zu", side, side);
+    if (!_bench_write_maze(mapA[i], side)) {
+      display_fatal_error(stderr, "Error: can not write a maze!\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const char* nameA[] = {"map_reader",   "gps_locator", "solve_conflicts",
+                         "fight_manager", "render_full", "render_diff",
+                         "game"};
+  const bench_fn_t fnA[] = {&_bench_map_reader,      &_bench_gps_locator,
+                            &_bench_solve_conflicts, &_bench_fight_manager,
+                            &_bench_render_full,     &_bench_render_diff,
+                            &_bench_game};
+  size_t nbBench = sizeof(fnA) / sizeof(fnA[0]);
+  bench_result_t* resultA =
+      (bench_result_t*)malloc((nbMaps * nbBench + 1) * sizeof(bench_result_t));
+  if (resultA == NULL) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    return EXIT_FAILURE;
+  }
+
+  size_t nbResults = 0;
+  for (size_t m = 0; m < nbMaps; ++m) {
+    bench_ctx_t ctx;
+    if (!_bench_ctx_init(&ctx, mapA[m], labelA[m])) {
+      fprintf(stderr, "Skip %s (invalid map)\n", mapA[m]);
+      continue;
+    }
+    for (size_t b = 0; b < nbBench; ++b) {
+      resultA[nbResults] = _bench_run(nameA[b], &ctx, fnA[b], options.minNs);
+      fprintf(stderr, "%-16s %-24s %12.1f ns/op\n", nameA[b], labelA[m],
+              resultA[nbResults].ns / (double)resultA[nbResults].ops);
+      ++nbResults;
+    }
+    _bench_ctx_delete(&ctx);
+  }
+
+  FILE* stream = stdout;
+  if (options.output != NULL) {
+    stream = fopen(options.output, "w");
+    if (stream == NULL) {
+      display_fatal_error(stderr, "Error: can not open the report file!\n");
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.json) {
+    _bench_write_json(stream, resultA, nbResults);
+  } else {
+    _bench_write_csv(stream, resultA, nbResults);
+  }
+  if (options.output != NULL) {
+    fclose(stream);
+  }
+
+  // Clear at the end
+  for (size_t i = nbFiles; i < nbMaps; ++i) {
+    unlink(mapA[i]);
+    free(mapA[i]);
+    free(labelA[i]);
+  }
+  free(mapA);
+  free(labelA);
+  free(resultA);
+
+  return EXIT_SUCCESS;
+}
+
+void* __wrap_malloc(size_t size) {
+  ++(benchAllocs.count);
+  benchAllocs.bytes += size;
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t nmemb, size_t size) {
+  ++(benchAllocs.count);
+  benchAllocs.bytes += nmemb * size;
+  return __real_calloc(nmemb, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  ++(benchAllocs.count);
+  benchAllocs.bytes += size;
+  return __real_realloc(ptr, size);
+}
+
+int read_parameters(int argc, char* argv[], bench_options_t* pOptions) {
+  /* Parameters parsing */
+  int c = 0;
+  int errflg = 0;
+  unsigned long tmp = 0;
+  char* next = NULL;
+
+  while ((c = getopt(argc, argv, "hf:o:s:t:")) != -1) {
+    switch (c) {
+      case 'h':  // help.
+        usage();
+        exit(EXIT_SUCCESS);
+        break;
+      case 's':  // sides of the generated mazes.
+        pOptions->nbSizes = 0;
+        next = optarg;
+        while ((*next != '\0') && (pOptions->nbSizes < BENCH_MAX_SIZES)) {
+          tmp = strtoul(next, &next, 0);
+          if ((tmp < 4) || (tmp > 1 << 16)) {
+            ++errflg;
+          }
+          pOptions->sizeA[pOptions->nbSizes++] = (size_t)tmp;
+          next += (*next == ',') ? 1 : 0;
+        }
+        break;
+      case 't':  // minimum time of a benchmark.
+        tmp = strtoul(optarg, NULL, 0);
+        if (tmp > INT_MAX) {
+          ++errflg;
+        }
+        pOptions->minNs = (long)tmp * 1000 * 1000;
+        break;
+      case 'f':  // format of the report.
+        if (strcmp(optarg, "json") == 0) {
+          pOptions->json = true;
+        } else if (strcmp(optarg, "csv") == 0) {
+          pOptions->json = false;
+        } else {
+          ++errflg;
+        }
+        break;
+      case 'o':  // report file.
+        pOptions->output = optarg;
+        break;
+      case ':': /* option without operand */
+        fprintf(stderr, "Option -%c requires an operand\n", optopt);
+        ++errflg;
+        break;
+      case '?':
+        fprintf(stderr, "Unrecognized option: -%c\n", optopt);
+        ++errflg;
+    }
+  }
+
+  if (errflg) {
+    usage();
+    exit(EXIT_FAILURE);
+  }
+  return optind;
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: ./DedalusBench [-h] [-t arg] [-s arg] [-f csv|json] "
+          "[-o arg] [map ...]\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Options: \n");
+  fprintf(stderr, "\t map    \t Maps to benchmark (before the mazes).\n");
+  fprintf(stderr,
+          "\t -t arg \t [200] Minimum time of a benchmark (in ms).\n");
+  fprintf(stderr,
+          "\t -s arg \t [64,256,1024] Sides of the generated mazes.\n");
+  fprintf(stderr, "\t -f arg \t [csv] Report format (csv or json).\n");
+  fprintf(stderr, "\t -o arg \t [stdout] Report file.\n");
+  fprintf(stderr, "\t -h     \t Display this message.	\n");
+}
+
+long long _bench_now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+bool _bench_write_maze(const char* path, size_t side) {
+  FILE* file = fopen(path, "w");
+  if (file == NULL) {
+    return false;
+  }
+  maze_options_t options = maze_options_init();
+  options.x = side;
+  options.y = side;
+  options.seed = side;
+  options.braid = 10;
+  bool written = maze_write(&options, file);
+  return (fclose(file) == 0) && written;
+}
+
+config_t _bench_config(const char* mapFile, unsigned long seed) {
+  config_t config = config_init();
+  config.mapFile = mapFile;
+  config.headless = true;
+  config.interactive = false;
+  config.thinking = false;
+  config.delay = 0;
+  config.seed = seed;
+  // The engine alone: the AIs are asked in the bench process
+  config.backend = BACKEND_SEQUENTIAL;
+  return config;
+}
+
+bool _bench_ctx_init(bench_ctx_t* pCtx,
+                     const char* mapFile,
+                     const char* label) {
+  pCtx->mapFile = mapFile;
+  pCtx->label = label;
+  pCtx->seed = 1;
+  if (!map_reader(mapFile, &(pCtx->map))) {
+    return false;
+  }
+
+  // The game plays on its own copy of the map
+  map_t* pMap = (map_t*)malloc(1 * sizeof(map_t));
+  if ((pMap == NULL) || !map_reader(mapFile, pMap)) {
+    map_delete(&(pCtx->map));
+    free(pMap);
+    return false;
+  }
+  config_t config = _bench_config(mapFile, pCtx->seed);
+  if (!game_init(&(pCtx->game), &config, mapFile, pMap, 100,
+                 ai_new(ai_random_get_name()), 10,
+                 ai_new(ai_random_get_name()))) {
+    map_delete(&(pCtx->map));
+    map_delete(pMap);
+    free(pMap);
+    return false;
+  }
+
+  _game_init_moves_prop(&(pCtx->game), &(pCtx->moves), &(pCtx->nbChar));
+  _game_init_moves_prop(&(pCtx->game), &(pCtx->work), &(pCtx->nbChar));
+  solver_init(&(pCtx->solver), pCtx->nbChar);
+  _game_get_moves_propositions(&(pCtx->game), pCtx->moves, pCtx->nbChar);
+
+  pCtx->sink = fopen("/dev/null", "w");
+  if (!map_walls_init(pMap) || (pCtx->sink == NULL) ||
+      !frame_init(&(pCtx->frame), pMap->x, pMap->y)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  return true;
+}
+
+void _bench_ctx_delete(bench_ctx_t* pCtx) {
+  frame_delete(&(pCtx->frame));
+  fclose(pCtx->sink);
+  free(pCtx->moves);
+  free(pCtx->work);
+  solver_delete(&(pCtx->solver));
+  map_t* pMap = pCtx->game.pMap;
+  game_delete(&(pCtx->game));
+  free(pMap);
+  map_delete(&(pCtx->map));
+}
+
+bench_result_t _bench_run(const char* name,
+                          bench_ctx_t* pCtx,
+                          bench_fn_t fn,
+                          long minNs) {
+  bench_result_t r;
+  r.name = name;
+  r.map = pCtx->label;
+  r.cells = pCtx->map.x * pCtx->map.y;
+
+  // Double the repetitions until the run is long enough
+  pCtx->seed = 1;
+  for (size_t runs = 1;; runs *= 2) {
+    bench_allocs_t before = benchAllocs;
+    size_t ops = 0;
+    long long start = _bench_now();
+    for (size_t i = 0; i < runs; ++i) {
+      ops += fn(pCtx);
+    }
+    long long ns = _bench_now() - start;
+
+    r.runs = runs;
+    r.ops = (ops > 0) ? ops : 1;
+    r.ns = (double)ns;
+    r.allocs.count = benchAllocs.count - before.count;
+    r.allocs.bytes = benchAllocs.bytes - before.bytes;
+    if (ns >= minNs) {
+      break;
+    }
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  r.peakRss = usage.ru_maxrss;
+  return r;
+}
+
+size_t _bench_map_reader(bench_ctx_t* pCtx) {
+  map_t map;
+  if (map_reader(pCtx->mapFile, &map)) {
+    map_delete(&map);
+  }
+  return 1;
+}
+
+size_t _bench_gps_locator(bench_ctx_t* pCtx) {
+  pos_t* posA = NULL;
+  gps_locator(&(pCtx->map), PLAYER, &posA);
+  free(posA);
+  return 1;
+}
+
+size_t _bench_solve_conflicts(bench_ctx_t* pCtx) {
+  // The solver changes the moves it is given
+  memcpy(pCtx->work, pCtx->moves, pCtx->nbChar * sizeof(moves_prop_t));
+  solver_solve(&(pCtx->solver), pCtx->game.pMap, pCtx->work, pCtx->nbChar);
+  return 1;
+}
+
+size_t _bench_fight_manager(bench_ctx_t* pCtx) {
+  _game_fight_manager(&(pCtx->game));
+  return 1;
+}
+
+size_t _bench_render_full(bench_ctx_t* pCtx) {
+  const game_t* pGame = &(pCtx->game);
+  display_ui_gm(pCtx->sink, &(pCtx->frame), pGame->gameName, pGame->pMap,
+                pGame->nbPlayerAlive, pGame->nbPlayerOnBoard,
+                pGame->nbMinotaurAlive, 0, false, false);
+  return 1;
+}
+
+size_t _bench_render_diff(bench_ctx_t* pCtx) {
+  const game_t* pGame = &(pCtx->game);
+  display_ui_gm(pCtx->sink, &(pCtx->frame), pGame->gameName, pGame->pMap,
+                pGame->nbPlayerAlive, pGame->nbPlayerOnBoard,
+                pGame->nbMinotaurAlive, 0, false, true);
+  return 1;
+}
+
+size_t _bench_game(bench_ctx_t* pCtx) {
+  // Each game has its own seed, the same from one run to the next
+  map_t map;
+  if (!map_reader(pCtx->mapFile, &map)) {
+    return 0;
+  }
+  config_t config = _bench_config(pCtx->mapFile, pCtx->seed++);
+  game_t game;
+  if (!game_init(&game, &config, pCtx->mapFile, &map, 100,
+                 ai_new(ai_random_get_name()), 10,
+                 ai_new(ai_random_get_name()))) {
+    map_delete(&map);
+    return 0;
+  }
+  game_start(&game);
+  size_t steps = (size_t)game.steps;
+  game_delete(&game);
+  return steps;
+}
+
+void _bench_write_csv(FILE* stream,
+                      const bench_result_t* resultA,
+                      size_t nbResults) {
+  fprintf(stream, "engine,build,bench,map,cells,runs,ops,ns_per_op,"
+          "ops_per_s,allocs_per_op,bytes_per_op,peak_rss_kb\n");
+  for (size_t i = 0; i < nbResults; ++i) {
+    const bench_result_t* pR = &(resultA[i]);
+    double ops = (double)pR->ops;
+    fprintf(stream, "%s,%s,%s,%s,%zu,%zu,%zu,%.1f,%.1f,%.2f,%.1f,%ld\n",
+            BENCH_ENGINE, BENCH_BUILD_TYPE, pR->name, pR->map, pR->cells,
+            pR->runs, pR->ops, pR->ns / ops, ops * 1e9 / pR->ns,
+            (double)pR->allocs.count / ops, (double)pR->allocs.bytes / ops,
+            pR->peakRss);
+  }
+}
+
+void _bench_write_json_string(FILE* stream, const char* s) {
+  fputc('"', stream);
+  for (; *s != '\0'; ++s) {
+    if ((*s == '"') || (*s == '\\')) {
+      fputc('\\', stream);
+    }
+    fputc(*s, stream);
+  }
+  fputc('"', stream);
+}
+
+void _bench_write_json(FILE* stream,
+                       const bench_result_t* resultA,
+                       size_t nbResults) {
+  fprintf(stream, "{\n  \"engine\": \"%s\",\n  \"build\": \"%s\",\n"
+          "  \"results\": [", BENCH_ENGINE, BENCH_BUILD_TYPE);
+  for (size_t i = 0; i < nbResults; ++i) {
+    const bench_result_t* pR = &(resultA[i]);
+    double ops = (double)pR->ops;
+    fprintf(stream, "%s\n    {\"bench\": \"%s\", \"map\": ",
+            (i > 0) ? "," : "", pR->name);
+    _bench_write_json_string(stream, pR->map);
+    fprintf(stream,
+            ", \"cells\": %zu, \"runs\": %zu, \"ops\": %zu, "
+            "\"ns_per_op\": %.1f, \"ops_per_s\": %.1f, "
+            "\"allocs_per_op\": %.2f, \"bytes_per_op\": %.1f, "
+            "\"peak_rss_kb\": %ld}",
+            pR->cells, pR->runs, pR->ops, pR->ns / ops, ops * 1e9 / pR->ns,
+            (double)pR->allocs.count / ops, (double)pR->allocs.bytes / ops,
+            pR->peakRss);
+  }
+  fprintf(stream, "\n  ]\n}\n");
+}
@@ -0,0 +1,151 @@
+/**
+ * @file dedalusMaze.c
+ * @brief Generate a dedalus map (see mazeGen.h).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <getopt.h>   /* Getopt */
+#include <stdbool.h>  // bool, true, false
+#include <stdio.h>    // printf
+#include <stdlib.h>   // strtoul
+
+#include "display.h"  // Fatal errors
+#include "mazeGen.h"  // maze generation
+
+/**
+ * @brief Options of the generator.
+ *
+ */
+typedef struct generator_options {
+  maze_options_t maze;  ///< The maze to generate.
+  const char* output;   ///< Path of the map (NULL for the standard output).
+} generator_options_t;
+
+/**
+ * @brief Parse parameters to build the options of the generator.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @param[out] pOptions The options (must be allocated).
+ */
+void read_parameters(int argc, char* argv[], generator_options_t* pOptions);
+
+/**
+ * @brief Display the program usage.
+ *
+ */
+void usage();
+
+/**
+ * @brief Main of DedalusMaze
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @return int DedalusMaze success.
+ */
+int main(int argc, char* argv[]) {
+  generator_options_t options;
+  options.maze = maze_options_init();
+  options.output = NULL;
+  read_parameters(argc, argv, &options);
+
+  if (!maze_options_check(&(options.maze))) {
+    display_fatal_error(stderr,
+                        "Invalid maze: at least 3x3, braid up to 100% and "
+                        "at most one character or exit per cell!\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE* stream = stdout;
+  if (options.output != NULL) {
+    stream = fopen(options.output, "w");
+    if (stream == NULL) {
+      display_fatal_error(stderr, "Error: can not open the map file!\n");
+      return EXIT_FAILURE;
+    }
+  }
+  bool written = maze_write(&(options.maze), stream);
+  if ((stream != stdout) && (fclose(stream) != 0)) {
+    written = false;
+  }
+  if (!written) {
+    display_fatal_error(stderr, "Error: can not write the map!\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+void read_parameters(int argc, char* argv[], generator_options_t* pOptions) {
+  /* Parameters parsing */
+  int c = 0;
+  int errflg = 0;
+
+  while ((c = getopt(argc, argv, "hx:y:s:b:p:m:e:o:")) != -1) {
+    switch (c) {
+      case 'h':  // help.
+        usage();
+        exit(EXIT_SUCCESS);
+        break;
+      case 'x':  // number of columns.
+        pOptions->maze.x = strtoul(optarg, NULL, 0);
+        break;
+      case 'y':  // number of rows.
+        pOptions->maze.y = strtoul(optarg, NULL, 0);
+        break;
+      case 's':  // seed.
+        pOptions->maze.seed = strtoul(optarg, NULL, 0);
+        break;
+      case 'b':  // braid.
+        pOptions->maze.braid = (unsigned)strtoul(optarg, NULL, 0);
+        break;
+      case 'p':  // number of players.
+        pOptions->maze.nbPlayer = strtoul(optarg, NULL, 0);
+        break;
+      case 'm':  // number of Minotaurs.
+        pOptions->maze.nbMinotaur = strtoul(optarg, NULL, 0);
+        break;
+      case 'e':  // number of exits.
+        pOptions->maze.nbExit = strtoul(optarg, NULL, 0);
+        break;
+      case 'o':  // map file.
+        pOptions->output = optarg;
+        break;
+      case ':': /* option without operand */
+        fprintf(stderr, "Option -%c requires an operand\n", optopt);
+        ++errflg;
+        break;
+      case '?':
+        fprintf(stderr, "Unrecognized option: -%c\n", optopt);
+        ++errflg;
+    }
+  }
+
+  if (errflg) {
+    usage();
+    exit(EXIT_FAILURE);
+  }
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: ./DedalusMaze [-h] [-x arg] [-y arg] [-s arg] [-b arg] "
+          "[-p arg] [-m arg] [-e arg] [-o arg]\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Options: \n");
+  fprintf(stderr, "\t -x arg \t [31] Number of columns.\n");
+  fprintf(stderr, "\t -y arg \t [21] Number of rows.\n");
+  fprintf(stderr, "\t -s arg \t [0] Seed of the maze.\n");
+  fprintf(stderr,
+          "\t -b arg \t [0] Percentage of dead ends to open (0: perfect "
+          "maze).\n");
+  fprintf(stderr, "\t -p arg \t [1] Number of players (@).\n");
+  fprintf(stderr, "\t -m arg \t [1] Number of Minotaurs (&).\n");
+  fprintf(stderr, "\t -e arg \t [1] Number of exits (?).\n");
+  fprintf(stderr, "\t -o arg \t [stdout] File of the map.\n");
+  fprintf(stderr, "\t -h     \t Display this message.	\n");
+}
@@ -0,0 +1,206 @@
+/**
+ * @file dedalusReplay.c
+ * @brief Replay a recorded dedalus game (see Dedalus -r).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <getopt.h>   /* Getopt */
+#include <limits.h>   // INT_MAX
+#include <stdbool.h>  // bool, true, false
+#include <stdio.h>    // printf
+#include <stdlib.h>   // malloc, strtoul
+
+#include "ai.h"
+#include "ai/ai_random.h"
+#include "config.h"     // configuration
+#include "display.h"    // Wait user and info
+#include "game.h"       // game setting
+#include "map.h"        // manage the map
+#include "replayLog.h"  // recorded game
+
+/**
+ * @brief Options of the replay.
+ *
+ */
+typedef struct replay_options {
+  const char* replayFile;  ///< Path to the replay.
+  const char* mapFile;     ///< Path to the map (NULL for the recorded one).
+  int from;                ///< First step to display.
+  int to;                  ///< Last step to display.
+  int delay;               ///< Time (in us) between frames.
+  bool headless;           ///< No display, print a summary at the last step.
+} replay_options_t;
+
+/**
+ * @brief Parse parameters to build the options of the replay.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @param[out] pOptions The options (must be allocated).
+ */
+void read_parameters(int argc, char* argv[], replay_options_t* pOptions);
+
+/**
+ * @brief Display the program usage.
+ *
+ */
+void usage();
+
+/**
+ * @brief Main of DedalusReplay
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @return int DedalusReplay success.
+ */
+int main(int argc, char* argv[]) {
+  replay_options_t options;
+  options.replayFile = NULL;
+  options.mapFile = NULL;
+  options.from = 0;
+  options.to = INT_MAX;
+  options.delay = 100000;
+  options.headless = false;
+  read_parameters(argc, argv, &options);
+
+  replay_reader_t reader;
+  if (!replay_reader_load(&reader, options.replayFile)) {
+    display_fatal_error(stderr, "Invalid replay !\n");
+    return EXIT_FAILURE;
+  }
+  if (options.mapFile == NULL) {
+    options.mapFile = reader.mapName;
+  }
+
+  map_t map;
+  if (!map_reader(options.mapFile, &map)) {
+    replay_reader_delete(&reader);
+    display_fatal_error(stderr, "Invalid map !\n");
+    return EXIT_FAILURE;
+  }
+
+  // Same game as the recorded one (the AIs are never asked)
+  config_t config = config_init();
+  config.mapFile = options.mapFile;
+  config.delay = options.delay;
+  config.interactive = false;
+  config.thinking = false;
+  config.headless = options.headless;
+  config.maxMoves = reader.maxMoves;
+  config.seed = reader.seed;
+  game_t game;
+  if (!game_init(&game, &config, config.mapFile, &map, 100,
+                 ai_new(ai_random_get_name()), 10,
+                 ai_new(ai_random_get_name()))) {
+    map_delete(&map);
+    replay_reader_delete(&reader);
+    config_delete(&config);
+    display_fatal_error(stderr, "Wrong map (no player or no exit)!\n");
+    return EXIT_FAILURE;
+  }
+  if (!replay_reader_match(&reader, game.pMap, game.playerA, game.nbPlayer,
+                           game.minotaurA, game.nbMinotaur)) {
+    game_delete(&game);
+    replay_reader_delete(&reader);
+    config_delete(&config);
+    display_fatal_error(stderr, "The replay is not a game of this map!\n");
+    return EXIT_FAILURE;
+  }
+
+  game_replay(&game, &reader, options.from, options.to);
+  if (options.headless) {
+    game_summary(stdout, &game);
+  }
+
+  // Clear at the end
+  game_delete(&game);
+  replay_reader_delete(&reader);
+  config_delete(&config);
+
+  return EXIT_SUCCESS;
+}
+
+void read_parameters(int argc, char* argv[], replay_options_t* pOptions) {
+  /* Parameters parsing */
+  int c = 0;
+  int errflg = 0;
+  int mandatory = 0;
+  unsigned long tmp = 0;
+
+  while ((c = getopt(argc, argv, "hbd:f:m:r:t:")) != -1) {
+    switch (c) {
+      case 'h':  // help.
+        usage();
+        exit(EXIT_SUCCESS);
+        break;
+      case 'r':  // replay file.
+        pOptions->replayFile = optarg;
+        ++mandatory;
+        break;
+      case 'm':  // map file.
+        pOptions->mapFile = optarg;
+        break;
+      case 'f':  // first step.
+        tmp = strtoul(optarg, NULL, 0);
+        if (tmp > INT_MAX) {
+          ++errflg;
+        }
+        pOptions->from = (int)tmp;
+        break;
+      case 't':  // last step.
+        tmp = strtoul(optarg, NULL, 0);
+        if (tmp > INT_MAX) {
+          ++errflg;
+        }
+        pOptions->to = (int)tmp;
+        break;
+      case 'd':  // delay between frames.
+        tmp = strtoul(optarg, NULL, 0);
+        if (tmp > INT_MAX) {
+          ++errflg;
+        }
+        pOptions->delay = (int)tmp;
+        break;
+      case 'b':  // batch mode (headless).
+        pOptions->headless = true;
+        break;
+      case ':': /* option without operand */
+        fprintf(stderr, "Option -%c requires an operand\n", optopt);
+        ++errflg;
+        break;
+      case '?':
+        fprintf(stderr, "Unrecognized option: -%c\n", optopt);
+        ++errflg;
+    }
+  }
+  if (mandatory != 1) {
+    fprintf(stderr, "ERROR: mandatory option is missing (-r).\n");
+    ++errflg;
+  }
+
+  if (errflg) {
+    usage();
+    exit(EXIT_FAILURE);
+  }
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: ./DedalusReplay [-h] -r arg [-m arg] [-f arg] [-t arg] "
+          "[-d arg] [-b]\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Options: \n");
+  fprintf(stderr, "\t -r arg \t (Mandatory) file of the replay.\n");
+  fprintf(stderr, "\t -m arg \t [recorded] file of the map.\n");
+  fprintf(stderr, "\t -f arg \t [0] First step to display.\n");
+  fprintf(stderr, "\t -t arg \t [last] Last step to display.\n");
+  fprintf(stderr, "\t -d arg \t [100000] Delay (in μs).\n");
+  fprintf(stderr,
+          "\t -b     \t [false] Batch mode: no display, print a summary of "
+          "the last step.\n");
+  fprintf(stderr, "\t -h     \t Display this message.	\n");
+}
@@ -66,15 +66,10 @@ void _display_clear_map(FILE* stream, const map_t* pMap);
 /**
  * @brief Get the string associated to a wall.
  *
- * @param[in] pMap The map to consider.
- * @param[in] p The position of the wall to consider.
- * @param[in] pMask A mask to define what position should be print. NULL to
- * print everything.
+ * @param[in] code The wall code of the wall (see map_walls_init()).
  * @return const char* The string for the wall.
  */
-const char* _display_wall_to_string(const map_t* pMap,
-                                    const map_t* pMask,
-                                    const pos_t p);
+const char* _display_wall_to_string(unsigned code);
 
 /**
  * @brief Get the string for a path in the dedalus.
@@ -112,9 +107,9 @@ const char* _display_exit_to_string();
 const char* _display_minotaur_to_string();
 
 /**
- * @brief Display a map.
+ * @brief Set the cells of a frame from a map.
  *
- * @param[in,out] stream Where it should be printed.
+ * @param[in,out] pFrame The frame being composed.
  * @param[in] pMap The map to print.
  * @param[in] pMask A mask to define what position should be print. NULL to
  * print everything.
@@ -122,7 +117,9 @@ const char* _display_minotaur_to_string();
  * @note If a mask is provided, positions in the neighborhood of marked
  * positions are displayed.
  */
-void _display_map(FILE* stream, const map_t* pMap, const map_t* pMask);
+void _display_map(frame_t* pFrame,
+                  const map_t* pMap,
+                  const map_mask_t* pMask);
 
 /**
  * @brief Display the ariadne string.
@@ -187,6 +184,7 @@ void _display_ui_gm_header(FILE* stream,
  * @brief Display the GM UI body (the map).
  *
  * @param[in,out] stream Where it should be printed.
+ * @param[in,out] pFrame Frame of the view.
  * @param[in] pMap The map to display.
  * @param[in] nbPlayerAlive Number of players alive.
  * @param[in] nbPlayerOnBoard Number of player still on the board.
@@ -194,6 +192,7 @@ void _display_ui_gm_header(FILE* stream,
  * @param[in] refresh Should clear a previously printed body.
  */
 void _display_ui_gm_body(FILE* stream,
+                         frame_t* pFrame,
                          const map_t* pMap,
                          size_t nbPlayerAlive,
                          size_t nbPlayerOnBoard,
@@ -225,11 +224,13 @@ void _display_ui_player_header(FILE* stream,
  * @brief Display a player ui body (the map).
  *
  * @param[in,out] stream Where it should be printed.
+ * @param[in,out] pFrame Frame of the view.
  * @param[in] pMap Map to print.
  * @param[in] pPlayer Player considered.
  * @param[in] refresh If the body of the ui should be refresh.
  */
 void _display_ui_player_body(FILE* stream,
+                             frame_t* pFrame,
                              const map_t* pMap,
                              const character_t* pPlayer,
                              bool refresh);
@@ -316,51 +317,12 @@ void _display_clear_map(FILE* stream, const map_t* pMap) {
   }
 }
 
-const char* _display_wall_to_string(const map_t* pMap,
-                                    const map_t* pMask,
-                                    const pos_t p) {
-  bool wN = (p.y > 0) && (pMap->m[p.y - 1][p.x] == WALL) &&
-            ((pMask == NULL) || (pMask->m[p.y - 1][p.x] == DISPLAY_MASK));
-  bool wE = (p.x < (pMap->x - 1)) && (pMap->m[p.y][p.x + 1] == WALL) &&
-            ((pMask == NULL) || (pMask->m[p.y][p.x + 1] == DISPLAY_MASK));
-  bool wS = (p.y < (pMap->y - 1)) && (pMap->m[p.y + 1][p.x] == WALL) &&
-            ((pMask == NULL) || (pMask->m[p.y + 1][p.x] == DISPLAY_MASK));
-  bool wW = (p.x > 0) && (pMap->m[p.y][p.x - 1] == WALL) &&
-            ((pMask == NULL) || (pMask->m[p.y][p.x - 1] == DISPLAY_MASK));
-
-  if (wN && wS && wE && wW) {
-    return "╬";
-  } else if (wN && wS && wE) {
-    return "╠";
-  } else if (wN && wS && wW) {
-    return "╣";
-  } else if (wN && wE && wW) {
-    return "╩";
-  } else if (wS && wE && wW) {
-    return "╦";
-  } else if (wS && wE) {
-    return "╔";
-  } else if (wS && wW) {
-    return "╗";
-  } else if (wN && wE) {
-    return "╚";
-  } else if (wN && wW) {
-    return "╝";
-  } else if (wN && wS) {
-    return "║";
-  } else if (wE && wW) {
-    return "═";
-  } else if (wN) {
-    return "╨";
-  } else if (wS) {
-    return "╥";
-  } else if (wE) {
-    return "╞";
-  } else if (wW) {
-    return "╡";
-  } else {
-    return "╬";
-  }
+const char* _display_wall_to_string(unsigned code) {
+  // Indexed by the walls around: north (1), east (2), south (4) and west (8)
+  static const char* const glyphs[16] = {
+      "╬", "╨", "╞", "╚", "╥", "║", "╔", "╠",
+      "╡", "╝", "═", "╩", "╗", "╣", "╦", "╬"};
+  return glyphs[code & 15];
   // return WALL; // Simple version
 }
 
@@ -394,61 +356,61 @@ const char* _display_minotaur_to_string() {
   return "&";
 }
 
-void _display_map(FILE* stream, const map_t* pMap, const map_t* pMask) {
+void _display_map(frame_t* pFrame,
+                  const map_t* pMap,
+                  const map_mask_t* pMask) {
   for (size_t l = 0; l < pMap->y; ++l) {
+    const char* row = pMap->grid + l * pMap->stride;
     for (size_t c = 0; c < pMap->x; ++c) {
-      pos_t p;
-      p.y = l;
-      p.x = c;
-
-      bool display = (pMask == NULL) || (pMask->m[l][c] == DISPLAY_MASK);
+      bool display = (pMask == NULL) || map_mask_is_visible(pMask, c, l);
+      char raw[2] = {row[c], '\0'};
 
       if (display) {
         if (COLOR) {
-          switch (pMap->m[l][c]) {
+          switch (row[c]) {
             case WALL:
-              fprintf(stream, ANSI_COLOR_BLUE "%s" ANSI_COLOR_RESET,
-                      _display_wall_to_string(pMap, pMask, p));
+              // Walls of a view only join the walls displayed with them
+              frame_set(pFrame, c, l, ANSI_COLOR_BLUE,
+                        _display_wall_to_string(
+                            (pMask == NULL) ? map_wall_code(pMap, c, l)
+                                            : map_mask_wall_code(pMask, c, l)));
               break;
             case PATH:
-              fprintf(stream, ANSI_COLOR_YELLOW "%s" ANSI_COLOR_RESET,
-                      _display_path_to_string());
+              frame_set(pFrame, c, l, ANSI_COLOR_YELLOW,
+                        _display_path_to_string());
               break;
             case PLAYER:
-              fprintf(stream, ANSI_COLOR_RED "%s" ANSI_COLOR_RESET,
-                      _display_player_to_string());
+              frame_set(pFrame, c, l, ANSI_COLOR_RED,
+                        _display_player_to_string());
               break;
             case EXIT:
-              fprintf(stream, ANSI_COLOR_GREEN "%s" ANSI_COLOR_RESET,
-                      _display_exit_to_string());
+              frame_set(pFrame, c, l, ANSI_COLOR_GREEN,
+                        _display_exit_to_string());
               break;
             case MINOTAUR:
-              fprintf(stream, ANSI_COLOR_MAGENTA "%s" ANSI_COLOR_RESET,
-                      _display_minotaur_to_string());
+              frame_set(pFrame, c, l, ANSI_COLOR_MAGENTA,
+                        _display_minotaur_to_string());
               break;
             case DEAD:
-              fprintf(stream, "%s", _display_dead_to_string());
+              frame_set(pFrame, c, l, NULL, _display_dead_to_string());
               break;
             default:
-              fprintf(stream, "%c", pMap->m[l][c]);
+              frame_set(pFrame, c, l, NULL, raw);
           }
         } else {
-          fprintf(stream, "%c", pMap->m[l][c]);
+          frame_set(pFrame, c, l, NULL, raw);
         }
       } else {
-        fprintf(stream, " ");
+        frame_set(pFrame, c, l, NULL, " ");
       }
     }
-    fprintf(stream, "\n");
   }
 }
 
 void _display_string(FILE* stream, const string s) {
-  string tS = s;
   fprintf(stream, "%s", _display_player_to_string());
-  while (tS != NULL) {
-    fprintf(stream, "-%s", gps_compass_to_string(tS->c));
-    tS = tS->next;
+  for (size_t i = 0; i < string_size(s); ++i) {
+    fprintf(stream, "-%s", gps_compass_to_string(string_move(s, i)));
   }
 }
 
@@ -615,21 +577,26 @@ void _display_ui_gm_header(FILE* stream,
 }
 
 void _display_ui_gm_body(FILE* stream,
+                         frame_t* pFrame,
                          const map_t* pMap,
                          size_t nbPlayerAlive,
                          size_t nbPlayerOnBoard,
                          size_t nbMinotaurAlive,
                          bool refresh) {
+  // The whole body is composed in memory, then written at once
+  FILE* out = frame_begin(pFrame);
   if (refresh && !DEBUG) {
-    _display_move_up(stream, pMap->y + 3);
+    _display_move_up(out, pMap->y + 3);
   }
-  fprintf(stream, "Number of player alive:                   %lu.      \n",
+  fprintf(out, "Number of player alive:                   %lu.      \n",
           nbPlayerAlive);
-  fprintf(stream, "Number of player still in the dedalus:    %lu.      \n",
+  fprintf(out, "Number of player still in the dedalus:    %lu.      \n",
           nbPlayerOnBoard);
-  fprintf(stream, "Number of minotaurs still in the dedalus: %lu.      \n",
+  fprintf(out, "Number of minotaurs still in the dedalus: %lu.      \n",
           nbMinotaurAlive);
-  _display_map(stream, pMap, NULL);
+  _display_map(pFrame, pMap, NULL);
+  frame_draw(pFrame, !refresh || DEBUG);
+  frame_end(pFrame, stream);
 }
 
 void _display_ui_player_header(FILE* stream,
@@ -669,24 +636,29 @@ void _display_ui_player_header(FILE* stream,
 }
 
 void _display_ui_player_body(FILE* stream,
+                             frame_t* pFrame,
                              const map_t* pMap,
                              const character_t* pPlayer,
                              bool refresh) {
+  // The whole body is composed in memory, then written at once
+  FILE* out = frame_begin(pFrame);
   if (refresh && !DEBUG) {
     size_t offset = 2 + 2;
-    _display_move_up(stream, pMap->y + offset);
+    _display_move_up(out, pMap->y + offset);
   }
-  fprintf(stream, "Your target is (%s) at %.0f m                           \n",
+  fprintf(out, "Your target is (%s) at %.0f m                           \n",
           gps_compass_to_string(pPlayer->targetCompass),
           pPlayer->targetDistance);
-  _display_health(stream, pPlayer->health);
-  _display_map(stream, pMap, pPlayer->pMask);
+  _display_health(out, pPlayer->health);
+  _display_map(pFrame, pMap, pPlayer->pMask);
+  frame_draw(pFrame, !refresh || DEBUG);
   if (DEBUG) {
-    _display_string(stream, pPlayer->ariadne);
-    fprintf(stream, "\nAriadne' string size=%lu\n",
+    _display_string(out, pPlayer->ariadne);
+    fprintf(out, "\nAriadne' string size=%lu\n",
             string_size(pPlayer->ariadne));
   }
-  _display_player_ending(stream, pPlayer->ending);
+  _display_player_ending(out, pPlayer->ending);
+  frame_end(pFrame, stream);
 }
 
 void _display_player_ending(FILE* stream, ending_char_t ending) {
@@ -836,6 +808,7 @@ void _display_fight_ending(const character_t* pWinner,
 // Public functions implementations.
 
 void display_ui_gm(FILE* stream,
+                   frame_t* pFrame,
                    const char* level,
                    const map_t* pMap,
                    size_t nbPlayerAlive,
@@ -847,7 +820,7 @@ void display_ui_gm(FILE* stream,
   if (!refresh) {
     _display_ui_gm_header(stream, level, pMap, delay, gameInfo);
   }
-  _display_ui_gm_body(stream, pMap, nbPlayerAlive, nbPlayerOnBoard,
+  _display_ui_gm_body(stream, pFrame, pMap, nbPlayerAlive, nbPlayerOnBoard,
                       nbMinotaurAlive, refresh);
 }
 
@@ -855,16 +828,21 @@ void display_ui_player(const char* level,
                        const char* ia,
                        const map_t* pMap,
                        const character_t* pPlayer,
+                       frame_t* pFrame,
                        int delay,
                        int maxMoves,
                        bool gameInfo,
                        bool header,
                        bool refresh) {
+  if (pPlayer->pMask == NULL) {
+    // Nobody looks at this player
+    return;
+  }
   if (header) {
     _display_ui_player_header(pPlayer->stream, level, ia, pMap, pPlayer, delay,
                               maxMoves, gameInfo);
   }
-  _display_ui_player_body(pPlayer->stream, pMap, pPlayer, refresh);
+  _display_ui_player_body(pPlayer->stream, pFrame, pMap, pPlayer, refresh);
 }
 
 void display_ending(FILE* stream, ending_t ending) {
@@ -923,6 +901,28 @@ void display_ending(FILE* stream, ending_t ending) {
   }
 }
 
+const char* display_ending_name(ending_t ending) {
+  switch (ending) {
+    case EG_LOOSE:
+      return "loose";
+    case EG_NEXT_LEVEL_AND_ALIVE:
+      return "next_level_and_alive";
+    case EG_NEXT_LEVEL_BUT_DEAD:
+      return "next_level_but_dead";
+    case EG_WIN_AND_ALIVE:
+      return "win_and_alive";
+    case EG_KILL_MINOTAUR_BUT_DEAD:
+      return "kill_minotaur_but_dead";
+    case EG_WIN_BUT_DEAD:
+      return "win_but_dead";
+    case EG_GM_WIN:
+      return "gm_win";
+    case EG_GM_LOOSE:
+      return "gm_loose";
+  }
+  return "unknown";
+}
+
 void display_fight_iteration(const map_t* pMap,
                              const character_t* pC1,
                              const character_t* pC2,
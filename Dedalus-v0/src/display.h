@@ -16,6 +16,7 @@
 
 #include "character.h"
 #include "config.h"
+#include "frame.h"
 #include "map.h"
 
 /**
@@ -37,6 +38,7 @@ typedef enum ending {
  * @brief Display the game master interface.
  *
  * @param[in,out] stream Where it should be printed.
+ * @param[in,out] pFrame Frame of the game master view.
  * @param[in] level Name of the level.
  * @param[in] pMap Map to print.
  * @param[in] nbPlayerAlive Number of player still alive.
@@ -47,6 +49,7 @@ typedef enum ending {
  * @param[in] refresh If only the body of the ui should be refresh.
  */
 void display_ui_gm(FILE* stream,
+                   frame_t* pFrame,
                    const char* level,
                    const map_t* pMap,
                    size_t nbPlayerAlive,
@@ -63,18 +66,21 @@ void display_ui_gm(FILE* stream,
  * @param[in] ia IA name.
  * @param[in] pMap Map to print.
  * @param[in] pPlayer Player considered for the point of view.
+ * @param[in,out] pFrame Frame of the player view.
  * @param[in] delay Delay between two frames (for information only).
  * @param[in] maxMoves Max number of moved allowed.
  * @param[in] gameInfo Display more precise game informations.
  * @param[in] header If the header of the ui should be printed.
  * @param[in] refresh If the body of the ui should be refresh.
  *
- * @note The output stream is defined inside the player.
+ * @note The output stream is defined inside the player. Nothing is displayed
+ * for a player without a mask (no display).
  */
 void display_ui_player(const char* level,
                        const char* ia,
                        const map_t* pMap,
                        const character_t* pPlayer,
+                       frame_t* pFrame,
                        int delay,
                        int maxMoves,
                        bool gameInfo,
@@ -89,6 +95,14 @@ void display_ui_player(const char* level,
  */
 void display_ending(FILE* stream, ending_t ending);
 
+/**
+ * @brief Short name of an ending (for machine readable outputs).
+ *
+ * @param[in] ending The ending type.
+ * @return const char* The name of the ending.
+ */
+const char* display_ending_name(ending_t ending);
+
 /**
  * @brief Display on iteration of a fight.
  *
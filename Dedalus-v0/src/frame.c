@@ -0,0 +1,186 @@
+/**
+ * @file frame.c
+ * @brief Frame buffer of a map view, written with only the changed cells.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <errno.h>   // errno
+#include <string.h>  // memcmp, memset, strncpy
+#include <unistd.h>  // write
+
+#include "frame.h"
+
+/**
+ * @brief Back to the default color.
+ *
+ */
+#define FRAME_COLOR_RESET "\x1b[0m"
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Check if two cells look the same.
+ *
+ * @param[in] pA First cell.
+ * @param[in] pB Second cell.
+ * @return true Same color and glyph.
+ * @return false They differ.
+ */
+bool _frame_same_cell(const frame_cell_t* pA, const frame_cell_t* pB);
+
+/**
+ * @brief Print every cell, row after row.
+ *
+ * @param[in,out] pFrame The frame.
+ */
+void _frame_draw_full(frame_t* pFrame);
+
+/**
+ * @brief Print the cells that changed since the last frame on screen.
+ *
+ * @param[in,out] pFrame The frame.
+ */
+void _frame_draw_diff(frame_t* pFrame);
+
+/**********************************/
+//  Public functions implementation
+
+bool frame_init(frame_t* pFrame, size_t x, size_t y) {
+  pFrame->x = x;
+  pFrame->y = y;
+  pFrame->shown = false;
+  pFrame->outBuf = NULL;
+  pFrame->outSize = 0;
+  pFrame->cellA = (frame_cell_t*)calloc(x * y + 1, sizeof(frame_cell_t));
+  pFrame->shownA = (frame_cell_t*)calloc(x * y + 1, sizeof(frame_cell_t));
+  pFrame->out = open_memstream(&(pFrame->outBuf), &(pFrame->outSize));
+  return (pFrame->cellA != NULL) && (pFrame->shownA != NULL) &&
+         (pFrame->out != NULL);
+}
+
+void frame_delete(frame_t* pFrame) {
+  if (pFrame->out != NULL) {
+    fclose(pFrame->out);
+  }
+  free(pFrame->outBuf);
+  free(pFrame->cellA);
+  free(pFrame->shownA);
+  pFrame->out = NULL;
+  pFrame->outBuf = NULL;
+  pFrame->cellA = NULL;
+  pFrame->shownA = NULL;
+  pFrame->x = 0;
+  pFrame->y = 0;
+  pFrame->shown = false;
+}
+
+FILE* frame_begin(frame_t* pFrame) {
+  // The buffer of the memory stream is kept from one frame to the next
+  fseek(pFrame->out, 0, SEEK_SET);
+  return pFrame->out;
+}
+
+void frame_set(frame_t* pFrame,
+               size_t x,
+               size_t y,
+               const char* color,
+               const char* glyph) {
+  frame_cell_t* pCell = &(pFrame->cellA[y * pFrame->x + x]);
+  pCell->color = color;
+  memset(pCell->glyph, 0, sizeof(pCell->glyph));
+  strncpy(pCell->glyph, glyph, sizeof(pCell->glyph) - 1);
+}
+
+void frame_draw(frame_t* pFrame, bool full) {
+  if (full || !pFrame->shown) {
+    _frame_draw_full(pFrame);
+  } else {
+    _frame_draw_diff(pFrame);
+  }
+
+  // What was composed is now on screen
+  frame_cell_t* tmp = pFrame->shownA;
+  pFrame->shownA = pFrame->cellA;
+  pFrame->cellA = tmp;
+  pFrame->shown = true;
+}
+
+void frame_end(frame_t* pFrame, FILE* stream) {
+  fflush(pFrame->out);
+  long size = ftell(pFrame->out);
+  fflush(stream);
+
+  int fd = fileno(stream);
+  size_t done = 0;
+  while ((size > 0) && (done < (size_t)size)) {
+    ssize_t n = write(fd, pFrame->outBuf + done, (size_t)size - done);
+    if (n >= 0) {
+      done += (size_t)n;
+    } else if (errno != EINTR) {
+      // Nobody looks at this view anymore
+      break;
+    }
+  }
+}
+
+/**********************************/
+//  Local functions implementation
+
+bool _frame_same_cell(const frame_cell_t* pA, const frame_cell_t* pB) {
+  return (pA->color == pB->color) &&
+         (memcmp(pA->glyph, pB->glyph, sizeof(pA->glyph)) == 0);
+}
+
+void _frame_draw_full(frame_t* pFrame) {
+  for (size_t r = 0; r < pFrame->y; ++r) {
+    // Only print color escapes between cells of different colors
+    const char* color = NULL;
+    for (size_t c = 0; c < pFrame->x; ++c) {
+      const frame_cell_t* pCell = &(pFrame->cellA[r * pFrame->x + c]);
+      if (pCell->color != color) {
+        fputs((pCell->color == NULL) ? FRAME_COLOR_RESET : pCell->color,
+              pFrame->out);
+        color = pCell->color;
+      }
+      fputs(pCell->glyph, pFrame->out);
+    }
+    if (color != NULL) {
+      fputs(FRAME_COLOR_RESET, pFrame->out);
+    }
+    fputc('\n', pFrame->out);
+  }
+}
+
+void _frame_draw_diff(frame_t* pFrame) {
+  size_t row = 0;  // Row of the cursor
+  for (size_t r = 0; r < pFrame->y; ++r) {
+    for (size_t c = 0; c < pFrame->x; ++c) {
+      size_t i = r * pFrame->x + c;
+      const frame_cell_t* pCell = &(pFrame->cellA[i]);
+      if (!_frame_same_cell(pCell, &(pFrame->shownA[i]))) {
+        if (r > row) {
+          fprintf(pFrame->out, "\033[%zuB", r - row);  // Down
+          row = r;
+        }
+        fprintf(pFrame->out, "\033[%zuG", c + 1);  // Column
+        if (pCell->color != NULL) {
+          fprintf(pFrame->out, "%s%s" FRAME_COLOR_RESET, pCell->color,
+                  pCell->glyph);
+        } else {
+          fputs(pCell->glyph, pFrame->out);
+        }
+      }
+    }
+  }
+
+  // Start of the row after the map
+  if (pFrame->y > row) {
+    fprintf(pFrame->out, "\033[%zuB", pFrame->y - row);
+  }
+  fputc('\r', pFrame->out);
+}
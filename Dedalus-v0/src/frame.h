@@ -0,0 +1,104 @@
+/**
+ * @file frame.h
+ * @brief Frame buffer of a map view, written with only the changed cells.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief A cell of a frame.
+ *
+ */
+typedef struct frame_cell {
+  const char* color;  ///< Color escape of the cell (NULL for none).
+  char glyph[4];      ///< UTF-8 glyph of the cell (nul padded).
+} frame_cell_t;
+
+/**
+ * @brief Frame buffer of a view.
+ *
+ * A frame is composed in memory: text with frame_begin, the map cells with
+ * frame_set then frame_draw. frame_end sends the whole frame to the terminal
+ * in one write. Once a frame is on screen, frame_draw only emits the cells
+ * that changed since, with cursor moves.
+ */
+typedef struct frame {
+  frame_cell_t* cellA;   ///< Cells of the frame being composed.
+  frame_cell_t* shownA;  ///< Cells on screen.
+  size_t x;              ///< Number of columns.
+  size_t y;              ///< Number of rows.
+  bool shown;            ///< Are shownA really on screen?
+  FILE* out;             ///< Memory stream of the frame being composed.
+  char* outBuf;          ///< Buffer of the memory stream.
+  size_t outSize;        ///< Size of the memory stream buffer.
+} frame_t;
+
+/**
+ * @brief Initialize a frame.
+ *
+ * @param[out] pFrame The frame to initialize.
+ * @param[in] x Number of columns.
+ * @param[in] y Number of rows.
+ * @return true Initialization ok.
+ * @return false Internal error. Operation failed.
+ */
+bool frame_init(frame_t* pFrame, size_t x, size_t y);
+
+/**
+ * @brief Clear a frame.
+ *
+ * @param[in,out] pFrame The frame to clear.
+ */
+void frame_delete(frame_t* pFrame);
+
+/**
+ * @brief Start composing a new frame.
+ *
+ * @param[in,out] pFrame The frame.
+ * @return FILE* Where the text of the frame should be printed.
+ */
+FILE* frame_begin(frame_t* pFrame);
+
+/**
+ * @brief Set a cell of the frame being composed.
+ *
+ * @param[in,out] pFrame The frame.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @param[in] color Color escape (NULL for none). It must be a constant.
+ * @param[in] glyph The glyph (at most 3 bytes).
+ */
+void frame_set(frame_t* pFrame,
+               size_t x,
+               size_t y,
+               const char* color,
+               const char* glyph);
+
+/**
+ * @brief Add the cells to the frame being composed.
+ *
+ * @param[in,out] pFrame The frame.
+ * @param[in] full Draw every cell, even if the screen already shows it.
+ * @note The cursor must be at the start of the first row of the map, it ends
+ * at the start of the row after the map.
+ */
+void frame_draw(frame_t* pFrame, bool full);
+
+/**
+ * @brief Write the frame being composed.
+ *
+ * @param[in,out] pFrame The frame.
+ * @param[in,out] stream Where the frame should be written.
+ */
+void frame_end(frame_t* pFrame, FILE* stream);
+
+#endif  // End of FRAME_H
@@ -9,27 +9,19 @@
  *
  */
 
+#include <stdint.h>  // UINT64_MAX
 #include <stdio.h>   // printf
 #include <string.h>  // strcpy, strlen
 #include <unistd.h>  // usleep
 
-#include "display.h"  // outputs of the game
-#include "game.h"     // public defintions
-#include "gps.h"      // pos_t
+#include "display.h"     // outputs of the game
+#include "game.h"        // public defintions
+#include "gps.h"         // pos_t
+#include "moveSolver.h"  // conflicts of the moves
 
 /**********************************/
 // Declaration of local functions.
 
-/**
- * @brief Structure to store moves propositions.
- *
- */
-typedef struct moves_prop {
-  character_t* c;  ///< Pointer to the character concerned.
-  compass_t move;  ///< The move proposition
-  bool cheated;    ///< Is this a cheat move.
-} moves_prop_t;
-
 /**
  * @brief Initialize a moves propositions array.
  *
@@ -43,10 +35,12 @@ void _game_init_moves_prop(const game_t* pGame,
                            size_t* pNbChar);
 
 /**
- * @brief Get all moves propositions for each character.
+ * @brief Get all moves propositions for each character, with the backend of
+ * the game.
  *
- * @param[in] pGame The game considered.
- * @param[in,out] pMoves An initialized vector of propositions.
+ * @param[in,out] pGame The game considered.
+ * @param[in,out] pMoves An initialized vector of propositions (holds the
+ * moves played at the previous step).
  * @param[in] nbChar Number of character considered.
  * @note The array pMoves must be initialized before the call.
  */
@@ -54,22 +48,6 @@ void _game_get_moves_propositions(game_t* pGame,
                                   moves_prop_t* pMoves,
                                   size_t nbChar);
 
-/**
- * @brief Solve conflicts between an array of move propositions.
- *
- * @param[in] pGame The game considered.
- * @param[in,out] moves The array of moves propositions to clear.
- * @param[in] nbChar Number of character considered.
- *
- * The "moves" arrays will be cleaned to remove conflicts.
- * A conflict occurs when two characters want to go at the same position.
- * In this version only one character will move (players firsts and in order
- * of declaration after).
- */
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar);
-
 /**
  * @brief Set a character as dead for this game.
  *
@@ -110,6 +88,14 @@ bool _game_should_fight(const character_t* pC1, const character_t* pC2);
  */
 void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2);
 
+/**
+ * @brief Display again the view of a character after a fight.
+ *
+ * @param[in] pGame The game.
+ * @param[in] pC The character (nothing is displayed for a Minotaur).
+ */
+void _game_fight_refresh_ui(const game_t* pGame, const character_t* pC);
+
 /**
  * @brief Check and run all fights for a given character.
  *
@@ -125,6 +111,16 @@ void _game_fight_manager_char(game_t* pGame, character_t* pC);
  */
 void _game_fight_manager(game_t* pGame);
 
+/**
+ * @brief Position of the item closest to a position in an index.
+ *
+ * @param[in] pIdx The index to search in.
+ * @param[in] source Source position.
+ * @return pos_t Position of the closest item ((0, 0) if the index is empty,
+ * as gps_closest()).
+ */
+pos_t _game_closest(const spatial_index_t* pIdx, pos_t source);
+
 /**
  * @brief Define and set the target for a given character according to the board
  * configuration.
@@ -137,6 +133,34 @@ void _game_fight_manager(game_t* pGame);
  */
 pos_t _game_character_target(game_t* pGame, const character_t* pC);
 
+/**
+ * @brief Set the target direction and distance of a character.
+ *
+ * @param[in] pGame The game considered.
+ * @param[in, out] pC The character to guide.
+ * @note In maze-aware GPS mode, players follow the distance fields (true path
+ * to the target). Otherwise, or if no path exists, the compass points to the
+ * target.
+ */
+void _game_character_guide(game_t* pGame, character_t* pC);
+
+/**
+ * @brief Print the AIs that were out of time (nothing if none was).
+ *
+ * @param[in,out] stream Where to print.
+ * @param[in] pGame The game.
+ */
+void _game_report_overruns(FILE* stream, const game_t* pGame);
+
+/**
+ * @brief Guide again the players on board after the Minotaurs moved or died.
+ *
+ * @param[in,out] pGame The game considered.
+ * @note The players are played before the Minotaurs: without it, they would
+ * follow the distance field of the previous step.
+ */
+void _game_guide_players(game_t* pGame);
+
 /**
  * @brief Play a character move
  *
@@ -170,24 +194,61 @@ void _game_play_characters(game_t* pGame,
 void _game_play_refresh_ui(const game_t* pGame);
 
 /**
- * @brief Compute the end game status (win or loose) for the game master.
+ * @brief Turn on loop erasure for the Ariadne string of a character.
  *
- * @param[in] pGame The game considered.
- * @return ending_t An ending for the GM.
+ * @param[in] pMap The map.
+ * @param[in,out] pC The character (at its start position).
  */
-ending_t _game_ending_gm(const game_t* pGame);
+void _game_erase_loops_init(const map_t* pMap, character_t* pC);
 
 /**
- * @brief Compute the end game status (win or loose) for a player.
+ * @brief Record the moves of a step in a replay.
  *
- * @param[in] pGame The game considered.
- * @param[in] pC The player considered.
- * @return ending_t An ending for the player.
+ * @param[in,out] pW The replay.
+ * @param[in] moves The moves to play (conflicts solved).
+ * @param[in] nbChar Number of characters considered.
+ * @param[out] codeA Buffer for the codes of the moves (nbChar).
+ */
+void _game_record_step(replay_writer_t* pW,
+                       const moves_prop_t* moves,
+                       size_t nbChar,
+                       uint8_t* codeA);
+
+/**
+ * @brief Record the state of a game in a replay.
  *
- * Returns the global ending i.e. how successful was the player team
- * considering the player personal result.
+ * @param[in] pGame The game (after a step).
+ * @param[in,out] pW The replay.
+ */
+void _game_record_keyframe(const game_t* pGame, replay_writer_t* pW);
+
+/**
+ * @brief Play the next step of a replay.
+ *
+ * @param[in,out] pGame The game to change.
+ * @param[in] pReader The replay.
+ * @param[in,out] moves Moves propositions (see _game_init_moves_prop()).
+ * @param[in] nbChar Number of characters considered.
+ * @param[out] codeA Buffer for the codes of the moves (nbChar).
+ */
+void _game_replay_step(game_t* pGame,
+                       const replay_reader_t* pReader,
+                       moves_prop_t* moves,
+                       size_t nbChar,
+                       uint8_t* codeA);
+
+/**
+ * @brief Restore the state of a game from a keyframe of a replay.
+ *
+ * @param[in,out] pGame The game to change.
+ * @param[in] pReader The replay.
+ * @param[in] k Index of the keyframe.
+ * @param[in] initial Initial cells of the map (x * y, row-major).
  */
-ending_t _game_ending_player(const game_t* pGame, const character_t* pC);
+void _game_replay_restore(game_t* pGame,
+                          const replay_reader_t* pReader,
+                          size_t k,
+                          const char* initial);
 
 /*****************************/
 // Functions implementation.
@@ -207,12 +268,14 @@ void _game_init_moves_prop(const game_t* pGame,
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     (*pMoves)[i].c = &(pGame->playerA[i]);
     (*pMoves)[i].cheated = false;
+    (*pMoves)[i].overrun = false;
     (*pMoves)[i].move = Stay;
   }
   size_t offset = pGame->nbPlayer;
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
     (*pMoves)[i + offset].c = &(pGame->minotaurA[i]);
     (*pMoves)[i + offset].cheated = false;
+    (*pMoves)[i + offset].overrun = false;
     (*pMoves)[i + offset].move = Stay;
   }
 }
@@ -225,6 +288,10 @@ void _game_death_caractere(game_t* pGame, character_t* pC) {
       break;
     case MINOTAUR:
       pGame->nbMinotaurAlive--;
+      if (pGame->pMinotaurField != NULL) {
+        gps_field_remove_source(pGame->pMinotaurField, pC->pos);
+        _game_guide_players(pGame);
+      }
       break;
     default:
       display_fatal_error(DISPLAY, "Try to kill something strange\n");
@@ -258,13 +325,25 @@ bool _game_should_fight(const character_t* pC1, const character_t* pC2) {
 void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   size_t i = 0;
   while ((pC1->health > 0) && (pC2->health > 0)) {
-    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
-    usleep((unsigned int)pGame->delay);
+    if (!pGame->headless) {
+      if (i == 0) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+        // The introduction is an animation of its own
+        pacer_resume(&(pGame->pacer));
+      } else if (pacer_frame(&(pGame->pacer))) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+      }
+      pacer_wait(&(pGame->pacer));
+    }
     ++i;
     --(pC1->health);
     --(pC2->health);
   }
-  display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  if (!pGame->headless) {
+    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  }
 
   if (pC1->health <= 0) {
     _game_death_caractere(pGame, pC1);
@@ -273,41 +352,53 @@ void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   if (pC2->health <= 0) {
     _game_death_caractere(pGame, pC2);
   }
+  if (pGame->headless) {
+    return;
+  }
   display_wait_user(DISPLAY, "Press any key to continue...",
                     pGame->interactive);
+  pacer_resume(&(pGame->pacer));
 
   // refresh display
-  display_fight_clear(pC1->stream);
-  display_ui_player(pGame->gameName, pC1->ai.name, pGame->pMap, pC1,
-                    pGame->delay, pGame->maxMoves, pGame->gameInfo, false,
-                    false);
-  display_fight_clear(pC2->stream);
-  display_ui_player(pGame->gameName, pC2->ai.name, pGame->pMap, pC2,
-                    pGame->delay, pGame->maxMoves, pGame->gameInfo, false,
-                    false);
+  _game_fight_refresh_ui(pGame, pC1);
+  _game_fight_refresh_ui(pGame, pC2);
 
   _game_play_refresh_ui(pGame);
 }
 
+void _game_fight_refresh_ui(const game_t* pGame, const character_t* pC) {
+  display_fight_clear(pC->stream);
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    if (&(pGame->playerA[i]) == pC) {
+      display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
+                        &(pGame->frameA[i + 1]), pGame->delay,
+                        pGame->maxMoves, pGame->gameInfo, false, false);
+    }
+  }
+}
+
 void _game_fight_manager_char(game_t* pGame, character_t* pC) {
   character_t* pOpponents = NULL;
-  size_t nbOpponents = 0;
+  const spatial_index_t* pIdx = NULL;
   switch (pC->type) {
     case PLAYER:
       pOpponents = pGame->minotaurA;
-      nbOpponents = pGame->nbMinotaur;
+      pIdx = &(pGame->minotaurIdx);
       break;
     case MINOTAUR:
       pOpponents = pGame->playerA;
-      nbOpponents = pGame->nbPlayer;
+      pIdx = &(pGame->playerIdx);
       break;
     default:
-      break;
-      // No opponent
+      return;  // No opponent
   }
+  // Only opponents at the same or an adjacent position may fight, in order of
+  // declaration.
+  size_t nbOpponents = spatial_around(pIdx, pC->pos, pGame->aroundA);
   for (size_t i = 0; i < nbOpponents; ++i) {
-    if (_game_should_fight(pC, &(pOpponents[i]))) {
-      _game_fight(pGame, pC, &(pOpponents[i]));
+    character_t* pO = &(pOpponents[pGame->aroundA[i]]);
+    if (_game_should_fight(pC, pO)) {
+      _game_fight(pGame, pC, pO);
     }
   }
 }
@@ -324,20 +415,30 @@ void _game_fight_manager(game_t* pGame) {
   }
 }
 
+pos_t _game_closest(const spatial_index_t* pIdx, pos_t source) {
+  pos_t closest;
+  closest.x = 0;
+  closest.y = 0;
+  size_t i = spatial_closest(pIdx, source);
+  if (i != SPATIAL_NONE) {
+    closest = pIdx->pos[i];
+  }
+  return closest;
+}
+
 pos_t _game_character_target(game_t* pGame, const character_t* pC) {
   pos_t target;
 
   switch (pC->type) {
     case PLAYER:
       if ((pGame->finalLevel) && (pGame->nbMinotaurAlive > 0)) {
-        target =
-            gps_closest(pC->pos, pGame->minotaurA, pGame->nbMinotaur, MINOTAUR);
+        target = _game_closest(&(pGame->minotaurIdx), pC->pos);
       } else {
-        target = gps_closest(pC->pos, pGame->exitA, pGame->nbExit, EXIT);
+        target = _game_closest(&(pGame->exitIdx), pC->pos);
       }
       break;
     case MINOTAUR:
-      target = gps_closest(pC->pos, pGame->playerA, pGame->nbPlayer, PLAYER);
+      target = _game_closest(&(pGame->playerIdx), pC->pos);
       break;
     default:
       // No target
@@ -346,86 +447,35 @@ pos_t _game_character_target(game_t* pGame, const character_t* pC) {
   return target;
 }
 
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar) {
-  for (size_t i = 0; i < nbChar; ++i) {
-    character_t* pC = pMoves[i].c;
-    pMoves[i].move =
-        character_propose_move(pC, pGame->pMap, &(pMoves[i].cheated));
+void _game_character_guide(game_t* pGame, character_t* pC) {
+  const gps_field_t* pField = NULL;
+  if (pGame->mazeGps && (pC->type == PLAYER)) {
+    if ((pGame->finalLevel) && (pGame->nbMinotaurAlive > 0)) {
+      pField = pGame->pMinotaurField;
+    } else {
+      pField = pGame->pExitField;
+    }
+  }
+
+  if ((pField == NULL) || !gps_field_direction(pField, pC->pos,
+                                               &(pC->targetCompass),
+                                               &(pC->targetDistance))) {
+    gps_direction(pC->pos, _game_character_target(pGame, pC),
+                  &(pC->targetCompass), &(pC->targetDistance));
   }
 }
 
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar) {
-  (void)pGame;  // unused
+void _game_get_moves_propositions(game_t* pGame,
+                                  moves_prop_t* pMoves,
+                                  size_t nbChar) {
+  backend_propose(&(pGame->backend), pMoves, nbChar);
 
-  // Solve all conflicts
-  bool conflictFound = false;
-  do {
-    pos_t* usedPositions = NULL;
-    size_t nbPosUsed = 0;
-    // Fix position of staying char
+  // Random thinking (display only, never changes the game)
+  if (pGame->thinking && !pGame->headless) {
     for (size_t i = 0; i < nbChar; ++i) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      if ((moves[i].move == Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // reserve position. We are sure there is no conflict.
-        ++nbPosUsed;
-        usedPositions =
-            (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        usedPositions[nbPosUsed - 1] = pC->pos;
-      }
+      usleep((unsigned int)(rng_below(&(pGame->thinkRng), 100) * 1000));
     }
-
-    // Search conflict for others but stop at first conflict
-    // Just one conflict at a time in order to be sure that refusing a move for
-    // a character will not create another conflict.
-    conflictFound = false;
-    size_t i = 0;
-    while ((!conflictFound) && (i < nbChar)) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      // We only consider moving characters since those staying are already
-      // managed.
-      if ((moves[i].move != Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // Compute target position
-        pos_t nextPos = gps_compute_move(pC->pos, moves[i].move);
-
-        // Check if we have a conflict
-        size_t j = 0;
-        while ((!conflictFound) && (j < nbPosUsed)) {
-          conflictFound = ((usedPositions[j].x == nextPos.x) &&
-                           (usedPositions[j].y == nextPos.y));
-          ++j;
-        }
-        ++nbPosUsed;
-        usedPositions =
-            (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        if (conflictFound) {
-          moves[i].move = Stay;
-          usedPositions[nbPosUsed - 1] = pC->pos;
-        } else {
-          // Reserve the position
-          usedPositions[nbPosUsed - 1] = nextPos;
-        }
-      }
-      ++i;
-    }
-
-    free(usedPositions);
-  } while (conflictFound);
+  }
 }
 
 void _game_play_character(game_t* pGame,
@@ -444,9 +494,23 @@ void _game_play_character(game_t* pGame,
     }
   } else {
     // Move character
+    pos_t from = pC->pos;
     pos_t target = _game_character_target(pGame, pC);
     character_play(pC, move, target, pGame->pMap, pGame->steps, pGame->maxMoves,
                    &exited);
+    if (pC->type == PLAYER) {
+      spatial_move(&(pGame->playerIdx), (size_t)(pC - pGame->playerA),
+                   pC->pos);
+    } else if (pC->type == MINOTAUR) {
+      spatial_move(&(pGame->minotaurIdx), (size_t)(pC - pGame->minotaurA),
+                   pC->pos);
+      if (pGame->pMinotaurField != NULL) {
+        gps_field_move_source(pGame->pMinotaurField, from, pC->pos);
+      }
+    }
+    if (pGame->mazeGps) {
+      _game_character_guide(pGame, pC);
+    }
 
     if ((pC->type != DEAD) && (pC->health <= 0)) {
       // Deal with exhaustion
@@ -474,6 +538,31 @@ void _game_play_character(game_t* pGame,
   }
 }
 
+void _game_report_overruns(FILE* stream, const game_t* pGame) {
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+}
+
+void _game_guide_players(game_t* pGame) {
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    if (pGame->playerA[i].type == PLAYER) {
+      _game_character_guide(pGame, &(pGame->playerA[i]));
+    }
+  }
+}
+
 void _game_play_characters(game_t* pGame,
                            const moves_prop_t* moves,
                            size_t nbChar) {
@@ -481,32 +570,110 @@ void _game_play_characters(game_t* pGame,
   for (size_t i = 0; i < nbChar; ++i) {
     _game_play_character(pGame, moves[i].c, moves[i].move, moves[i].cheated);
   }
+  if (pGame->pMinotaurField != NULL) {
+    // The Minotaurs moved after the players were guided
+    _game_guide_players(pGame);
+  }
 }
 
 void _game_play_refresh_ui(const game_t* pGame) {
-  // Play all characters
+  if (pGame->headless) {
+    return;
+  }
 
   // Display current state for game master
-  display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
-                pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
-                pGame->gameInfo, true);
+  display_ui_gm(DISPLAY, &(pGame->frameA[0]), pGame->gameName, pGame->pMap,
+                pGame->nbPlayerAlive, pGame->nbPlayerOnBoard,
+                pGame->nbMinotaurAlive, pGame->delay, pGame->gameInfo, true);
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     const character_t* pC = &(pGame->playerA[i]);
     // Display for current player
     display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
-                      pGame->delay, pGame->maxMoves, pGame->gameInfo, false,
-                      true);
+                      &(pGame->frameA[i + 1]), pGame->delay, pGame->maxMoves,
+                      pGame->gameInfo, false, true);
+  }
+}
+
+void _game_erase_loops_init(const map_t* pMap, character_t* pC) {
+  if (!string_erase_loops_init(&(pC->ariadne),
+                               pC->pos.y * pMap->x + pC->pos.x)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+}
+
+void _game_record_step(replay_writer_t* pW,
+                       const moves_prop_t* moves,
+                       size_t nbChar,
+                       uint8_t* codeA) {
+  for (size_t i = 0; i < nbChar; ++i) {
+    codeA[i] = replay_code(moves[i].move, moves[i].cheated);
+  }
+  replay_writer_step(pW, codeA);
+}
+
+void _game_record_keyframe(const game_t* pGame, replay_writer_t* pW) {
+  if (!replay_writer_keyframe(pW, pGame->steps, pGame->pMap, pGame->playerA,
+                              pGame->minotaurA)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+}
+
+void _game_replay_step(game_t* pGame,
+                       const replay_reader_t* pReader,
+                       moves_prop_t* moves,
+                       size_t nbChar,
+                       uint8_t* codeA) {
+  // Same as a step of game_start, with the recorded moves
+  pGame->steps += 1;
+  _game_fight_manager(pGame);
+  replay_reader_step(pReader, pGame->steps, codeA);
+  for (size_t i = 0; i < nbChar; ++i) {
+    moves[i].move = replay_move(codeA[i], &(moves[i].cheated));
+  }
+  _game_play_characters(pGame, moves, nbChar);
+  if (!pGame->headless && pacer_frame(&(pGame->pacer))) {
+    _game_play_refresh_ui(pGame);
+  }
+  _game_fight_manager(pGame);
+}
+
+void _game_replay_restore(game_t* pGame,
+                          const replay_reader_t* pReader,
+                          size_t k,
+                          const char* initial) {
+  pGame->steps = replay_reader_keyframe(pReader, k, pGame->pMap, initial,
+                                        pGame->playerA, pGame->minotaurA);
+
+  // Counters and indexes follow the characters
+  pGame->nbPlayerAlive = 0;
+  pGame->nbPlayerOnBoard = 0;
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    pGame->nbPlayerAlive += (pC->type != DEAD) ? 1 : 0;
+    pGame->nbPlayerOnBoard += (pC->type == PLAYER) ? 1 : 0;
+    spatial_move(&(pGame->playerIdx), i, pC->pos);
+  }
+  pGame->nbMinotaurAlive = 0;
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    pGame->nbMinotaurAlive += (pC->type == MINOTAUR) ? 1 : 0;
+    spatial_move(&(pGame->minotaurIdx), i, pC->pos);
   }
 }
 
-ending_t _game_ending_gm(const game_t* pGame) {
+/**********************************/
+// Public functions implementations.
+
+ending_t game_ending_gm(const game_t* pGame) {
   if (pGame->nbPlayerAlive > 0) {
     return EG_GM_LOOSE;
   }
   return EG_GM_WIN;
 }
 
-ending_t _game_ending_player(const game_t* pGame, const character_t* pC) {
+ending_t game_ending_player(const game_t* pGame, const character_t* pC) {
   ending_t ending = EG_LOOSE;
   if (pC->type == EXIT) {
     if (pGame->finalLevel) {
@@ -526,9 +693,6 @@ ending_t _game_ending_player(const game_t* pGame, const character_t* pC) {
   return ending;
 }
 
-/**********************************/
-// Public functions implementations.
-
 bool game_init(game_t* pGame,
                config_t* pConf,
                const char* gameName,
@@ -543,10 +707,38 @@ bool game_init(game_t* pGame,
   pGame->gameInfo = pConf->gameInfo;
   pGame->steps = 0;
   pGame->delay = pConf->delay;
-  pGame->interactive = pConf->interactive;
+  pGame->interactive = pConf->interactive && !pConf->headless;
+  pGame->headless = pConf->headless;
+  pGame->thinking = pConf->thinking;
+  pGame->seed = pConf->seed;
+  pGame->replayFile = pConf->replayFile;
+  pGame->pProfiler = NULL;
+  budget_t budget;
+  budget.ms = pConf->moveTimeout;
+  budget.clock = pConf->moveClock;
+  backend_init(&(pGame->backend), pConf->backend, pConf->nbThreads, &budget,
+               pConf->overrun);
+  pacer_start(&(pGame->pacer), pGame->headless ? 0 : pGame->delay);
+  // One stream per generator: 2i for player i, 2i+1 for Minotaur i and the
+  // last one for thinking times.
+  rng_seed(&(pGame->thinkRng), pGame->seed, UINT64_MAX >> 1);
+  pGame->mazeGps = pConf->mazeGps;
+  pGame->pExitField = NULL;
+  pGame->pMinotaurField = NULL;
 
   bool ok = true;
 
+  // Passability layer for movement checks (kept up to date by map_set).
+  if (!map_passable_init(pMap)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  // Wall layer for the displays (built once, walls never change).
+  if (!pGame->headless && !map_walls_init(pMap)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+
   // Load exit(s)
   pGame->nbExit = gps_locator(pMap, EXIT, &(pGame->exitA));
   bool noExit = (pGame->nbExit == 0);
@@ -567,8 +759,10 @@ bool game_init(game_t* pGame,
     pGame->minotaurA[i] = character_init(MINOTAUR, (pid_t)(-i - 1), false,
                                          "Minotaur", mDefHealth, mAi);
     pGame->minotaurA[i].pos = mAPos[i];
-    pGame->minotaurA[i].pMask = map_mask_init(pMap);
-    map_mask_add(pGame->minotaurA[i].pMask, mAPos[i]);
+    rng_seed(&(pGame->minotaurA[i].rng), pGame->seed, 2 * i + 1);
+    if (pConf->eraseLoops) {
+      _game_erase_loops_init(pMap, &(pGame->minotaurA[i]));
+    }
 
     // NOTE: Targets are not set yet
   }
@@ -588,7 +782,7 @@ bool game_init(game_t* pGame,
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     // Get the display to use with this player.
     pid_t display = (pid_t)(-i - 1);
-    if (i < pConf->nbDisplay) {
+    if ((i < pConf->nbDisplay) && (!pConf->headless)) {
       display = pConf->displayPidA[i];
     }
 
@@ -596,8 +790,19 @@ bool game_init(game_t* pGame,
     pGame->playerA[i] =
         character_init(PLAYER, display, false, "Theseus", pDefHealth, pAi);
     pGame->playerA[i].pos = pAPos[i];
-    pGame->playerA[i].pMask = map_mask_init(pMap);
-    map_mask_add(pGame->playerA[i].pMask, pAPos[i]);
+    rng_seed(&(pGame->playerA[i].rng), pGame->seed, 2 * i);
+    if (pConf->eraseLoops) {
+      _game_erase_loops_init(pMap, &(pGame->playerA[i]));
+    }
+    if ((i < pConf->nbDisplay) && (!pConf->headless)) {
+      // Only a player with a display needs to know what it has seen
+      pGame->playerA[i].pMask = map_mask_init(pMap);
+      if (pGame->playerA[i].pMask == NULL) {
+        display_fatal_error(stderr, " Error: Failed to allocate a mask.\n");
+        exit(EXIT_FAILURE);
+      }
+      map_mask_add(pGame->playerA[i].pMask, pMap, pAPos[i]);
+    }
     // NOTE: Targets are not set yet
   }
   free(pAPos);
@@ -625,16 +830,101 @@ bool game_init(game_t* pGame,
     ok = false;
   }
 
+  // Spatial indexes for targets and fights.
+  pos_t* cPos = (pos_t*)malloc((pGame->nbPlayer + pGame->nbMinotaur + 1) *
+                               sizeof(pos_t));
+  pGame->aroundA = (size_t*)malloc((pGame->nbPlayer + pGame->nbMinotaur + 1) *
+                                   sizeof(size_t));
+  if ((cPos == NULL) || (pGame->aroundA == NULL) ||
+      !spatial_init(&(pGame->exitIdx), pMap, pGame->exitA, pGame->nbExit)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    cPos[i] = pGame->playerA[i].pos;
+  }
+  if (!spatial_init(&(pGame->playerIdx), pMap, cPos, pGame->nbPlayer)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    cPos[i] = pGame->minotaurA[i].pos;
+  }
+  if (!spatial_init(&(pGame->minotaurIdx), pMap, cPos, pGame->nbMinotaur)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  free(cPos);
+
+  // Timings of the steps, with a line per character in the report
+  if (pConf->profile) {
+    pGame->pProfiler = profiler_new(pGame->nbPlayer + pGame->nbMinotaur,
+                                    pConf->traceFile);
+    if (pGame->pProfiler == NULL) {
+      display_fatal_error(stderr, "Error: can not start the profiler!\n");
+      exit(EXIT_FAILURE);
+    }
+    char name[64];
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      snprintf(name, sizeof(name), "%s %zu (%s)", pGame->playerA[i].name, i,
+               pGame->playerA[i].ai.name);
+      profiler_policy_name(pGame->pProfiler, i, name);
+    }
+    for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+      snprintf(name, sizeof(name), "%s %zu (%s)", pGame->minotaurA[i].name, i,
+               pGame->minotaurA[i].ai.name);
+      profiler_policy_name(pGame->pProfiler, pGame->nbPlayer + i, name);
+    }
+  }
+
+  // Frame buffers of the views (game master first)
+  pGame->frameA = NULL;
+  if (!pGame->headless) {
+    pGame->frameA =
+        (frame_t*)malloc((pGame->nbPlayer + 1) * sizeof(frame_t));
+    bool framesOk = (pGame->frameA != NULL);
+    for (size_t i = 0; framesOk && (i < pGame->nbPlayer + 1); ++i) {
+      framesOk = frame_init(&(pGame->frameA[i]), pMap->x, pMap->y);
+    }
+    if (!framesOk) {
+      display_fatal_error(stderr, "Error: malloc failed!");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Maze-aware GPS: path distances to exits (static) and to Minotaurs
+  // (updated when they move or die).
+  if (ok && pGame->mazeGps) {
+    pGame->pExitField = (gps_field_t*)malloc(1 * sizeof(gps_field_t));
+    if ((pGame->pExitField == NULL) ||
+        !gps_field_init(pGame->pExitField, pMap, pGame->exitA, pGame->nbExit,
+                        false)) {
+      display_fatal_error(stderr, "Error: can not build the exit field!\n");
+      exit(EXIT_FAILURE);
+    }
+    if (pGame->finalLevel) {
+      pos_t* pMPos = (pos_t*)malloc(pGame->nbMinotaur * sizeof(pos_t));
+      for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+        pMPos[i] = pGame->minotaurA[i].pos;
+      }
+      pGame->pMinotaurField = (gps_field_t*)malloc(1 * sizeof(gps_field_t));
+      if ((pMPos == NULL) || (pGame->pMinotaurField == NULL) ||
+          !gps_field_init(pGame->pMinotaurField, pMap, pMPos,
+                          pGame->nbMinotaur, true)) {
+        display_fatal_error(stderr,
+                            "Error: can not build the Minotaur field!\n");
+        exit(EXIT_FAILURE);
+      }
+      free(pMPos);
+    }
+  }
+
   // Init targets
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    character_t* pC = &(pGame->playerA[i]);
-    gps_direction(pC->pos, _game_character_target(pGame, pC),
-                  &(pC->targetCompass), &(pC->targetDistance));
+    _game_character_guide(pGame, &(pGame->playerA[i]));
   }
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
-    character_t* pC = &(pGame->minotaurA[i]);
-    gps_direction(pC->pos, _game_character_target(pGame, pC),
-                  &(pC->targetCompass), &(pC->targetDistance));
+    _game_character_guide(pGame, &(pGame->minotaurA[i]));
   }
 
   return ok;
@@ -642,59 +932,217 @@ bool game_init(game_t* pGame,
 
 void game_start(game_t* pGame) {
   // Print UI
-
-  // Initial display for game master
-  display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
-                pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
-                pGame->gameInfo, false);
-
-  // Initial display for each player
-  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    const character_t* pC = &(pGame->playerA[i]);
-    display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
-                      pGame->delay, pGame->maxMoves, pGame->gameInfo, true,
-                      false);
+  if (!pGame->headless) {
+    // Initial display for game master
+    display_ui_gm(DISPLAY, &(pGame->frameA[0]), pGame->gameName,
+                  pGame->pMap, pGame->nbPlayerAlive, pGame->nbPlayerOnBoard,
+                  pGame->nbMinotaurAlive, pGame->delay, pGame->gameInfo,
+                  false);
+
+    // Initial display for each player
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      const character_t* pC = &(pGame->playerA[i]);
+      display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
+                        &(pGame->frameA[i + 1]), pGame->delay,
+                        pGame->maxMoves, pGame->gameInfo, true, false);
+    }
   }
 
   size_t nbChar = 0;
   moves_prop_t* moves = NULL;
   _game_init_moves_prop(pGame, &moves, &nbChar);
+  moves_solver_t solver;
+  solver_init(&solver, nbChar);
+
+  // Threads and workers are kept for the whole game
+  backend_start(&(pGame->backend), pGame->pMap, pGame->pProfiler, moves,
+                nbChar);
+
+  // Record the moves actually played, and the state from time to time
+  replay_writer_t replay;
+  uint8_t* codeA = NULL;
+  if (pGame->replayFile != NULL) {
+    if (!replay_writer_open(&replay, pGame->replayFile, pGame->gameName,
+                            pGame->pMap, pGame->seed, pGame->maxMoves,
+                            pGame->playerA, pGame->nbPlayer, pGame->minotaurA,
+                            pGame->nbMinotaur)) {
+      display_fatal_error(stderr, "Error: can not write the replay!\n");
+      exit(EXIT_FAILURE);
+    }
+    codeA = (uint8_t*)malloc((nbChar + 1) * sizeof(uint8_t));
+    if (codeA == NULL) {
+      display_fatal_error(stderr, "Error: malloc failed!");
+      exit(EXIT_FAILURE);
+    }
+    _game_record_keyframe(pGame, &replay);
+  }
 
+  profiler_t* pProf = pGame->pProfiler;
+  pacer_t* pPacer = &(pGame->pacer);
+  pacer_start(pPacer, pGame->headless ? 0 : pGame->delay);
   do {
     // Play characters
     pGame->steps += 1;
-    usleep((unsigned int)pGame->delay);
+    if (!pGame->headless) {
+      pacer_wait(pPacer);
+    }
+    uint64_t t = profiler_step_begin(pProf);
 
     // Fights
     _game_fight_manager(pGame);
+    t = profiler_lap(pProf, PROFILER_FIGHT_BEFORE, t);
 
     // Get characters move propositions
     _game_get_moves_propositions(pGame, moves, nbChar);
+    t = profiler_lap(pProf, PROFILER_PROPOSALS, t);
 
     // Solve confilcts
-    _gave_solve_moves_conflicts(pGame, moves, nbChar);
+    solver_solve(&solver, pGame->pMap, moves, nbChar);
+    t = profiler_lap(pProf, PROFILER_SOLVE, t);
+    if (codeA != NULL) {
+      _game_record_step(&replay, moves, nbChar, codeA);
+      t = profiler_lap(pProf, PROFILER_RECORD, t);
+    }
 
     // Play characters
     _game_play_characters(pGame, moves, nbChar);
+    t = profiler_lap(pProf, PROFILER_PLAY, t);
 
-    // refresh displays
-    _game_play_refresh_ui(pGame);
+    // refresh displays (not while the steps run late)
+    if (pacer_frame(pPacer)) {
+      _game_play_refresh_ui(pGame);
+    }
+    t = profiler_lap(pProf, PROFILER_UI, t);
 
     // Fights
     _game_fight_manager(pGame);
+    t = profiler_lap(pProf, PROFILER_FIGHT_AFTER, t);
 
+    if ((codeA != NULL) && (pGame->steps % REPLAY_KEYFRAME_INTERVAL == 0)) {
+      _game_record_keyframe(pGame, &replay);
+      t = profiler_lap(pProf, PROFILER_RECORD, t);
+    }
+    profiler_step_end(pProf, pGame->steps, t);
   } while (pGame->nbPlayerOnBoard > 0);
+  backend_stop(&(pGame->backend), nbChar);
+  if (!pGame->headless && (pPacer->skipRow > 0)) {
+    // The last frame was skipped, the final state is always shown
+    _game_play_refresh_ui(pGame);
+  }
 
+  if (codeA != NULL) {
+    free(codeA);
+    if (!replay_writer_close(&replay)) {
+      display_fatal_error(stderr, "Error: can not write the replay!\n");
+      exit(EXIT_FAILURE);
+    }
+  }
   free(moves);
+  solver_delete(&solver);
   nbChar = 0;
 
   // The end
+  if (!pGame->headless) {
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      const character_t* pC = &(pGame->playerA[i]);
+      // Last display for each player
+      display_ending(pGame->playerA[i].stream, game_ending_player(pGame, pC));
+    }
+    display_ending(DISPLAY, game_ending_gm(pGame));
+    _game_report_overruns(DISPLAY, pGame);
+    pacer_report(pPacer, stderr);
+  } else {
+    // Not in the summary: a replay does not know the overruns
+    _game_report_overruns(stderr, pGame);
+  }
+  profiler_report(pProf, stderr);
+}
+
+void game_replay(game_t* pGame,
+                 const replay_reader_t* pReader,
+                 int from,
+                 int to) {
+  size_t nbChar = 0;
+  moves_prop_t* moves = NULL;
+  _game_init_moves_prop(pGame, &moves, &nbChar);
+  const map_t* pMap = pGame->pMap;
+  uint8_t* codeA = (uint8_t*)malloc((nbChar + 1) * sizeof(uint8_t));
+  char* initial = (char*)malloc(pMap->x * pMap->y + 1);
+  if ((codeA == NULL) || (initial == NULL)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t l = 0; l < pMap->y; ++l) {
+    memcpy(initial + l * pMap->x, pMap->grid + l * pMap->stride, pMap->x);
+  }
+  if (to > pReader->nbSteps) {
+    to = pReader->nbSteps;
+  }
+  if (from > to) {
+    from = to;
+  }
+
+  // Jump to the keyframe before "from", then play up to it without display
+  size_t k = (size_t)from / pReader->interval;
+  if (k >= pReader->nbKey) {
+    k = pReader->nbKey - 1;
+  }
+  _game_replay_restore(pGame, pReader, k, initial);
+  bool headless = pGame->headless;
+  pGame->headless = true;
+  while (pGame->steps < from) {
+    _game_replay_step(pGame, pReader, moves, nbChar, codeA);
+  }
+  pGame->headless = headless;
+
+  if (!pGame->headless) {
+    display_ui_gm(DISPLAY, &(pGame->frameA[0]), pGame->gameName,
+                  pGame->pMap, pGame->nbPlayerAlive, pGame->nbPlayerOnBoard,
+                  pGame->nbMinotaurAlive, pGame->delay, pGame->gameInfo,
+                  false);
+  }
+  pacer_start(&(pGame->pacer), pGame->headless ? 0 : pGame->delay);
+  while (pGame->steps < to) {
+    if (!pGame->headless) {
+      pacer_wait(&(pGame->pacer));
+    }
+    _game_replay_step(pGame, pReader, moves, nbChar, codeA);
+  }
+  if (!pGame->headless && (pGame->pacer.skipRow > 0)) {
+    _game_play_refresh_ui(pGame);
+  }
+  if (!pGame->headless && (pGame->steps == pReader->nbSteps)) {
+    display_ending(DISPLAY, game_ending_gm(pGame));
+  }
+  if (!pGame->headless) {
+    pacer_report(&(pGame->pacer), stderr);
+  }
+
+  free(initial);
+  free(codeA);
+  free(moves);
+}
+
+void game_summary(FILE* stream, const game_t* pGame) {
+  size_t nbOut = 0;
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    if (pGame->playerA[i].type == EXIT) {
+      ++nbOut;
+    }
+  }
+  fprintf(stream,
+          "game map=%s seed=%lu steps=%d result=%s players=%zu alive=%zu "
+          "out=%zu minotaurs=%zu minotaursAlive=%zu\n",
+          pGame->gameName, pGame->seed, pGame->steps,
+          display_ending_name(game_ending_gm(pGame)), pGame->nbPlayer,
+          pGame->nbPlayerAlive, nbOut, pGame->nbMinotaur,
+          pGame->nbMinotaurAlive);
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     const character_t* pC = &(pGame->playerA[i]);
-    // Last display for each player
-    display_ending(pGame->playerA[i].stream, _game_ending_player(pGame, pC));
+    fprintf(stream, "player id=%zu ending=%s result=%s health=%.1f\n", i,
+            character_ending_name(pC->ending),
+            display_ending_name(game_ending_player(pGame, pC)), pC->health);
   }
-  display_ending(DISPLAY, _game_ending_gm(pGame));
 }
 
 void game_delete(game_t* pGame) {
@@ -704,6 +1152,30 @@ void game_delete(game_t* pGame) {
   pGame->exitA = NULL;
   pGame->nbExit = 0;
 
+  if (pGame->frameA != NULL) {
+    for (size_t i = 0; i < pGame->nbPlayer + 1; ++i) {
+      frame_delete(&(pGame->frameA[i]));
+    }
+    free(pGame->frameA);
+    pGame->frameA = NULL;
+  }
+
+  if (!pGame->headless) {
+    size_t nbMask = 0;
+    size_t maskSize = 0;
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      if (pGame->playerA[i].pMask != NULL) {
+        ++nbMask;
+        maskSize += map_mask_memory(pGame->playerA[i].pMask);
+      }
+    }
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer),
+             "Visibility masks: %zu of %zu characters, %zu bytes.\n", nbMask,
+             pGame->nbPlayer + pGame->nbMinotaur, maskSize);
+    display_info(DISPLAY, buffer);
+  }
+
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     character_delete(pGame->pMap, &(pGame->playerA[i]));
   }
@@ -721,10 +1193,31 @@ void game_delete(game_t* pGame) {
   pGame->nbMinotaur = 0;
   pGame->nbMinotaurAlive = 0;
 
+  spatial_delete(&(pGame->exitIdx));
+  spatial_delete(&(pGame->playerIdx));
+  spatial_delete(&(pGame->minotaurIdx));
+  free(pGame->aroundA);
+  pGame->aroundA = NULL;
+
+  if (pGame->pExitField != NULL) {
+    gps_field_delete(pGame->pExitField);
+    free(pGame->pExitField);
+    pGame->pExitField = NULL;
+  }
+  if (pGame->pMinotaurField != NULL) {
+    gps_field_delete(pGame->pMinotaurField);
+    free(pGame->pMinotaurField);
+    pGame->pMinotaurField = NULL;
+  }
+
+  profiler_delete(pGame->pProfiler);
+  pGame->pProfiler = NULL;
+
   pGame->finalLevel = false;
   pGame->maxMoves = 0;
   pGame->steps = 0;
   pGame->delay = 0;
+  pGame->headless = false;
 
   map_delete(pGame->pMap);
   pGame->pMap = NULL;
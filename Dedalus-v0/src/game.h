@@ -13,7 +13,14 @@
 
 #include "character.h"
 #include "config.h"
+#include "display.h"
+#include "frame.h"
 #include "map.h"
+#include "moveBackend.h"
+#include "pacer.h"
+#include "profiler.h"
+#include "replayLog.h"
+#include "spatialIndex.h"
 
 /**
  * @brief Default display stream for the Game Master.
@@ -42,8 +49,25 @@ typedef struct game {
   bool gameInfo;           ///< Display more precise game informations.
   int maxMoves;            ///< Maximum number of moves per player.
   int steps;               ///< Number of steps since the beginning of the game.
-  int delay;               ///< Delay (in us) between tow steps.
+  int delay;               ///< Time (in us) between the starts of two steps.
   bool interactive;        ///< Ask for interactive actions from GM.
+  bool mazeGps;            ///< Guide players with distance fields.
+  bool thinking;           ///< Simulate AIs thinking time (display only).
+  unsigned long seed;      ///< Seed of the random generators of the game.
+  rng_t thinkRng;          ///< Generator of thinking times (not of the AIs).
+  bool headless;           ///< No display nor delay (batch runs).
+  const char* replayFile;  ///< Where to record a replay (NULL for none).
+  moves_backend_t backend;  ///< How the AIs are asked for their moves.
+  profiler_t* pProfiler;   ///< Timings of the steps (NULL if not profiled).
+  pacer_t pacer;           ///< Pace of the steps and fights (if displayed).
+  gps_field_t* pExitField;      ///< Distance field to exits (or NULL).
+  gps_field_t* pMinotaurField;  ///< Distance field to Minotaurs (or NULL).
+  spatial_index_t exitIdx;      ///< Spatial index of exits.
+  spatial_index_t playerIdx;    ///< Spatial index of players.
+  spatial_index_t minotaurIdx;  ///< Spatial index of Minotaurs.
+  size_t* aroundA;  ///< Buffer for spatial_around() (nbPlayer + nbMinotaur).
+  frame_t* frameA;  ///< Frames of the views: game master, then each player
+                    ///< (NULL if headless).
 } game_t;
 
 /**
@@ -73,9 +97,60 @@ bool game_init(game_t* pGame,
  * @brief Run an initialised game.
  *
  * @param[in, out] pGame The game to start.
+ * @note If the game has a replay file, the game is recorded in it.
  */
 void game_start(game_t* pGame);
 
+/**
+ * @brief Replay some steps of a recorded game, without asking the AIs.
+ *
+ * @param[in, out] pGame The game, initialised as the recorded one and not
+ * started.
+ * @param[in] pReader The replay (see replay_reader_match()).
+ * @param[in] from Step to start from (the state after it is displayed first).
+ * @param[in] to Last step to display.
+ *
+ * The state at "from" is restored from the keyframe before it, then at most
+ * REPLAY_KEYFRAME_INTERVAL steps are played silently to reach it. Steps are
+ * then displayed at the speed of the game.
+ * @note The guidance of the characters (compass, distance fields) is not
+ * restored: it only feeds the AIs.
+ */
+void game_replay(game_t* pGame,
+                 const replay_reader_t* pReader,
+                 int from,
+                 int to);
+
+/**
+ * @brief Compute the end game status (win or loose) for the game master.
+ *
+ * @param[in] pGame The game considered.
+ * @return ending_t An ending for the GM.
+ */
+ending_t game_ending_gm(const game_t* pGame);
+
+/**
+ * @brief Compute the end game status (win or loose) for a player.
+ *
+ * @param[in] pGame The game considered.
+ * @param[in] pC The player considered.
+ * @return ending_t An ending for the player.
+ *
+ * Returns the global ending i.e. how successful was the player team
+ * considering the player personal result.
+ */
+ending_t game_ending_player(const game_t* pGame, const character_t* pC);
+
+/**
+ * @brief Print a compact summary of a finished game.
+ *
+ * @param[in,out] stream Where it should be printed.
+ * @param[in] pGame The finished game.
+ *
+ * One line for the game, then one line per player, as key=value fields.
+ */
+void game_summary(FILE* stream, const game_t* pGame);
+
 /**
  * @brief Clear all allocated content of a game.
  *
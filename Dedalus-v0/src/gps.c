@@ -32,6 +32,121 @@ static const char* const _gps_directions_txt[] = {
 static const char* const _gps_directions_arrows[] = {"↑", "↗", "→", "↘", "↓",
                                                      "↙", "←", "↖", "•"};
 
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Neighbours of a cell that are not walls.
+ *
+ * @param[in] pF The field.
+ * @param[in] c Index of the cell.
+ * @param[out] n Array of (at most 4) neighbours.
+ * @return size_t Number of neighbours.
+ */
+size_t _gps_field_neighbors(const gps_field_t* pF, uint32_t c, uint32_t n[4]);
+
+/**
+ * @brief Is a cell flagged?
+ *
+ * @param[in] pF The field.
+ * @param[in] c Index of the cell.
+ * @return true The flag is set.
+ * @return false The flag is not set.
+ */
+bool _gps_field_flagged(const gps_field_t* pF, uint32_t c);
+
+/**
+ * @brief Set or clear the flag of a cell.
+ *
+ * @param[in,out] pF The field.
+ * @param[in] c Index of the cell.
+ * @param[in] v New value of the flag.
+ */
+void _gps_field_flag(gps_field_t* pF, uint32_t c, bool v);
+
+/**
+ * @brief Push a cell in the relaxation queue if it is not already in.
+ *
+ * @param[in,out] pF The field.
+ * @param[in,out] pTail Tail of the queue.
+ * @param[in] c Index of the cell.
+ */
+void _gps_field_push(gps_field_t* pF, size_t* pTail, uint32_t c);
+
+/**
+ * @brief Propagate distances from the queued cells until stable.
+ *
+ * @param[in,out] pF The field.
+ * @param[in] head Head of the queue.
+ * @param[in] tail Tail of the queue.
+ *
+ * Each time a shorter distance is found, the cell is queued again. Only the
+ * cells whose distance decreases are visited.
+ */
+void _gps_field_relax(gps_field_t* pF, size_t head, size_t tail);
+
+/**********************************/
+//  Local functions implementation
+
+size_t _gps_field_neighbors(const gps_field_t* pF, uint32_t c, uint32_t n[4]) {
+  const map_t* pMap = pF->pMap;
+  size_t x = c % pMap->x;
+  size_t y = c / pMap->x;
+  size_t nb = 0;
+  if ((y > 0) && (map_get(pMap, x, y - 1) != WALL)) {
+    n[nb++] = c - (uint32_t)pMap->x;
+  }
+  if ((x + 1 < pMap->x) && (map_get(pMap, x + 1, y) != WALL)) {
+    n[nb++] = c + 1;
+  }
+  if ((y + 1 < pMap->y) && (map_get(pMap, x, y + 1) != WALL)) {
+    n[nb++] = c + (uint32_t)pMap->x;
+  }
+  if ((x > 0) && (map_get(pMap, x - 1, y) != WALL)) {
+    n[nb++] = c - 1;
+  }
+  return nb;
+}
+
+bool _gps_field_flagged(const gps_field_t* pF, uint32_t c) {
+  return ((pF->flags[c >> 6] >> (c & 63)) & 1) != 0;
+}
+
+void _gps_field_flag(gps_field_t* pF, uint32_t c, bool v) {
+  uint64_t bit = (uint64_t)1 << (c & 63);
+  if (v) {
+    pF->flags[c >> 6] |= bit;
+  } else {
+    pF->flags[c >> 6] &= ~bit;
+  }
+}
+
+void _gps_field_push(gps_field_t* pF, size_t* pTail, uint32_t c) {
+  if (!_gps_field_flagged(pF, c)) {
+    _gps_field_flag(pF, c, true);
+    pF->queue[*pTail % pF->nbCells] = c;
+    ++(*pTail);
+  }
+}
+
+void _gps_field_relax(gps_field_t* pF, size_t head, size_t tail) {
+  while (head != tail) {
+    uint32_t c = pF->queue[head % pF->nbCells];
+    ++head;
+    _gps_field_flag(pF, c, false);
+
+    uint32_t d = pF->dist[c] + 1;
+    uint32_t n[4];
+    size_t nb = _gps_field_neighbors(pF, c, n);
+    for (size_t i = 0; i < nb; ++i) {
+      if (pF->dist[n[i]] > d) {
+        pF->dist[n[i]] = d;
+        _gps_field_push(pF, &tail, n[i]);
+      }
+    }
+  }
+}
+
 /**********************************/
 // Public functions implementations.
 
@@ -41,8 +156,9 @@ size_t gps_locator(const map_t* pMap, map_content_t object, pos_t** pAPos) {
   *pAPos = NULL;
 
   for (size_t y = 0; y < pMap->y; ++y) {
+    const char* row = pMap->grid + y * pMap->stride;
     for (size_t x = 0; x < pMap->x; ++x) {
-      if (pMap->m[y][x] == (char)object) {
+      if (row[x] == (char)object) {
         if (nbFound == 0) {
           *pAPos = (pos_t*)malloc(1 * sizeof(pos_t));
         } else {
@@ -149,4 +265,174 @@ pos_t gps_compute_move(pos_t pos, compass_t move) {
       break;
   }
   return res;
-}
\ No newline at end of file
+}
+bool gps_field_init(gps_field_t* pF,
+                    const map_t* pMap,
+                    const pos_t* sources,
+                    size_t nbSources,
+                    bool dynamic) {
+  pF->pMap = pMap;
+  pF->nbCells = pMap->x * pMap->y;
+  pF->dist = NULL;
+  pF->queue = NULL;
+  pF->orphans = NULL;
+  pF->flags = NULL;
+  if ((pF->nbCells == 0) || (pF->nbCells >= GPS_FIELD_INF)) {
+    return false;
+  }
+
+  pF->dist = (uint32_t*)malloc(pF->nbCells * sizeof(uint32_t));
+  pF->queue = (uint32_t*)malloc(pF->nbCells * sizeof(uint32_t));
+  pF->flags = (uint64_t*)calloc((pF->nbCells + 63) / 64, sizeof(uint64_t));
+  if (dynamic) {
+    pF->orphans = (uint32_t*)malloc(pF->nbCells * sizeof(uint32_t));
+  }
+  if ((pF->dist == NULL) || (pF->queue == NULL) || (pF->flags == NULL) ||
+      (dynamic && (pF->orphans == NULL))) {
+    gps_field_delete(pF);
+    return false;
+  }
+
+  for (size_t i = 0; i < pF->nbCells; ++i) {
+    pF->dist[i] = GPS_FIELD_INF;
+  }
+  size_t tail = 0;
+  for (size_t i = 0; i < nbSources; ++i) {
+    uint32_t c = (uint32_t)(sources[i].y * pMap->x + sources[i].x);
+    pF->dist[c] = 0;
+    _gps_field_push(pF, &tail, c);
+  }
+  _gps_field_relax(pF, 0, tail);
+
+  if (!dynamic) {
+    // Working buffers are useless for a static field.
+    free(pF->queue);
+    pF->queue = NULL;
+    free(pF->flags);
+    pF->flags = NULL;
+  }
+  return true;
+}
+
+void gps_field_delete(gps_field_t* pF) {
+  free(pF->dist);
+  pF->dist = NULL;
+  free(pF->queue);
+  pF->queue = NULL;
+  free(pF->orphans);
+  pF->orphans = NULL;
+  free(pF->flags);
+  pF->flags = NULL;
+  pF->nbCells = 0;
+}
+
+void gps_field_add_source(gps_field_t* pF, pos_t p) {
+  uint32_t c = (uint32_t)(p.y * pF->pMap->x + p.x);
+  if (pF->dist[c] == 0) {
+    return;  // Already a source.
+  }
+  size_t tail = 0;
+  pF->dist[c] = 0;
+  _gps_field_push(pF, &tail, c);
+  _gps_field_relax(pF, 0, tail);
+}
+
+void gps_field_remove_source(gps_field_t* pF, pos_t p) {
+  uint32_t s = (uint32_t)(p.y * pF->pMap->x + p.x);
+  if (pF->dist[s] != 0) {
+    return;  // Not a source.
+  }
+
+  // 1. Find orphans (breadth-first, so a whole layer is flagged before the
+  // next one is checked): cells whose every shortest path goes through s.
+  size_t nbOrphans = 0;
+  pF->orphans[nbOrphans++] = s;
+  _gps_field_flag(pF, s, true);
+  for (size_t i = 0; i < nbOrphans; ++i) {
+    uint32_t c = pF->orphans[i];
+    uint32_t n[4];
+    size_t nb = _gps_field_neighbors(pF, c, n);
+    for (size_t j = 0; j < nb; ++j) {
+      uint32_t child = n[j];
+      if ((pF->dist[child] != pF->dist[c] + 1) ||
+          _gps_field_flagged(pF, child)) {
+        continue;
+      }
+      // Another parent still valid?
+      bool parent = false;
+      uint32_t m[4];
+      size_t nbM = _gps_field_neighbors(pF, child, m);
+      for (size_t k = 0; (k < nbM) && !parent; ++k) {
+        parent = (pF->dist[m[k]] == pF->dist[c]) &&
+                 !_gps_field_flagged(pF, m[k]);
+      }
+      if (!parent) {
+        _gps_field_flag(pF, child, true);
+        pF->orphans[nbOrphans++] = child;
+      }
+    }
+  }
+  for (size_t i = 0; i < nbOrphans; ++i) {
+    pF->dist[pF->orphans[i]] = GPS_FIELD_INF;
+    _gps_field_flag(pF, pF->orphans[i], false);
+  }
+
+  // 2. Orphans restart from their valid neighbours.
+  size_t tail = 0;
+  for (size_t i = 0; i < nbOrphans; ++i) {
+    uint32_t c = pF->orphans[i];
+    uint32_t n[4];
+    size_t nb = _gps_field_neighbors(pF, c, n);
+    for (size_t j = 0; j < nb; ++j) {
+      if ((pF->dist[n[j]] != GPS_FIELD_INF) &&
+          (pF->dist[n[j]] + 1 < pF->dist[c])) {
+        pF->dist[c] = pF->dist[n[j]] + 1;
+      }
+    }
+    if (pF->dist[c] != GPS_FIELD_INF) {
+      _gps_field_push(pF, &tail, c);
+    }
+  }
+  _gps_field_relax(pF, 0, tail);
+}
+
+void gps_field_move_source(gps_field_t* pF, pos_t from, pos_t to) {
+  if ((from.x == to.x) && (from.y == to.y)) {
+    return;
+  }
+  // Adding first keeps the removal local: the area is already reached by the
+  // new source.
+  gps_field_add_source(pF, to);
+  gps_field_remove_source(pF, from);
+}
+
+bool gps_field_direction(const gps_field_t* pF,
+                         pos_t source,
+                         compass_t* pC,
+                         float* pD) {
+  const map_t* pMap = pF->pMap;
+  uint32_t c = (uint32_t)(source.y * pMap->x + source.x);
+  uint32_t best = pF->dist[c];
+  if (best == GPS_FIELD_INF) {
+    return false;
+  }
+
+  *pC = Stay;
+  *pD = (float)best * 10;
+  if ((source.y > 0) && (pF->dist[c - pMap->x] < best)) {
+    best = pF->dist[c - pMap->x];
+    *pC = North;
+  }
+  if ((source.x + 1 < pMap->x) && (pF->dist[c + 1] < best)) {
+    best = pF->dist[c + 1];
+    *pC = East;
+  }
+  if ((source.y + 1 < pMap->y) && (pF->dist[c + pMap->x] < best)) {
+    best = pF->dist[c + pMap->x];
+    *pC = South;
+  }
+  if ((source.x > 0) && (pF->dist[c - 1] < best)) {
+    *pC = West;
+  }
+  return true;
+}
@@ -11,6 +11,8 @@
 #ifndef GPS_H
 #define GPS_H
 
+#include <stdint.h>
+
 #include "map.h"
 
 /**
@@ -31,6 +33,29 @@ typedef enum compass {
   Stay = 8
 } compass_t;
 
+/**
+ * @brief Distance of a cell that can not reach any source of a field.
+ *
+ */
+#define GPS_FIELD_INF UINT32_MAX
+
+/**
+ * @brief A distance field (flow field) over a map: for each cell, the length
+ * of the shortest path (in moves, walls excluded) to the closest source.
+ *
+ * A static field is computed once (exits for instance). A dynamic field keeps
+ * its working buffers to follow moving sources (Minotaurs for instance):
+ * only the cells whose distance changes are visited on each update.
+ */
+typedef struct gps_field {
+  const map_t* pMap;  ///< The map (only walls are considered).
+  uint32_t* dist;     ///< Distance of each cell (row-major, x per row).
+  uint32_t* queue;    ///< Ring buffer of cells to relax (dynamic only).
+  uint32_t* orphans;  ///< Cells to recompute on removal (dynamic only).
+  uint64_t* flags;    ///< One bit per cell "in queue" (dynamic only).
+  size_t nbCells;     ///< Number of cells in the map.
+} gps_field_t;
+
 /**
  * @brief Returns the number of objects of a given type in a map and their
  * position.
@@ -86,4 +111,69 @@ const char* gps_compass_to_string(compass_t c);
  */
 pos_t gps_compute_move(pos_t pos, compass_t move);
 
+/**
+ * @brief Compute a distance field from a set of sources (breadth-first).
+ *
+ * @param[out] pF The field to build.
+ * @param[in] pMap The map. Must outlive the field.
+ * @param[in] sources Array of the sources positions.
+ * @param[in] nbSources Number of sources.
+ * @param[in] dynamic Keep what is needed to move sources later?
+ * @return true The field is built.
+ * @return false Allocation failed or map too big.
+ */
+bool gps_field_init(gps_field_t* pF,
+                    const map_t* pMap,
+                    const pos_t* sources,
+                    size_t nbSources,
+                    bool dynamic);
+
+/**
+ * @brief Clear a distance field.
+ *
+ * @param[in,out] pF The field to clear.
+ */
+void gps_field_delete(gps_field_t* pF);
+
+/**
+ * @brief Add a source in a dynamic field.
+ *
+ * @param[in,out] pF The field to update.
+ * @param[in] p Position of the new source.
+ */
+void gps_field_add_source(gps_field_t* pF, pos_t p);
+
+/**
+ * @brief Remove a source from a dynamic field.
+ *
+ * @param[in,out] pF The field to update.
+ * @param[in] p Position of the removed source.
+ * @note Only the cells that were reached through this source are recomputed.
+ */
+void gps_field_remove_source(gps_field_t* pF, pos_t p);
+
+/**
+ * @brief Move a source of a dynamic field.
+ *
+ * @param[in,out] pF The field to update.
+ * @param[in] from Previous position of the source.
+ * @param[in] to New position of the source.
+ */
+void gps_field_move_source(gps_field_t* pF, pos_t from, pos_t to);
+
+/**
+ * @brief Return the best move and the path distance to the closest source.
+ *
+ * @param[in] pF The field.
+ * @param[in] source The position of the walker.
+ * @param[out] pC The first move of a shortest path (Stay on a source).
+ * @param[out] pD Length of the path (same unit as gps_direction()).
+ * @return true A source is reachable.
+ * @return false No path (outputs are left unchanged).
+ */
+bool gps_field_direction(const gps_field_t* pF,
+                         pos_t source,
+                         compass_t* pC,
+                         float* pD);
+
 #endif  // End GPS_H
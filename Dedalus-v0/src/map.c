@@ -9,9 +9,13 @@
  *
  */
 
-#include <stdio.h>   // printf
-#include <stdlib.h>  // malloc, rand, srand
-#include <string.h>  // strcpy, strlen
+#include <fcntl.h>     // open
+#include <stdio.h>     // printf
+#include <stdlib.h>    // malloc, rand, srand
+#include <string.h>    // memcpy, memset, strlen
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
 
 #include "config.h"
 #include "display.h"
@@ -37,6 +41,56 @@ size_t _map_decr_unsigned(size_t i);
  */
 size_t _map_incr_limit(size_t i, size_t limit);
 
+/**
+ * @brief Build the row view (m) of a map from its grid.
+ *
+ * @param[in,out] pMap The map with an allocated grid.
+ * @return true Row view built.
+ * @return false Allocation failed.
+ */
+bool _map_build_rows(map_t* pMap);
+
+/**
+ * @brief Is a character a separator between two rows in a map file?
+ *
+ * @param[in] c The character to test.
+ * @return true It is a blank (space, tabulation, new line...).
+ * @return false It is a map content.
+ */
+bool _map_is_blank(char c);
+
+/**
+ * @brief Compute the wall code of a cell.
+ *
+ * @param[in] pMap The map.
+ * @param[in] pMask A mask (only displayed walls count), NULL for none.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return uint8_t The map_around_t flags of the neighbours that are walls.
+ */
+uint8_t _map_wall_code(const map_t* pMap,
+                       const map_mask_t* pMask,
+                       size_t x,
+                       size_t y);
+
+/**
+ * @brief Set a run of three bits in a mask.
+ *
+ * @param[in,out] pMask The mask.
+ * @param[in] b Index of the first bit of the run.
+ * @return true At least one of the bits was not set.
+ * @return false The three bits were already set.
+ */
+bool _map_mask_set3(map_mask_t* pMask, size_t b);
+
+/**
+ * @brief Compute the whole wall layer of a mask.
+ *
+ * @param[in,out] pMask A mask with a wall layer.
+ * @param[in] pMap The map associated to the mask.
+ */
+void _map_mask_walls_build(map_mask_t* pMask, const map_t* pMap);
+
 /*****************************/
 // Functions implementation.
 
@@ -54,113 +108,372 @@ size_t _map_incr_limit(size_t i, size_t limit) {
   return limit;
 }
 
+bool _map_build_rows(map_t* pMap) {
+  pMap->m = (char**)malloc(pMap->y * sizeof(char*));
+  if (pMap->m == NULL) {
+    return false;
+  }
+  for (size_t l = 0; l < pMap->y; ++l) {
+    pMap->m[l] = pMap->grid + l * pMap->stride;
+  }
+  return true;
+}
+
+bool _map_is_blank(char c) {
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') ||
+         (c == '\v') || (c == '\f');
+}
+
+uint8_t _map_wall_code(const map_t* pMap,
+                       const map_mask_t* pMask,
+                       size_t x,
+                       size_t y) {
+  bool wN = (y > 0) && (map_get(pMap, x, y - 1) == WALL) &&
+            ((pMask == NULL) || map_mask_is_visible(pMask, x, y - 1));
+  bool wE = (x < pMap->x - 1) && (map_get(pMap, x + 1, y) == WALL) &&
+            ((pMask == NULL) || map_mask_is_visible(pMask, x + 1, y));
+  bool wS = (y < pMap->y - 1) && (map_get(pMap, x, y + 1) == WALL) &&
+            ((pMask == NULL) || map_mask_is_visible(pMask, x, y + 1));
+  bool wW = (x > 0) && (map_get(pMap, x - 1, y) == WALL) &&
+            ((pMask == NULL) || map_mask_is_visible(pMask, x - 1, y));
+  return (uint8_t)((wN ? AROUND_NORTH : 0) | (wE ? AROUND_EAST : 0) |
+                   (wS ? AROUND_SOUTH : 0) | (wW ? AROUND_WEST : 0));
+}
+
+bool _map_mask_set3(map_mask_t* pMask, size_t b) {
+  size_t w = b >> 6;
+  unsigned shift = (unsigned)(b & 63);
+  uint64_t lo = (uint64_t)7u << shift;
+  bool revealed = (pMask->bits[w] & lo) != lo;
+  pMask->bits[w] |= lo;
+  if (shift > 61) {
+    // The run ends in the next word
+    uint64_t hi = (uint64_t)7u >> (64 - shift);
+    revealed = revealed || ((pMask->bits[w + 1] & hi) != hi);
+    pMask->bits[w + 1] |= hi;
+  }
+  return revealed;
+}
+
+void _map_mask_walls_build(map_mask_t* pMask, const map_t* pMap) {
+  for (size_t l = 0; l < pMask->y; ++l) {
+    for (size_t c = 0; c < pMask->x; ++c) {
+      if (map_get(pMap, c, l) == WALL) {
+        pMask->walls[l * pMask->x + c] = _map_wall_code(pMap, pMask, c, l);
+      }
+    }
+  }
+}
+
 /**********************************/
 // Public functions implementations.
 
+bool map_init(map_t* pMap, size_t x, size_t y, char fill) {
+  pMap->pass = NULL;
+  pMap->passStride = 0;
+  pMap->walls = NULL;
+  pMap->x = x;
+  pMap->y = y;
+  pMap->stride = x + 1;
+  pMap->m = NULL;
+  pMap->grid = (char*)malloc(pMap->y * pMap->stride * sizeof(char));
+  if ((pMap->grid == NULL) || !_map_build_rows(pMap)) {
+    free(pMap->grid);
+    pMap->grid = NULL;
+    pMap->x = 0;
+    pMap->y = 0;
+    return false;
+  }
+  for (size_t l = 0; l < pMap->y; ++l) {
+    memset(pMap->m[l], fill, pMap->x);
+    pMap->m[l][pMap->x] = END_ROW;
+  }
+  return true;
+}
+
 void map_delete(map_t* pMap) {
   if ((pMap == NULL) || (pMap->y == 0)) {
     return;  // Nothing to do
   }
 
-  for (size_t l = 0; l < pMap->y; ++l) {
-    free(pMap->m[l]);
-    pMap->m[l] = NULL;
-  }
   free(pMap->m);
   pMap->m = NULL;
+  free(pMap->grid);
+  pMap->grid = NULL;
+  free(pMap->pass);
+  pMap->pass = NULL;
+  pMap->passStride = 0;
+  free(pMap->walls);
+  pMap->walls = NULL;
   pMap->x = 0;
   pMap->y = 0;
+  pMap->stride = 0;
+}
+
+bool map_passable_init(map_t* pMap) {
+  free(pMap->pass);
+  pMap->passStride = pMap->x + 2;
+  size_t nbBits = (pMap->y + 2) * pMap->passStride;
+  pMap->pass = (uint64_t*)calloc((nbBits + 63) / 64, sizeof(uint64_t));
+  if (pMap->pass == NULL) {
+    pMap->passStride = 0;
+    return false;
+  }
+
+  for (size_t l = 0; l < pMap->y; ++l) {
+    const char* row = pMap->grid + l * pMap->stride;
+    for (size_t c = 0; c < pMap->x; ++c) {
+      if (map_is_passable(row[c])) {
+        size_t b = map_pass_bit(pMap, c, l);
+        pMap->pass[b >> 6] |= (uint64_t)1 << (b & 63);
+      }
+    }
+  }
+  return true;
 }
 
-bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize) {
+bool map_walls_init(map_t* pMap) {
+  free(pMap->walls);
+  pMap->walls = (uint8_t*)calloc(pMap->x * pMap->y + 1, sizeof(uint8_t));
+  if (pMap->walls == NULL) {
+    return false;
+  }
+
+  for (size_t l = 0; l < pMap->y; ++l) {
+    for (size_t c = 0; c < pMap->x; ++c) {
+      if (map_get(pMap, c, l) == WALL) {
+        pMap->walls[l * pMap->x + c] = _map_wall_code(pMap, NULL, c, l);
+      }
+    }
+  }
+  return true;
+}
+
+bool map_copy(map_t* pDst, const map_t* pSrc) {
+  if (!map_init(pDst, pSrc->x, pSrc->y, END_ROW)) {
+    return false;
+  }
+  memcpy(pDst->grid, pSrc->grid, pSrc->y * pSrc->stride * sizeof(char));
+  return true;
+}
+
+bool map_reader(const char* filename, map_t* pMap) {
   pMap->m = NULL;  // init the map
+  pMap->grid = NULL;
+  pMap->pass = NULL;
+  pMap->passStride = 0;
+  pMap->walls = NULL;
   pMap->y = 0;
   pMap->x = 0;
+  pMap->stride = 0;
 
   // open the file
-  FILE* pf = fopen(filename, "r");
-  if (pf == NULL) {
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
     // Error
     fprintf(stderr, "No file found for map %s!\n", filename);
     return false;  // return error
   }
 
-  bool mapLoaded = true;  // everything is fine so far
-  char buffer[mapMaxXSize];
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+    fprintf(stderr, "Empty or unreadable map %s!\n", filename);
+    close(fd);
+    return false;
+  }
+  size_t size = (size_t)st.st_size;
 
-  if (fscanf(pf, "%s", buffer) == 0) {
-    mapLoaded = false;
-  } else {
-    pMap->x = strlen(buffer);
+  const char* data =
+      (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // The mapping keeps its own reference on the file.
+  if (data == MAP_FAILED) {
+    fprintf(stderr, "Unable to map %s in memory!\n", filename);
+    return false;
   }
-  size_t nbColumn = pMap->x + 1;
+  (void)madvise((void*)data, size, MADV_SEQUENTIAL);
 
-  while (mapLoaded && !feof(pf)) {
-    if (pMap->x == strlen(buffer)) {
-      pMap->y = pMap->y + 1;
-      pMap->m = (char**)realloc(pMap->m, pMap->y * sizeof(char*));
-      pMap->m[pMap->y - 1] = (char*)malloc(nbColumn * sizeof(char));
-      strncpy((pMap->m)[pMap->y - 1], buffer, nbColumn);
-      buffer[0] = '\0';  // flush the buffer
-      if ((pMap->m[pMap->y - 1][nbColumn - 1] != '\0') ||
-          (fscanf(pf, "%s", buffer) == 0)) {
+  // Single pass: a row is a run of non blank characters (as "%s" of scanf).
+  // The width is set by the first row, the grid is allocated at that time
+  // with an upper bound of the number of rows and every row is copied once.
+  bool mapLoaded = true;  // everything is fine so far
+  size_t line = 1;        // Current line in the file (for errors).
+  size_t lineStart = 0;   // Offset of the current line in the file.
+  size_t i = 0;
+  while (mapLoaded && (i < size)) {
+    if (_map_is_blank(data[i])) {
+      if (data[i] == '\n') {
+        ++line;
+        lineStart = i + 1;
+      }
+      ++i;
+      continue;
+    }
+
+    size_t start = i;
+    while ((i < size) && !_map_is_blank(data[i])) {
+      ++i;
+    }
+    size_t len = i - start;
+
+    if (pMap->grid == NULL) {
+      pMap->x = len;
+      pMap->stride = len + 1;
+      // Rows are separated by at least one blank.
+      size_t maxRows = (size - start + 1) / pMap->stride;
+      pMap->grid = (char*)malloc(maxRows * pMap->stride * sizeof(char));
+      if (pMap->grid == NULL) {
         fprintf(stderr, "Problem here: %s:%d\n", __FILE__, __LINE__);
         mapLoaded = false;
       }
-    } else {
-      fprintf(stderr, "Problem with buffer size (%lu, expect %lu) on line %lu here: %s:%d\n",
-              pMap->x, strlen(buffer), pMap->y +1, __FILE__, __LINE__);
+    } else if (len != pMap->x) {
+      // First column where the row differs from the expected width.
+      size_t column = start - lineStart + ((len < pMap->x) ? len : pMap->x) + 1;
+      fprintf(stderr,
+              "%s:%lu:%lu: row of %lu columns, expect %lu (row %lu of the "
+              "map)\n",
+              filename, line, column, len, pMap->x, pMap->y + 1);
       mapLoaded = false;
     }
-  }
-  // If buffer not empty
-  if (mapLoaded && (pMap->x == strlen(buffer))) {
-    pMap->y = pMap->y + 1;
-    pMap->m = (char**)realloc(pMap->m, pMap->y * sizeof(char*));
-    pMap->m[pMap->y - 1] = (char*)malloc(nbColumn * sizeof(char));
-    strncpy((pMap->m)[pMap->y - 1], buffer, nbColumn);
-    if (pMap->m[pMap->y - 1][nbColumn - 1] != '\0') {
-      fprintf(stderr, "Problem here: %s:%d\n", __FILE__, __LINE__);
-      mapLoaded = false;
+
+    if (mapLoaded) {
+      char* row = pMap->grid + pMap->y * pMap->stride;
+      memcpy(row, data + start, len);
+      row[len] = END_ROW;
+      pMap->y = pMap->y + 1;
     }
   }
 
-  fclose(pf);
+  munmap((void*)data, size);
+
+  if (mapLoaded && (pMap->y == 0)) {
+    fprintf(stderr, "Empty map %s!\n", filename);
+    mapLoaded = false;
+  }
+
+  if (mapLoaded && !_map_build_rows(pMap)) {
+    mapLoaded = false;
+  }
 
   // free map if fail
   if (!mapLoaded) {
+    free(pMap->grid);
+    pMap->grid = NULL;
     map_delete(pMap);
   }
 
   return mapLoaded;
 }
 
-map_t* map_mask_init(const map_t* pMap) {
-  map_t* pMask = (map_t*)malloc(1 * sizeof(map_t));
+bool map_view_init(map_t* pView, char* rows, size_t x, size_t y) {
+  pView->grid = rows;
+  pView->x = x;
+  pView->y = y;
+  pView->stride = x + 1;
+  pView->pass = NULL;
+  pView->passStride = 0;
+  pView->walls = NULL;
+  pView->m = (char**)malloc((y + 1) * sizeof(char*));
+  if (pView->m == NULL) {
+    return false;
+  }
+  for (size_t l = 0; l < y; ++l) {
+    pView->m[l] = pView->grid + l * pView->stride;
+  }
+  return true;
+}
+
+void map_view_delete(map_t* pView) {
+  free(pView->m);
+  pView->m = NULL;
+  pView->grid = NULL;
+  pView->x = 0;
+  pView->y = 0;
+  pView->stride = 0;
+}
+
+map_mask_t* map_mask_init(const map_t* pMap) {
+  map_mask_t* pMask = (map_mask_t*)malloc(1 * sizeof(map_mask_t));
+  if (pMask == NULL) {
+    return NULL;
+  }
   pMask->x = pMap->x;
   pMask->y = pMap->y;
-
-  pMask->m = (char**)malloc(pMask->y * sizeof(char*));
-  for (size_t i = 0; i < pMask->y; ++i) {
-    pMask->m[i] = (char*)calloc(pMask->x, sizeof(char));
+  pMask->stride = pMap->x + 2;
+  // One more word: a run of bits may end in the next word
+  pMask->nbWords = (pMask->stride * (pMap->y + 2) + 63) / 64 + 1;
+  pMask->bits = (uint64_t*)calloc(pMask->nbWords, sizeof(uint64_t));
+  pMask->walls = NULL;
+  if (pMap->walls != NULL) {
+    // Nothing is displayed yet, no wall is counted
+    pMask->walls = (uint8_t*)calloc(pMap->x * pMap->y + 1, sizeof(uint8_t));
+  }
+  if ((pMask->bits == NULL) ||
+      ((pMap->walls != NULL) && (pMask->walls == NULL))) {
+    map_mask_delete(pMask);
+    free(pMask);
+    return NULL;
   }
 
   return pMask;
 }
 
-void map_mask_add(map_t* pMask, pos_t p) {
-  pMask->m[p.y][p.x] = DISPLAY_MASK;
+void map_mask_delete(map_mask_t* pMask) {
+  if (pMask == NULL) {
+    return;
+  }
+  free(pMask->bits);
+  free(pMask->walls);
+  pMask->bits = NULL;
+  pMask->walls = NULL;
+  pMask->nbWords = 0;
+  pMask->stride = 0;
+  pMask->x = 0;
+  pMask->y = 0;
+}
 
-  pMask->m[_map_decr_unsigned(p.y)][p.x] = DISPLAY_MASK;
-  pMask->m[p.y][_map_decr_unsigned(p.x)] = DISPLAY_MASK;
-  pMask->m[_map_incr_limit(p.y, pMask->y - 1)][p.x] = DISPLAY_MASK;
-  pMask->m[p.y][_map_incr_limit(p.x, pMask->x - 1)] = DISPLAY_MASK;
+void map_mask_add(map_mask_t* pMask, const map_t* pMap, pos_t p) {
+  // With the border, the neighborhood starts at bit (p.y, p.x) of the mask
+  size_t b = p.y * pMask->stride + p.x;
+  bool revealed = _map_mask_set3(pMask, b);
+  revealed = _map_mask_set3(pMask, b + pMask->stride) || revealed;
+  revealed = _map_mask_set3(pMask, b + 2 * pMask->stride) || revealed;
+
+  if (revealed && (pMask->walls != NULL)) {
+    // Walls displayed and their neighbours may have new wall neighbours
+    size_t yN = _map_decr_unsigned(_map_decr_unsigned(p.y));
+    size_t yS = _map_incr_limit(_map_incr_limit(p.y, pMask->y - 1),
+                                pMask->y - 1);
+    size_t xW = _map_decr_unsigned(_map_decr_unsigned(p.x));
+    size_t xE = _map_incr_limit(_map_incr_limit(p.x, pMask->x - 1),
+                                pMask->x - 1);
+    for (size_t l = yN; l <= yS; ++l) {
+      for (size_t c = xW; c <= xE; ++c) {
+        if (map_get(pMap, c, l) == WALL) {
+          pMask->walls[l * pMask->x + c] = _map_wall_code(pMap, pMask, c, l);
+        }
+      }
+    }
+  }
+}
 
-  pMask->m[_map_decr_unsigned(p.y)][_map_decr_unsigned(p.x)] = DISPLAY_MASK;
-  pMask->m[_map_decr_unsigned(p.y)][_map_incr_limit(p.x, pMask->x - 1)] =
-      DISPLAY_MASK;
-  pMask->m[_map_incr_limit(p.y, pMask->y - 1)][_map_decr_unsigned(p.x)] =
-      DISPLAY_MASK;
-  pMask->m[_map_incr_limit(p.y, pMask->y - 1)]
-          [_map_incr_limit(p.x, pMask->x - 1)] = DISPLAY_MASK;
+void map_mask_union(map_mask_t* pDst,
+                    const map_mask_t* pSrc,
+                    const map_t* pMap) {
+  for (size_t w = 0; w < pDst->nbWords; ++w) {
+    pDst->bits[w] |= pSrc->bits[w];
+  }
+  if (pDst->walls != NULL) {
+    _map_mask_walls_build(pDst, pMap);
+  }
+}
+
+size_t map_mask_memory(const map_mask_t* pMask) {
+  if (pMask == NULL) {
+    return 0;
+  }
+  size_t size = sizeof(map_mask_t) + pMask->nbWords * sizeof(uint64_t);
+  if (pMask->walls != NULL) {
+    size += pMask->x * pMask->y + 1;
+  }
+  return size;
 }
@@ -12,6 +12,7 @@
 #define MAP_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /**
@@ -43,23 +44,211 @@ typedef enum map_content {
  *
  * @note The matrix contains char instead of map_content_t in order to be wild
  * enough to store all kind of characters.
+ *
+ * Cells are stored in a single row-major buffer ("grid"): the cell (x, y) is
+ * at grid[y * stride + x]. Each row is followed by an END_ROW so that rows are
+ * still valid C strings. The array "m" is a row view into "grid" kept for
+ * compatibility (m[y][x] is the same cell), prefer map_get() and map_set().
+ *
+ * A map may also own a passability layer (see map_passable_init()): one bit
+ * per cell, set if a character can walk on it. The layer has a border of
+ * unpassable cells so neighbours never need a bound check.
+ * It may also own a wall layer (see map_walls_init()): for each wall, the
+ * map_around_t flags of its neighbours that are walls too.
  */
 typedef struct map {
-  char** m;  ///< Matrix of caracters.
-  size_t x;  ///< Number of columns.
-  size_t y;  ///< Number of rows.
+  char** m;        ///< Row view into the grid (compatibility).
+  char* grid;      ///< Contiguous row-major matrix of caracters.
+  size_t x;        ///< Number of columns.
+  size_t y;        ///< Number of rows.
+  size_t stride;   ///< Number of chars between the start of two rows.
+  uint64_t* pass;  ///< Passability bits (with border), NULL if not built.
+  size_t passStride;  ///< Number of bits between two rows in "pass".
+  uint8_t* walls;     ///< Wall codes (one per cell), NULL if not built.
 } map_t;
 
+/**
+ * @brief Display mask of a map: the cells seen by a character.
+ *
+ * One bit per cell, with a border of hidden cells (as the passability layer
+ * of a map), so that a 3x3 neighbourhood is three runs of three bits. The
+ * mask may own a wall layer, like a map, that only counts the walls it
+ * displays.
+ */
+typedef struct map_mask {
+  uint64_t* bits;   ///< Visibility bits (with border).
+  size_t nbWords;   ///< Number of words in "bits".
+  size_t stride;    ///< Number of bits between two rows in "bits".
+  size_t x;         ///< Number of columns.
+  size_t y;         ///< Number of rows.
+  uint8_t* walls;   ///< Wall codes of the displayed walls, NULL if not built.
+} map_mask_t;
+
+/**
+ * @brief Bits returned by map_passable_around() (and of wall codes).
+ *
+ */
+typedef enum map_around {
+  AROUND_NORTH = 1,  ///< The north cell is passable.
+  AROUND_EAST = 2,   ///< The east cell is passable.
+  AROUND_SOUTH = 4,  ///< The south cell is passable.
+  AROUND_WEST = 8,   ///< The west cell is passable.
+} map_around_t;
+
+/**
+ * @brief Can a character walk on a content?
+ *
+ * @param[in] c The content of a cell.
+ * @return true Path, exit or dead body.
+ * @return false Anything else (wall, living character...).
+ */
+static inline bool map_is_passable(char c) {
+  return (c == PATH) || (c == EXIT) || (c == DEAD);
+}
+
+/**
+ * @brief Bit index of a cell in the passability layer.
+ *
+ * @param[in] pMap The map.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return size_t Index of the bit.
+ */
+static inline size_t map_pass_bit(const map_t* pMap, size_t x, size_t y) {
+  return (y + 1) * pMap->passStride + x + 1;
+}
+
+/**
+ * @brief Test a bit of the passability layer.
+ *
+ * @param[in] pMap The map.
+ * @param[in] bit Index of the bit.
+ * @return unsigned 1 if set, 0 else.
+ */
+static inline unsigned map_pass_test(const map_t* pMap, size_t bit) {
+  return (unsigned)(pMap->pass[bit >> 6] >> (bit & 63)) & 1u;
+}
+
+/**
+ * @brief Directions in which a character can walk from a position.
+ *
+ * @param[in] pMap A map with a passability layer.
+ * @param[in] p The position.
+ * @return unsigned A combination of map_around_t flags.
+ */
+static inline unsigned map_passable_around(const map_t* pMap, pos_t p) {
+  size_t b = map_pass_bit(pMap, p.x, p.y);
+  return map_pass_test(pMap, b - pMap->passStride) |
+         (map_pass_test(pMap, b + 1) << 1) |
+         (map_pass_test(pMap, b + pMap->passStride) << 2) |
+         (map_pass_test(pMap, b - 1) << 3);
+}
+
+/**
+ * @brief Get the content of a cell.
+ *
+ * @param[in] pMap The map.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return char The content of the cell.
+ * @warning No bound check.
+ */
+static inline char map_get(const map_t* pMap, size_t x, size_t y) {
+  return pMap->grid[y * pMap->stride + x];
+}
+
+/**
+ * @brief Set the content of a cell.
+ *
+ * @param[in,out] pMap The map.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @param[in] c The new content of the cell.
+ * @warning No bound check.
+ * @note The passability layer, if any, is kept up to date.
+ */
+static inline void map_set(map_t* pMap, size_t x, size_t y, char c) {
+  pMap->grid[y * pMap->stride + x] = c;
+  if (pMap->pass != NULL) {
+    size_t b = map_pass_bit(pMap, x, y);
+    uint64_t bit = (uint64_t)1 << (b & 63);
+    if (map_is_passable(c)) {
+      pMap->pass[b >> 6] |= bit;
+    } else {
+      pMap->pass[b >> 6] &= ~bit;
+    }
+  }
+}
+
+/**
+ * @brief Allocate the content of a map.
+ *
+ * @param[out] pMap The map to allocate.
+ * @param[in] x Number of columns.
+ * @param[in] y Number of rows.
+ * @param[in] fill Initial content of every cell.
+ * @return true Allocation succeed.
+ * @return false Allocation failed (the map is left empty).
+ */
+bool map_init(map_t* pMap, size_t x, size_t y, char fill);
+
+/**
+ * @brief Build the passability layer of a map from its content.
+ *
+ * @param[in,out] pMap The map.
+ * @return true Layer built.
+ * @return false Allocation failed (the map has no layer).
+ */
+bool map_passable_init(map_t* pMap);
+
+/**
+ * @brief Build the wall layer of a map from its content.
+ *
+ * @param[in,out] pMap The map.
+ * @return true Layer built.
+ * @return false Allocation failed (the map has no layer).
+ * @note Walls never change during a game, so the layer is built once.
+ */
+bool map_walls_init(map_t* pMap);
+
+/**
+ * @brief Wall code of a cell (see map_walls_init()).
+ *
+ * @param[in] pMap A map (or mask) with a wall layer.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return unsigned A combination of map_around_t flags.
+ * @warning No bound check.
+ */
+static inline unsigned map_wall_code(const map_t* pMap, size_t x, size_t y) {
+  return pMap->walls[y * pMap->x + x];
+}
+
+/**
+ * @brief Copy the content of a map in a new map.
+ *
+ * @param[out] pDst The map to allocate.
+ * @param[in] pSrc The map to copy.
+ * @return true Copy succeed.
+ * @return false Allocation failed (the map is left empty).
+ * @note The passability and wall layers are not copied.
+ */
+bool map_copy(map_t* pDst, const map_t* pSrc);
+
 /**
  * @brief Read a map from a file.
  *
  * @param[in] filename Path to the file that contains the map in a text format.
  * @param[out] pMap The loaded map if loading succeed, *NULL else).
- * @param[in] mapMaxXSize Maximum width of a board.
  * @return true Loading succeed.
  * @return false  Loading failed (wrong format or missing content)
+ *
+ * The file is mapped in memory and read in a single pass: rows are copied
+ * once in the grid of the map. There is no limit on the width of a map, all
+ * rows must have the same width (errors are reported with their line and
+ * column in the file).
  */
-bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize);
+bool map_reader(const char* filename, map_t* pMap);
 
 /**
  * @brief Clear the content of the map.
@@ -69,21 +258,106 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize);
  */
 void map_delete(map_t* pMap);
 
+/**
+ * @brief View rows of x + 1 chars (a copy of a map) as a read only map.
+ *
+ * @param[out] pView The view (the rows are its grid, they are not copied).
+ * @param[in] rows The rows, one after the other.
+ * @param[in] x Number of columns.
+ * @param[in] y Number of rows.
+ * @return true The view is ready (see map_view_delete()).
+ * @return false Out of memory.
+ * @note A view has no passability nor wall layer.
+ */
+bool map_view_init(map_t* pView, char* rows, size_t x, size_t y);
+
+/**
+ * @brief Clear a view (its rows are left as they are).
+ *
+ * @param[in,out] pView The view to clear.
+ */
+void map_view_delete(map_t* pView);
+
 /**
  * @brief Build an empty display mask from a map.
  *
  * @param[in] pMap The map associated to the mask to create.
- * @return map_t* An empty map mask (displays nothing).
+ * @return map_mask_t* An empty map mask (displays nothing), NULL if the
+ * allocation failed.
+ * @note The mask has a wall layer if the map has one.
  */
-map_t* map_mask_init(const map_t* pMap);
+map_mask_t* map_mask_init(const map_t* pMap);
+
+/**
+ * @brief Clear the content of a mask.
+ *
+ * @param[in,out] pMask Pointer to the mask to clear (may be NULL).
+ * @note The mask itself is not free, only its content.
+ */
+void map_mask_delete(map_mask_t* pMask);
+
+/**
+ * @brief Is a cell displayed by a mask?
+ *
+ * @param[in] pMask The mask.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return true The cell is displayed.
+ * @return false The cell is hidden.
+ * @warning No bound check.
+ */
+static inline bool map_mask_is_visible(const map_mask_t* pMask,
+                                       size_t x,
+                                       size_t y) {
+  size_t b = (y + 1) * pMask->stride + x + 1;
+  return ((pMask->bits[b >> 6] >> (b & 63)) & 1u) != 0;
+}
+
+/**
+ * @brief Wall code of a cell in a mask (see map_walls_init()).
+ *
+ * @param[in] pMask A mask with a wall layer.
+ * @param[in] x Column of the cell.
+ * @param[in] y Row of the cell.
+ * @return unsigned The map_around_t flags of the displayed wall neighbours.
+ * @warning No bound check.
+ */
+static inline unsigned map_mask_wall_code(const map_mask_t* pMask,
+                                          size_t x,
+                                          size_t y) {
+  return pMask->walls[y * pMask->x + x];
+}
 
 /**
  * @brief Add a position to display in a map mask.
  *
  * @param[in, out] pMask
+ * @param[in] pMap The map associated to the mask.
  * @param[in] p Position to add in the mask (i.e. to display).
- * @note Add the given position and the neighborhood.
+ * @note Add the given position and the neighborhood. The wall layer of the
+ * mask is updated around the position if new cells are displayed.
+ */
+void map_mask_add(map_mask_t* pMask, const map_t* pMap, pos_t p);
+
+/**
+ * @brief Display in a mask every cell displayed by an other one.
+ *
+ * @param[in, out] pDst The mask to extend (a team mask for instance).
+ * @param[in] pSrc The mask to add.
+ * @param[in] pMap The map associated to the masks.
+ * @note Both masks must come from the same map. The wall layer of pDst, if
+ * any, is rebuilt.
+ */
+void map_mask_union(map_mask_t* pDst,
+                    const map_mask_t* pSrc,
+                    const map_t* pMap);
+
+/**
+ * @brief Memory used by a mask.
+ *
+ * @param[in] pMask The mask (may be NULL).
+ * @return size_t Number of bytes allocated for the mask (0 for NULL).
  */
-void map_mask_add(map_t* pMask, pos_t p);
+size_t map_mask_memory(const map_mask_t* pMask);
 
 #endif  // End of MAP_H
@@ -0,0 +1,435 @@
+/**
+ * @file mazeGen.c
+ * @brief Seeded generator of mazes of any size.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <string.h>  // memcpy, memset
+
+#include "mazeGen.h"
+#include "rng.h"
+
+/**
+ * @brief No set (in the remapping of sets).
+ *
+ */
+#define MAZE_NO_SET ((size_t)-1)
+
+/**
+ * @brief State of a generation (one row of cells).
+ *
+ * The cells of the row belong to sets: two cells in the same set are already
+ * connected (by the rows above or by the current one). Sets are merged with a
+ * union-find and renumbered from 0 at each row, so set ids are always lower
+ * than the number of cells of a row.
+ */
+typedef struct maze_gen {
+  const maze_options_t* pOptions;  ///< The options.
+  rng_t rng;                       ///< Random generator.
+  size_t nbCol;                    ///< Number of cells in a row.
+  size_t nbRow;                    ///< Number of rows of cells.
+  size_t* setA;                    ///< Set of each cell.
+  size_t* parentA;                 ///< Union-find of the sets.
+  size_t* countA;                  ///< Number of cells of each set.
+  size_t* pickA;                   ///< Cell to open south in each set.
+  size_t* remapA;                  ///< New id of each set (next row).
+  uint8_t* northA;                 ///< Is each cell open to the north?
+  uint8_t* eastA;                  ///< Is each cell open to the east?
+  uint8_t* southA;                 ///< Is each cell open to the south?
+  uint8_t* hasSouthA;              ///< Is each set open to the south?
+  char* row;                       ///< Text of a row of the map.
+  uint64_t cellsLeft;              ///< Cells left to place entities on.
+  size_t entityA[3];               ///< Players, Minotaurs, exits to place.
+} maze_gen_t;
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Uniform random number below a 64 bits bound.
+ *
+ * @param[in,out] pRng The generator.
+ * @param[in] bound The bound (must not be 0).
+ * @return uint64_t A uniform number in [0, bound[.
+ */
+uint64_t _maze_below(rng_t* pRng, uint64_t bound);
+
+/**
+ * @brief Allocate the state of a generation.
+ *
+ * @param[out] pGen The state.
+ * @param[in] pOptions The options (checked).
+ * @return true Allocation succeed.
+ * @return false Allocation failed (nothing left allocated).
+ */
+bool _maze_gen_init(maze_gen_t* pGen, const maze_options_t* pOptions);
+
+/**
+ * @brief Free the state of a generation.
+ *
+ * @param[in,out] pGen The state.
+ */
+void _maze_gen_delete(maze_gen_t* pGen);
+
+/**
+ * @brief Root of a set.
+ *
+ * @param[in,out] pGen The state (paths are compressed).
+ * @param[in] s The set.
+ * @return size_t The id of the merged set.
+ */
+size_t _maze_find(maze_gen_t* pGen, size_t s);
+
+/**
+ * @brief Open the walls of a row of cells, then carry its sets to the next
+ * row.
+ *
+ * @param[in,out] pGen The state.
+ * @param[in] r Index of the row of cells.
+ */
+void _maze_carve_row(maze_gen_t* pGen, size_t r);
+
+/**
+ * @brief Open a wall of some dead ends of a row of cells.
+ *
+ * @param[in,out] pGen The state.
+ * @param[in] r Index of the row of cells.
+ * @note Walls to the north are never opened: the row above is written.
+ */
+void _maze_braid_row(maze_gen_t* pGen, size_t r);
+
+/**
+ * @brief Content of the next cell (a character, an exit or a path).
+ *
+ * @param[in,out] pGen The state.
+ * @return char The content of the cell.
+ */
+char _maze_next_cell(maze_gen_t* pGen);
+
+/**
+ * @brief Write a row of the map in a stream (see maze_row_fn_t).
+ *
+ * @param[in,out] pData The stream.
+ * @param[in] y Index of the row.
+ * @param[in] row Content of the row.
+ * @return true The row is written.
+ * @return false Write failed.
+ */
+bool _maze_write_row(void* pData, size_t y, const char* row);
+
+/**
+ * @brief Copy a row of the map in a map (see maze_row_fn_t).
+ *
+ * @param[in,out] pData The map.
+ * @param[in] y Index of the row.
+ * @param[in] row Content of the row.
+ * @return true Always.
+ */
+bool _maze_build_row(void* pData, size_t y, const char* row);
+
+/**********************************/
+//  Public functions implementation
+
+maze_options_t maze_options_init() {
+  maze_options_t options;
+  options.x = 31;
+  options.y = 21;
+  options.seed = 0;
+  options.braid = 0;
+  options.nbPlayer = 1;
+  options.nbMinotaur = 1;
+  options.nbExit = 1;
+  return options;
+}
+
+bool maze_options_check(const maze_options_t* pOptions) {
+  if ((pOptions->x < 3) || (pOptions->y < 3) || (pOptions->braid > 100)) {
+    return false;
+  }
+  uint64_t nbEntity = (uint64_t)pOptions->nbPlayer + pOptions->nbMinotaur +
+                      pOptions->nbExit;
+  return nbEntity <= maze_cells(pOptions);
+}
+
+uint64_t maze_cells(const maze_options_t* pOptions) {
+  return (uint64_t)((pOptions->x - 1) / 2) * ((pOptions->y - 1) / 2);
+}
+
+bool maze_generate(const maze_options_t* pOptions,
+                   maze_row_fn_t fn,
+                   void* pData) {
+  if (!maze_options_check(pOptions)) {
+    return false;
+  }
+  maze_gen_t gen;
+  if (!_maze_gen_init(&gen, pOptions)) {
+    return false;
+  }
+
+  // Top border
+  memset(gen.row, WALL, pOptions->x);
+  bool done = fn(pData, 0, gen.row);
+
+  size_t y = 1;
+  for (size_t r = 0; done && (r < gen.nbRow); ++r) {
+    _maze_carve_row(&gen, r);
+
+    // Row of cells and of the walls between them
+    memset(gen.row, WALL, pOptions->x);
+    for (size_t c = 0; c < gen.nbCol; ++c) {
+      gen.row[2 * c + 1] = _maze_next_cell(&gen);
+      if (gen.eastA[c]) {
+        gen.row[2 * c + 2] = PATH;
+      }
+    }
+    done = fn(pData, y++, gen.row);
+
+    // Row of the walls below the cells
+    memset(gen.row, WALL, pOptions->x);
+    for (size_t c = 0; c < gen.nbCol; ++c) {
+      if (gen.southA[c]) {
+        gen.row[2 * c + 1] = PATH;
+      }
+    }
+    done = done && fn(pData, y++, gen.row);
+
+    memcpy(gen.northA, gen.southA, gen.nbCol);
+  }
+
+  // An even number of rows ends with one more wall
+  memset(gen.row, WALL, pOptions->x);
+  while (done && (y < pOptions->y)) {
+    done = fn(pData, y++, gen.row);
+  }
+
+  _maze_gen_delete(&gen);
+  return done;
+}
+
+bool maze_write(const maze_options_t* pOptions, FILE* stream) {
+  bool written = maze_generate(pOptions, &_maze_write_row, stream);
+  return written && (fflush(stream) == 0);
+}
+
+bool maze_build(const maze_options_t* pOptions, map_t* pMap) {
+  if (!maze_options_check(pOptions) ||
+      !map_init(pMap, pOptions->x, pOptions->y, WALL)) {
+    pMap->m = NULL;
+    pMap->grid = NULL;
+    pMap->x = 0;
+    pMap->y = 0;
+    return false;
+  }
+  if (!maze_generate(pOptions, &_maze_build_row, pMap)) {
+    map_delete(pMap);
+    return false;
+  }
+  return true;
+}
+
+/**********************************/
+//  Local functions implementation
+
+uint64_t _maze_below(rng_t* pRng, uint64_t bound) {
+  if (bound <= UINT32_MAX) {
+    return rng_below(pRng, (uint32_t)bound);
+  }
+  // Reject the low values that would make the modulo biased
+  uint64_t threshold = (uint64_t)(-bound) % bound;
+  uint64_t r = 0;
+  do {
+    r = ((uint64_t)rng_next(pRng) << 32) | rng_next(pRng);
+  } while (r < threshold);
+  return r % bound;
+}
+
+bool _maze_gen_init(maze_gen_t* pGen, const maze_options_t* pOptions) {
+  pGen->pOptions = pOptions;
+  rng_seed(&(pGen->rng), pOptions->seed, 0);
+  pGen->nbCol = (pOptions->x - 1) / 2;
+  pGen->nbRow = (pOptions->y - 1) / 2;
+  pGen->cellsLeft = maze_cells(pOptions);
+  pGen->entityA[0] = pOptions->nbPlayer;
+  pGen->entityA[1] = pOptions->nbMinotaur;
+  pGen->entityA[2] = pOptions->nbExit;
+
+  size_t n = pGen->nbCol;
+  pGen->setA = (size_t*)malloc(5 * n * sizeof(size_t));
+  pGen->northA = (uint8_t*)calloc(4 * n, sizeof(uint8_t));
+  pGen->row = (char*)malloc((pOptions->x + 1) * sizeof(char));
+  if ((pGen->setA == NULL) || (pGen->northA == NULL) || (pGen->row == NULL)) {
+    _maze_gen_delete(pGen);
+    return false;
+  }
+  pGen->parentA = pGen->setA + n;
+  pGen->countA = pGen->setA + 2 * n;
+  pGen->pickA = pGen->setA + 3 * n;
+  pGen->remapA = pGen->setA + 4 * n;
+  pGen->eastA = pGen->northA + n;
+  pGen->southA = pGen->northA + 2 * n;
+  pGen->hasSouthA = pGen->northA + 3 * n;
+  pGen->row[pOptions->x] = END_ROW;
+
+  // Each cell of the first row is alone
+  for (size_t c = 0; c < n; ++c) {
+    pGen->setA[c] = c;
+    pGen->countA[c] = 0;
+    pGen->remapA[c] = MAZE_NO_SET;
+  }
+  return true;
+}
+
+void _maze_gen_delete(maze_gen_t* pGen) {
+  free(pGen->setA);
+  free(pGen->northA);
+  free(pGen->row);
+  pGen->setA = NULL;
+  pGen->northA = NULL;
+  pGen->row = NULL;
+}
+
+size_t _maze_find(maze_gen_t* pGen, size_t s) {
+  while (pGen->parentA[s] != s) {
+    pGen->parentA[s] = pGen->parentA[pGen->parentA[s]];  // Path halving
+    s = pGen->parentA[s];
+  }
+  return s;
+}
+
+void _maze_carve_row(maze_gen_t* pGen, size_t r) {
+  size_t n = pGen->nbCol;
+  bool last = (r + 1 == pGen->nbRow);
+  for (size_t c = 0; c < n; ++c) {
+    pGen->parentA[c] = c;
+  }
+
+  // Join neighbours of different sets (all of them on the last row)
+  for (size_t c = 0; c + 1 < n; ++c) {
+    size_t a = _maze_find(pGen, pGen->setA[c]);
+    size_t b = _maze_find(pGen, pGen->setA[c + 1]);
+    pGen->eastA[c] = (a != b) && (last || (rng_next(&(pGen->rng)) & 1u));
+    if (pGen->eastA[c]) {
+      pGen->parentA[b] = a;
+    }
+  }
+  pGen->eastA[n - 1] = 0;
+
+  // Open south at random, at least once per set
+  memset(pGen->southA, 0, n);
+  if (!last) {
+    for (size_t c = 0; c < n; ++c) {
+      size_t s = _maze_find(pGen, pGen->setA[c]);
+      if (pGen->countA[s] == 0) {
+        pGen->hasSouthA[s] = 0;
+      }
+      ++(pGen->countA[s]);
+      if (rng_below(&(pGen->rng), (uint32_t)pGen->countA[s]) == 0) {
+        pGen->pickA[s] = c;  // Uniform choice among the cells of the set
+      }
+      pGen->southA[c] = (uint8_t)(rng_next(&(pGen->rng)) & 1u);
+      pGen->hasSouthA[s] |= pGen->southA[c];
+    }
+    for (size_t c = 0; c < n; ++c) {
+      size_t s = _maze_find(pGen, pGen->setA[c]);
+      if (pGen->countA[s] != 0) {
+        if (!pGen->hasSouthA[s]) {
+          pGen->southA[pGen->pickA[s]] = 1;
+        }
+        pGen->countA[s] = 0;
+      }
+    }
+  }
+
+  if (pGen->pOptions->braid > 0) {
+    _maze_braid_row(pGen, r);
+  }
+
+  // Sets of the next row: cells open to the north keep their set, the
+  // others are alone
+  size_t next = 0;
+  for (size_t c = 0; c < n; ++c) {
+    if (pGen->southA[c]) {
+      size_t s = _maze_find(pGen, pGen->setA[c]);
+      if (pGen->remapA[s] == MAZE_NO_SET) {
+        pGen->remapA[s] = next++;
+      }
+      pGen->pickA[c] = s;  // No pick left: keep the root of each cell
+    }
+  }
+  for (size_t c = 0; c < n; ++c) {
+    if (pGen->southA[c]) {
+      pGen->setA[c] = pGen->remapA[pGen->pickA[c]];
+    } else {
+      pGen->setA[c] = next++;
+    }
+  }
+  for (size_t c = 0; c < n; ++c) {
+    pGen->remapA[c] = MAZE_NO_SET;
+  }
+}
+
+void _maze_braid_row(maze_gen_t* pGen, size_t r) {
+  size_t n = pGen->nbCol;
+  bool last = (r + 1 == pGen->nbRow);
+  for (size_t c = 0; c < n; ++c) {
+    bool west = (c > 0) && pGen->eastA[c - 1];
+    unsigned degree =
+        (unsigned)pGen->northA[c] + pGen->eastA[c] + pGen->southA[c] + west;
+    if ((degree != 1) ||
+        (rng_below(&(pGen->rng), 100) >= pGen->pOptions->braid)) {
+      continue;
+    }
+
+    // Walls that can be opened: west, east, south
+    uint8_t* wallA[3];
+    uint32_t nbWall = 0;
+    if ((c > 0) && !west) {
+      wallA[nbWall++] = &(pGen->eastA[c - 1]);
+    }
+    if ((c + 1 < n) && !pGen->eastA[c]) {
+      wallA[nbWall++] = &(pGen->eastA[c]);
+    }
+    if (!last && !pGen->southA[c]) {
+      wallA[nbWall++] = &(pGen->southA[c]);
+    }
+    if (nbWall > 0) {
+      *(wallA[rng_below(&(pGen->rng), nbWall)]) = 1;
+    }
+  }
+}
+
+char _maze_next_cell(maze_gen_t* pGen) {
+  // Selection sampling: each cell has the same chance to get an entity
+  size_t* e = pGen->entityA;
+  uint64_t needed = (uint64_t)e[0] + e[1] + e[2];
+  uint64_t pick = _maze_below(&(pGen->rng), pGen->cellsLeft--);
+  if (pick >= needed) {
+    return PATH;
+  }
+  if (pick < e[0]) {
+    --e[0];
+    return PLAYER;
+  }
+  if (pick < e[0] + e[1]) {
+    --e[1];
+    return MINOTAUR;
+  }
+  --e[2];
+  return EXIT;
+}
+
+bool _maze_write_row(void* pData, size_t y, const char* row) {
+  (void)y;
+  FILE* stream = (FILE*)pData;
+  return (fputs(row, stream) >= 0) && (fputc('\n', stream) != EOF);
+}
+
+bool _maze_build_row(void* pData, size_t y, const char* row) {
+  map_t* pMap = (map_t*)pData;
+  memcpy(pMap->grid + y * pMap->stride, row, pMap->x);
+  return true;
+}
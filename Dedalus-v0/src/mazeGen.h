@@ -0,0 +1,113 @@
+/**
+ * @file mazeGen.h
+ * @brief Seeded generator of mazes of any size.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Mazes are built row after row with Eller's algorithm: only the current row
+ * of cells is kept in memory, so a maze can be written to a file while it is
+ * generated, whatever its size. Cells are at odd coordinates, walls between
+ * them. A perfect maze has exactly one path between two cells; a braided one
+ * has some of its dead ends opened, which makes loops.
+ *
+ * Players, Minotaurs and exits are spread uniformly on the cells.
+ */
+#ifndef MAZE_GEN_H
+#define MAZE_GEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "map.h"
+
+/**
+ * @brief Options of a maze.
+ *
+ */
+typedef struct maze_options {
+  size_t x;           ///< Number of columns of the map (at least 3).
+  size_t y;           ///< Number of rows of the map (at least 3).
+  uint64_t seed;      ///< Seed of the maze.
+  unsigned braid;     ///< Percentage of dead ends opened (0: perfect maze).
+  size_t nbPlayer;    ///< Number of players.
+  size_t nbMinotaur;  ///< Number of Minotaurs.
+  size_t nbExit;      ///< Number of exits.
+} maze_options_t;
+
+/**
+ * @brief Receive a row of a maze.
+ *
+ * @param[in,out] pData Data given to maze_generate().
+ * @param[in] y Index of the row.
+ * @param[in] row Content of the row (x chars, not terminated).
+ * @return true Continue.
+ * @return false Stop the generation (an error occurred).
+ */
+typedef bool (*maze_row_fn_t)(void* pData, size_t y, const char* row);
+
+/**
+ * @brief Default options: a small perfect maze with one player, one Minotaur
+ * and one exit.
+ *
+ * @return maze_options_t The options.
+ */
+maze_options_t maze_options_init();
+
+/**
+ * @brief Check options.
+ *
+ * @param[in] pOptions The options.
+ * @return true A maze can be built.
+ * @return false The map is too small or there are too many characters and
+ * exits for its cells.
+ */
+bool maze_options_check(const maze_options_t* pOptions);
+
+/**
+ * @brief Number of cells (not walls) of a maze.
+ *
+ * @param[in] pOptions The options.
+ * @return uint64_t Number of places for characters and exits.
+ */
+uint64_t maze_cells(const maze_options_t* pOptions);
+
+/**
+ * @brief Generate a maze row after row.
+ *
+ * @param[in] pOptions The options (see maze_options_check()).
+ * @param[in] fn Called with each row, from the first to the last.
+ * @param[in,out] pData Given to fn.
+ * @return true The whole maze was generated.
+ * @return false Invalid options, allocation failed or fn stopped.
+ * @note Memory is linear in the number of columns only.
+ */
+bool maze_generate(const maze_options_t* pOptions,
+                   maze_row_fn_t fn,
+                   void* pData);
+
+/**
+ * @brief Write a maze in the text format of map_reader().
+ *
+ * @param[in] pOptions The options.
+ * @param[in,out] stream Where to write.
+ * @return true The maze is written.
+ * @return false Invalid options, allocation or write failed.
+ */
+bool maze_write(const maze_options_t* pOptions, FILE* stream);
+
+/**
+ * @brief Build a maze in memory.
+ *
+ * @param[in] pOptions The options.
+ * @param[out] pMap The map to allocate (as with map_reader()).
+ * @return true The map is built.
+ * @return false Invalid options or allocation failed (the map is left
+ * empty).
+ */
+bool maze_build(const maze_options_t* pOptions, map_t* pMap);
+
+#endif  // End of MAZE_GEN_H
@@ -0,0 +1,581 @@
+/**
+ * @file replayLog.c
+ * @brief Compact binary log of a game, to replay it without the AIs.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <string.h>  // memcpy, memcmp, memset, strlen
+
+#include "replayLog.h"
+
+/**
+ * @brief Magic number at the start of a replay (with the version).
+ *
+ */
+#define REPLAY_MAGIC "DDRP\001"
+
+/**
+ * @brief Size of the magic number.
+ *
+ */
+#define REPLAY_MAGIC_SIZE 5
+
+/**
+ * @brief Tag of a keyframe.
+ *
+ */
+#define REPLAY_TAG_KEYFRAME 'K'
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Write a varint.
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] v The value.
+ */
+void _replay_put_varint(FILE* stream, uint64_t v);
+
+/**
+ * @brief Write a 64 bits value (low bytes first).
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] v The value.
+ */
+void _replay_put_u64(FILE* stream, uint64_t v);
+
+/**
+ * @brief Read a varint.
+ *
+ * @param[in] pR The reader.
+ * @param[in,out] pOffset Offset of the varint, then of what follows it.
+ * @param[out] pV The value.
+ * @return true The value is read.
+ * @return false The replay ends before.
+ */
+bool _replay_get_varint(const replay_reader_t* pR,
+                        size_t* pOffset,
+                        uint64_t* pV);
+
+/**
+ * @brief Read a 64 bits value (low bytes first).
+ *
+ * @param[in] pR The reader.
+ * @param[in,out] pOffset Offset of the value, then of what follows it.
+ * @param[out] pV The value.
+ * @return true The value is read.
+ * @return false The replay ends before.
+ */
+bool _replay_get_u64(const replay_reader_t* pR, size_t* pOffset, uint64_t* pV);
+
+/**
+ * @brief Read the header of a replay.
+ *
+ * @param[in,out] pR The reader (data and size set).
+ * @param[out] pOffset Offset of the first keyframe.
+ * @return true The header is valid.
+ * @return false Not a replay, or allocation failed.
+ */
+bool _replay_read_header(replay_reader_t* pR, size_t* pOffset);
+
+/**
+ * @brief Find the keyframes of a replay.
+ *
+ * @param[in,out] pR The reader (header read).
+ * @param[in] offset Offset of the first keyframe.
+ * @return true At least the first keyframe is there.
+ * @return false No keyframe, or allocation failed.
+ */
+bool _replay_index(replay_reader_t* pR, size_t offset);
+
+/**
+ * @brief Write the state of a character in a keyframe.
+ *
+ * @param[in,out] stream Where to write.
+ * @param[in] pC The character.
+ */
+void _replay_put_character(FILE* stream, const character_t* pC);
+
+/**
+ * @brief Read the state of a character from a keyframe.
+ *
+ * @param[in] pR The reader.
+ * @param[in,out] pOffset Offset of the state, then of what follows it.
+ * @param[in,out] pC The character to restore.
+ */
+void _replay_get_character(const replay_reader_t* pR,
+                           size_t* pOffset,
+                           character_t* pC);
+
+/**********************************/
+//  Public functions implementation
+
+uint8_t replay_code(compass_t move, bool cheated) {
+  if (cheated) {
+    return REPLAY_CHEAT;
+  }
+  switch (move) {
+    case North:
+      return REPLAY_NORTH;
+    case East:
+      return REPLAY_EAST;
+    case South:
+      return REPLAY_SOUTH;
+    case West:
+      return REPLAY_WEST;
+    default:
+      return REPLAY_STAY;
+  }
+}
+
+compass_t replay_move(uint8_t code, bool* pCheated) {
+  *pCheated = (code == REPLAY_CHEAT);
+  switch (code) {
+    case REPLAY_NORTH:
+      return North;
+    case REPLAY_EAST:
+      return East;
+    case REPLAY_SOUTH:
+      return South;
+    case REPLAY_WEST:
+      return West;
+    default:
+      return Stay;
+  }
+}
+
+uint64_t replay_map_hash(const map_t* pMap) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (size_t l = 0; l < pMap->y; ++l) {
+    const char* row = pMap->grid + l * pMap->stride;
+    for (size_t c = 0; c < pMap->x; ++c) {
+      h = (h ^ (uint8_t)row[c]) * 0x100000001b3ull;
+    }
+  }
+  return h;
+}
+
+bool replay_writer_open(replay_writer_t* pW,
+                        const char* path,
+                        const char* mapName,
+                        const map_t* pMap,
+                        unsigned long seed,
+                        int maxMoves,
+                        const character_t* playerA,
+                        size_t nbPlayer,
+                        const character_t* minotaurA,
+                        size_t nbMinotaur) {
+  pW->nbPlayer = nbPlayer;
+  pW->nbChar = nbPlayer + nbMinotaur;
+  pW->x = pMap->x;
+  pW->y = pMap->y;
+  pW->recordSize = (3 * pW->nbChar + 7) / 8;
+  pW->initial = (char*)malloc(pMap->x * pMap->y + 1);
+  pW->record = (uint8_t*)malloc(pW->recordSize + 1);
+  pW->file = fopen(path, "wb");
+  if ((pW->initial == NULL) || (pW->record == NULL) || (pW->file == NULL)) {
+    replay_writer_close(pW);
+    return false;
+  }
+  for (size_t l = 0; l < pMap->y; ++l) {
+    memcpy(pW->initial + l * pMap->x, pMap->grid + l * pMap->stride, pMap->x);
+  }
+
+  size_t nameSize = strlen(mapName);
+  fwrite(REPLAY_MAGIC, 1, REPLAY_MAGIC_SIZE, pW->file);
+  _replay_put_varint(pW->file, nameSize);
+  fwrite(mapName, 1, nameSize, pW->file);
+  _replay_put_u64(pW->file, replay_map_hash(pMap));
+  _replay_put_varint(pW->file, pMap->x);
+  _replay_put_varint(pW->file, pMap->y);
+  _replay_put_varint(pW->file, nbPlayer);
+  _replay_put_varint(pW->file, nbMinotaur);
+  _replay_put_varint(pW->file, (uint64_t)maxMoves);
+  _replay_put_varint(pW->file, seed);
+  _replay_put_varint(pW->file, REPLAY_KEYFRAME_INTERVAL);
+  for (size_t i = 0; i < nbPlayer; ++i) {
+    _replay_put_varint(pW->file, playerA[i].pos.x);
+    _replay_put_varint(pW->file, playerA[i].pos.y);
+  }
+  for (size_t i = 0; i < nbMinotaur; ++i) {
+    _replay_put_varint(pW->file, minotaurA[i].pos.x);
+    _replay_put_varint(pW->file, minotaurA[i].pos.y);
+  }
+  return true;
+}
+
+bool replay_writer_keyframe(replay_writer_t* pW,
+                            int step,
+                            const map_t* pMap,
+                            const character_t* playerA,
+                            const character_t* minotaurA) {
+  // The payload is composed first, its size is written before it
+  char* buffer = NULL;
+  size_t size = 0;
+  FILE* payload = open_memstream(&buffer, &size);
+  if (payload == NULL) {
+    return false;
+  }
+
+  _replay_put_varint(payload, (uint64_t)step);
+  for (size_t i = 0; i < pW->nbPlayer; ++i) {
+    _replay_put_character(payload, &(playerA[i]));
+  }
+  for (size_t i = 0; i < pW->nbChar - pW->nbPlayer; ++i) {
+    _replay_put_character(payload, &(minotaurA[i]));
+  }
+
+  // Cells that differ from the initial map, as (gap, content) pairs
+  size_t nbDiff = 0;
+  for (size_t l = 0; l < pW->y; ++l) {
+    const char* row = pMap->grid + l * pMap->stride;
+    const char* initialRow = pW->initial + l * pW->x;
+    for (size_t c = 0; c < pW->x; ++c) {
+      nbDiff += (row[c] != initialRow[c]) ? 1 : 0;
+    }
+  }
+  _replay_put_varint(payload, nbDiff);
+  size_t next = 0;  // Index of the cell after the last difference
+  for (size_t l = 0; l < pW->y; ++l) {
+    const char* row = pMap->grid + l * pMap->stride;
+    const char* initialRow = pW->initial + l * pW->x;
+    for (size_t c = 0; c < pW->x; ++c) {
+      if (row[c] != initialRow[c]) {
+        size_t i = l * pW->x + c;
+        _replay_put_varint(payload, i - next);
+        fputc((unsigned char)row[c], payload);
+        next = i + 1;
+      }
+    }
+  }
+  fclose(payload);
+
+  fputc(REPLAY_TAG_KEYFRAME, pW->file);
+  _replay_put_varint(pW->file, size);
+  bool ok = (fwrite(buffer, 1, size, pW->file) == size);
+  free(buffer);
+  return ok;
+}
+
+void replay_writer_step(replay_writer_t* pW, const uint8_t* codeA) {
+  memset(pW->record, 0, pW->recordSize + 1);
+  for (size_t i = 0; i < pW->nbChar; ++i) {
+    size_t b = 3 * i;
+    unsigned v = (unsigned)(codeA[i] & 7u) << (b & 7);
+    pW->record[b >> 3] |= (uint8_t)v;
+    pW->record[(b >> 3) + 1] |= (uint8_t)(v >> 8);
+  }
+  fwrite(pW->record, 1, pW->recordSize, pW->file);
+}
+
+bool replay_writer_close(replay_writer_t* pW) {
+  bool ok = true;
+  if (pW->file != NULL) {
+    ok = !ferror(pW->file);
+    ok = (fclose(pW->file) == 0) && ok;
+  }
+  free(pW->initial);
+  free(pW->record);
+  pW->file = NULL;
+  pW->initial = NULL;
+  pW->record = NULL;
+  pW->nbPlayer = 0;
+  pW->nbChar = 0;
+  pW->recordSize = 0;
+  return ok;
+}
+
+bool replay_reader_load(replay_reader_t* pR, const char* path) {
+  memset(pR, 0, sizeof(replay_reader_t));
+
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+  bool ok = (fseek(file, 0, SEEK_END) == 0);
+  long size = ok ? ftell(file) : -1;
+  ok = ok && (size > 0) && (fseek(file, 0, SEEK_SET) == 0);
+  if (ok) {
+    pR->size = (size_t)size;
+    pR->data = (uint8_t*)malloc(pR->size);
+    ok = (pR->data != NULL) &&
+         (fread(pR->data, 1, pR->size, file) == pR->size);
+  }
+  fclose(file);
+
+  size_t offset = 0;
+  ok = ok && _replay_read_header(pR, &offset) && _replay_index(pR, offset);
+  if (!ok) {
+    replay_reader_delete(pR);
+  }
+  return ok;
+}
+
+void replay_reader_delete(replay_reader_t* pR) {
+  free(pR->data);
+  free(pR->mapName);
+  free(pR->startA);
+  free(pR->keyA);
+  memset(pR, 0, sizeof(replay_reader_t));
+}
+
+bool replay_reader_match(const replay_reader_t* pR,
+                         const map_t* pMap,
+                         const character_t* playerA,
+                         size_t nbPlayer,
+                         const character_t* minotaurA,
+                         size_t nbMinotaur) {
+  if ((pMap->x != pR->x) || (pMap->y != pR->y) ||
+      (replay_map_hash(pMap) != pR->mapHash) || (nbPlayer != pR->nbPlayer) ||
+      (nbMinotaur != pR->nbMinotaur)) {
+    return false;
+  }
+  for (size_t i = 0; i < nbPlayer; ++i) {
+    if ((playerA[i].pos.x != pR->startA[i].x) ||
+        (playerA[i].pos.y != pR->startA[i].y)) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < nbMinotaur; ++i) {
+    if ((minotaurA[i].pos.x != pR->startA[nbPlayer + i].x) ||
+        (minotaurA[i].pos.y != pR->startA[nbPlayer + i].y)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int replay_reader_keyframe(const replay_reader_t* pR,
+                           size_t k,
+                           map_t* pMap,
+                           const char* initial,
+                           character_t* playerA,
+                           character_t* minotaurA) {
+  size_t offset = pR->keyA[k].offset;
+  uint64_t v = 0;
+  _replay_get_varint(pR, &offset, &v);
+  int step = (int)v;
+  for (size_t i = 0; i < pR->nbPlayer; ++i) {
+    _replay_get_character(pR, &offset, &(playerA[i]));
+  }
+  for (size_t i = 0; i < pR->nbMinotaur; ++i) {
+    _replay_get_character(pR, &offset, &(minotaurA[i]));
+  }
+
+  // Initial cells, except the differences (only changed cells are set, so
+  // the passability layer stays right)
+  uint64_t nbDiff = 0;
+  _replay_get_varint(pR, &offset, &nbDiff);
+  size_t next = pR->x * pR->y;  // Next cell that differs
+  uint64_t gap = 0;
+  if ((nbDiff > 0) && _replay_get_varint(pR, &offset, &gap)) {
+    next = (size_t)gap;
+  }
+  for (size_t i = 0; i < pR->x * pR->y; ++i) {
+    char cell = initial[i];
+    if ((i == next) && (offset < pR->keyA[k].end)) {
+      cell = (char)pR->data[offset++];
+      --nbDiff;
+      next = pR->x * pR->y;
+      if ((nbDiff > 0) && _replay_get_varint(pR, &offset, &gap)) {
+        next = i + 1 + (size_t)gap;
+      }
+    }
+    if (map_get(pMap, i % pR->x, i / pR->x) != cell) {
+      map_set(pMap, i % pR->x, i / pR->x, cell);
+    }
+  }
+  return step;
+}
+
+void replay_reader_step(const replay_reader_t* pR, int step, uint8_t* codeA) {
+  // Moves of the step are after the keyframe before it
+  size_t k = (size_t)(step - 1) / pR->interval;
+  size_t offset = pR->keyA[k].end +
+                  ((size_t)(step - 1) - k * pR->interval) * pR->recordSize;
+  const uint8_t* record = pR->data + offset;
+  size_t nbChar = pR->nbPlayer + pR->nbMinotaur;
+  for (size_t i = 0; i < nbChar; ++i) {
+    size_t b = 3 * i;
+    unsigned v = record[b >> 3];
+    if ((b >> 3) + 1 < pR->recordSize) {
+      v |= (unsigned)record[(b >> 3) + 1] << 8;
+    }
+    codeA[i] = (uint8_t)((v >> (b & 7)) & 7u);
+  }
+}
+
+/**********************************/
+//  Local functions implementation
+
+void _replay_put_varint(FILE* stream, uint64_t v) {
+  while (v >= 0x80) {
+    fputc((int)((v & 0x7f) | 0x80), stream);
+    v >>= 7;
+  }
+  fputc((int)v, stream);
+}
+
+void _replay_put_u64(FILE* stream, uint64_t v) {
+  for (int i = 0; i < 8; ++i) {
+    fputc((int)(v & 0xff), stream);
+    v >>= 8;
+  }
+}
+
+bool _replay_get_varint(const replay_reader_t* pR,
+                        size_t* pOffset,
+                        uint64_t* pV) {
+  uint64_t v = 0;
+  for (unsigned shift = 0; (shift < 64) && (*pOffset < pR->size);
+       shift += 7) {
+    uint8_t byte = pR->data[(*pOffset)++];
+    v |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *pV = v;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool _replay_get_u64(const replay_reader_t* pR, size_t* pOffset, uint64_t* pV) {
+  if (pR->size - *pOffset < 8) {
+    return false;
+  }
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; --i) {
+    v = (v << 8) | pR->data[*pOffset + (size_t)i];
+  }
+  *pOffset += 8;
+  *pV = v;
+  return true;
+}
+
+bool _replay_read_header(replay_reader_t* pR, size_t* pOffset) {
+  if ((pR->size < REPLAY_MAGIC_SIZE) ||
+      (memcmp(pR->data, REPLAY_MAGIC, REPLAY_MAGIC_SIZE) != 0)) {
+    return false;
+  }
+  size_t offset = REPLAY_MAGIC_SIZE;
+  uint64_t nameSize = 0;
+  if (!_replay_get_varint(pR, &offset, &nameSize) ||
+      (pR->size - offset < nameSize)) {
+    return false;
+  }
+  pR->mapName = (char*)malloc((size_t)nameSize + 1);
+  if (pR->mapName == NULL) {
+    return false;
+  }
+  memcpy(pR->mapName, pR->data + offset, (size_t)nameSize);
+  pR->mapName[nameSize] = '\0';
+  offset += (size_t)nameSize;
+
+  uint64_t fieldA[7];
+  bool ok = _replay_get_u64(pR, &offset, &(pR->mapHash));
+  for (size_t i = 0; ok && (i < 7); ++i) {
+    ok = _replay_get_varint(pR, &offset, &(fieldA[i]));
+  }
+  if (!ok || (fieldA[6] == 0)) {
+    return false;
+  }
+  pR->x = (size_t)fieldA[0];
+  pR->y = (size_t)fieldA[1];
+  pR->nbPlayer = (size_t)fieldA[2];
+  pR->nbMinotaur = (size_t)fieldA[3];
+  pR->maxMoves = (int)fieldA[4];
+  pR->seed = (unsigned long)fieldA[5];
+  pR->interval = (size_t)fieldA[6];
+  pR->recordSize = (3 * (pR->nbPlayer + pR->nbMinotaur) + 7) / 8;
+
+  size_t nbChar = pR->nbPlayer + pR->nbMinotaur;
+  pR->startA = (pos_t*)malloc((nbChar + 1) * sizeof(pos_t));
+  if ((pR->startA == NULL) || (nbChar == 0)) {
+    return false;
+  }
+  for (size_t i = 0; ok && (i < nbChar); ++i) {
+    uint64_t x = 0;
+    uint64_t y = 0;
+    ok = _replay_get_varint(pR, &offset, &x) &&
+         _replay_get_varint(pR, &offset, &y);
+    pR->startA[i].x = (size_t)x;
+    pR->startA[i].y = (size_t)y;
+  }
+  *pOffset = offset;
+  return ok;
+}
+
+bool _replay_index(replay_reader_t* pR, size_t offset) {
+  size_t capacity = 16;
+  pR->keyA = (replay_key_t*)malloc(capacity * sizeof(replay_key_t));
+  if (pR->keyA == NULL) {
+    return false;
+  }
+
+  // Steps are fixed size records: hop from a keyframe to the next one
+  size_t chunk = pR->interval * pR->recordSize;
+  while ((offset < pR->size) && (pR->data[offset] == REPLAY_TAG_KEYFRAME)) {
+    ++offset;
+    uint64_t size = 0;
+    if (!_replay_get_varint(pR, &offset, &size) ||
+        (pR->size - offset < size)) {
+      break;  // Truncated keyframe
+    }
+    if (pR->nbKey == capacity) {
+      capacity *= 2;
+      replay_key_t* keyA =
+          (replay_key_t*)realloc(pR->keyA, capacity * sizeof(replay_key_t));
+      if (keyA == NULL) {
+        return false;
+      }
+      pR->keyA = keyA;
+    }
+    pR->keyA[pR->nbKey].offset = offset;
+    pR->keyA[pR->nbKey].end = offset + (size_t)size;
+    offset = pR->keyA[pR->nbKey].end;
+    ++(pR->nbKey);
+
+    size_t left = pR->size - offset;
+    size_t nbSteps = (left < chunk) ? left / pR->recordSize : pR->interval;
+    pR->nbSteps = (int)((pR->nbKey - 1) * pR->interval + nbSteps);
+    offset += nbSteps * pR->recordSize;
+  }
+  return pR->nbKey > 0;
+}
+
+void _replay_put_character(FILE* stream, const character_t* pC) {
+  uint64_t health = 0;
+  memcpy(&health, &(pC->health), sizeof(health));
+  _replay_put_varint(stream, pC->pos.x);
+  _replay_put_varint(stream, pC->pos.y);
+  fputc((unsigned char)pC->type, stream);
+  fputc((unsigned char)pC->walkOn, stream);
+  fputc((unsigned char)pC->ending, stream);
+  _replay_put_u64(stream, health);
+}
+
+void _replay_get_character(const replay_reader_t* pR,
+                           size_t* pOffset,
+                           character_t* pC) {
+  uint64_t x = 0;
+  uint64_t y = 0;
+  uint64_t health = 0;
+  _replay_get_varint(pR, pOffset, &x);
+  _replay_get_varint(pR, pOffset, &y);
+  if (pR->size - *pOffset < 3) {
+    return;
+  }
+  pC->pos.x = (size_t)x;
+  pC->pos.y = (size_t)y;
+  pC->type = (map_content_t)pR->data[(*pOffset)++];
+  pC->walkOn = (map_content_t)pR->data[(*pOffset)++];
+  pC->ending = (ending_char_t)pR->data[(*pOffset)++];
+  if (_replay_get_u64(pR, pOffset, &health)) {
+    memcpy(&(pC->health), &health, sizeof(health));
+  }
+}
@@ -0,0 +1,252 @@
+/**
+ * @file replayLog.h
+ * @brief Compact binary log of a game, to replay it without the AIs.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * A replay starts with a header: magic, map name and hash, sizes, seed and
+ * the start position of each character (players, then Minotaurs). It is
+ * followed by chunks: a keyframe (the full state after a step, as the
+ * differences with the initial map), then the moves of the next steps. The
+ * moves of a step are packed on 3 bits per character, in order of play.
+ *
+ * Integers are stored as varints (7 bits per byte, low bits first). A new
+ * keyframe is written every REPLAY_KEYFRAME_INTERVAL steps, so any step is at
+ * most that many steps away from a full state.
+ */
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "character.h"
+#include "gps.h"
+#include "map.h"
+
+/**
+ * @brief Number of steps between two keyframes.
+ *
+ */
+#define REPLAY_KEYFRAME_INTERVAL 64
+
+/**
+ * @brief Codes of the moves in a replay (3 bits each).
+ *
+ */
+typedef enum replay_code {
+  REPLAY_NORTH = 0,  ///< Move to the north.
+  REPLAY_EAST = 1,   ///< Move to the east.
+  REPLAY_SOUTH = 2,  ///< Move to the south.
+  REPLAY_WEST = 3,   ///< Move to the west.
+  REPLAY_STAY = 4,   ///< Stay.
+  REPLAY_CHEAT = 5   ///< The AI cheated (the move is not played).
+} replay_code_t;
+
+/**
+ * @brief A replay being written.
+ *
+ */
+typedef struct replay_writer {
+  FILE* file;         ///< The replay file.
+  size_t nbPlayer;    ///< Number of players.
+  size_t nbChar;      ///< Number of characters (players, then Minotaurs).
+  size_t x;           ///< Number of columns of the map.
+  size_t y;           ///< Number of rows of the map.
+  char* initial;      ///< Initial cells of the map (x * y, row-major).
+  uint8_t* record;    ///< Buffer of the moves of a step.
+  size_t recordSize;  ///< Size of the moves of a step (in bytes).
+} replay_writer_t;
+
+/**
+ * @brief Position of a keyframe in a replay.
+ *
+ */
+typedef struct replay_key {
+  size_t offset;  ///< Offset of the keyframe payload.
+  size_t end;     ///< Offset of the first step after the keyframe.
+} replay_key_t;
+
+/**
+ * @brief A replay loaded in memory.
+ *
+ */
+typedef struct replay_reader {
+  uint8_t* data;       ///< Content of the replay file.
+  size_t size;         ///< Size of the replay file.
+  char* mapName;       ///< Name of the map of the game.
+  uint64_t mapHash;    ///< Hash of the initial map.
+  size_t x;            ///< Number of columns of the map.
+  size_t y;            ///< Number of rows of the map.
+  size_t nbPlayer;     ///< Number of players.
+  size_t nbMinotaur;   ///< Number of Minotaurs.
+  int maxMoves;        ///< Maximum number of moves of the players.
+  unsigned long seed;  ///< Seed of the game.
+  pos_t* startA;       ///< Start positions (players, then Minotaurs).
+  size_t interval;     ///< Number of steps between two keyframes.
+  replay_key_t* keyA;  ///< Keyframes (keyframe k after step k * interval).
+  size_t nbKey;        ///< Number of keyframes.
+  size_t recordSize;   ///< Size of the moves of a step (in bytes).
+  int nbSteps;         ///< Number of steps in the replay.
+} replay_reader_t;
+
+/**
+ * @brief Code of a move in a replay.
+ *
+ * @param[in] move The move played.
+ * @param[in] cheated Did the AI cheat?
+ * @return uint8_t The code of the move (see replay_code_t).
+ */
+uint8_t replay_code(compass_t move, bool cheated);
+
+/**
+ * @brief Move of a code in a replay.
+ *
+ * @param[in] code The code of the move (see replay_code_t).
+ * @param[out] pCheated Did the AI cheat?
+ * @return compass_t The move to play (Stay for a cheat).
+ */
+compass_t replay_move(uint8_t code, bool* pCheated);
+
+/**
+ * @brief Hash of the cells of a map.
+ *
+ * @param[in] pMap The map.
+ * @return uint64_t FNV-1a hash of the cells, row after row.
+ */
+uint64_t replay_map_hash(const map_t* pMap);
+
+/**
+ * @brief Create a replay file and write its header.
+ *
+ * @param[out] pW The writer to initialize.
+ * @param[in] path Path of the replay file.
+ * @param[in] mapName Name of the map (as given to the game).
+ * @param[in] pMap The initial map (characters on it).
+ * @param[in] seed Seed of the game.
+ * @param[in] maxMoves Maximum number of moves of the players.
+ * @param[in] playerA Players at their start position.
+ * @param[in] nbPlayer Number of players.
+ * @param[in] minotaurA Minotaurs at their start position.
+ * @param[in] nbMinotaur Number of Minotaurs.
+ * @return true The replay is ready to record.
+ * @return false The file can not be written, or allocation failed.
+ */
+bool replay_writer_open(replay_writer_t* pW,
+                        const char* path,
+                        const char* mapName,
+                        const map_t* pMap,
+                        unsigned long seed,
+                        int maxMoves,
+                        const character_t* playerA,
+                        size_t nbPlayer,
+                        const character_t* minotaurA,
+                        size_t nbMinotaur);
+
+/**
+ * @brief Write a keyframe (the full state after a step).
+ *
+ * @param[in,out] pW The writer.
+ * @param[in] step The step just played (0 for the start).
+ * @param[in] pMap The map.
+ * @param[in] playerA The players.
+ * @param[in] minotaurA The Minotaurs.
+ * @return true The keyframe is written.
+ * @return false Allocation failed.
+ * @note A keyframe is expected before the first step, then after each
+ * REPLAY_KEYFRAME_INTERVAL steps.
+ */
+bool replay_writer_keyframe(replay_writer_t* pW,
+                            int step,
+                            const map_t* pMap,
+                            const character_t* playerA,
+                            const character_t* minotaurA);
+
+/**
+ * @brief Write the moves of a step.
+ *
+ * @param[in,out] pW The writer.
+ * @param[in] codeA The code of the move of each character (see replay_code).
+ */
+void replay_writer_step(replay_writer_t* pW, const uint8_t* codeA);
+
+/**
+ * @brief Close a replay file.
+ *
+ * @param[in,out] pW The writer to clear.
+ * @return true Everything was written.
+ * @return false Some writes failed.
+ */
+bool replay_writer_close(replay_writer_t* pW);
+
+/**
+ * @brief Load a replay file.
+ *
+ * @param[out] pR The reader to initialize.
+ * @param[in] path Path of the replay file.
+ * @return true The replay is loaded.
+ * @return false The file can not be read or is not a replay.
+ * @note A truncated replay is loaded up to its last complete step.
+ */
+bool replay_reader_load(replay_reader_t* pR, const char* path);
+
+/**
+ * @brief Clear a replay reader.
+ *
+ * @param[in,out] pR The reader to clear.
+ */
+void replay_reader_delete(replay_reader_t* pR);
+
+/**
+ * @brief Check that a game starts as the recorded one.
+ *
+ * @param[in] pR The reader.
+ * @param[in] pMap The initial map of the game.
+ * @param[in] playerA The players of the game.
+ * @param[in] nbPlayer Number of players.
+ * @param[in] minotaurA The Minotaurs of the game.
+ * @param[in] nbMinotaur Number of Minotaurs.
+ * @return true Same map and same characters at the same places.
+ * @return false The replay is not of this game.
+ */
+bool replay_reader_match(const replay_reader_t* pR,
+                         const map_t* pMap,
+                         const character_t* playerA,
+                         size_t nbPlayer,
+                         const character_t* minotaurA,
+                         size_t nbMinotaur);
+
+/**
+ * @brief Restore the state of a keyframe.
+ *
+ * @param[in] pR The reader.
+ * @param[in] k Index of the keyframe.
+ * @param[in,out] pMap The map to restore.
+ * @param[in] initial The initial cells of the map (x * y, row-major).
+ * @param[in,out] playerA The players to restore.
+ * @param[in,out] minotaurA The Minotaurs to restore.
+ * @return int The step of the keyframe.
+ * @note Only the position, health, type, ending and what is below each
+ * character are restored.
+ */
+int replay_reader_keyframe(const replay_reader_t* pR,
+                           size_t k,
+                           map_t* pMap,
+                           const char* initial,
+                           character_t* playerA,
+                           character_t* minotaurA);
+
+/**
+ * @brief Read the moves of a step.
+ *
+ * @param[in] pR The reader.
+ * @param[in] step The step (from 1 to nbSteps).
+ * @param[out] codeA The code of the move of each character.
+ */
+void replay_reader_step(const replay_reader_t* pR, int step, uint8_t* codeA);
+
+#endif  // End of REPLAY_LOG_H
@@ -0,0 +1,242 @@
+/**
+ * @file spatialIndex.c
+ * @brief Uniform grid index of positions (characters, exits...).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include "gps.h"
+#include "spatialIndex.h"
+
+/**********************************/
+// Declaration of local constants.
+
+/**
+ * @brief Side of a bucket (in cells).
+ *
+ */
+static const size_t _spatial_side = 8;
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Bucket of a position.
+ *
+ * @param[in] pIdx The index.
+ * @param[in] p The position.
+ * @return size_t Index of the bucket.
+ */
+size_t _spatial_bucket(const spatial_index_t* pIdx, pos_t p);
+
+/**
+ * @brief Link an item at the head of its bucket.
+ *
+ * @param[in,out] pIdx The index.
+ * @param[in] item The item.
+ */
+void _spatial_link(spatial_index_t* pIdx, size_t item);
+
+/**
+ * @brief Unlink an item from its bucket.
+ *
+ * @param[in,out] pIdx The index.
+ * @param[in] item The item.
+ */
+void _spatial_unlink(spatial_index_t* pIdx, size_t item);
+
+/**
+ * @brief Distance between two positions, as computed by gps_direction().
+ *
+ * @param[in] a A position.
+ * @param[in] b A position.
+ * @return float The distance.
+ */
+float _spatial_distance(pos_t a, pos_t b);
+
+/**
+ * @brief Comparison of two items for qsort.
+ *
+ * @param[in] a A pointer to an item.
+ * @param[in] b A pointer to an item.
+ * @return int Negative, zero or positive.
+ */
+int _spatial_cmp(const void* a, const void* b);
+
+/**********************************/
+//  Local functions implementation
+
+size_t _spatial_bucket(const spatial_index_t* pIdx, pos_t p) {
+  return (p.y / pIdx->side) * pIdx->nbX + (p.x / pIdx->side);
+}
+
+void _spatial_link(spatial_index_t* pIdx, size_t item) {
+  size_t b = _spatial_bucket(pIdx, pIdx->pos[item]);
+  pIdx->prev[item] = SPATIAL_NONE;
+  pIdx->next[item] = pIdx->head[b];
+  if (pIdx->head[b] != SPATIAL_NONE) {
+    pIdx->prev[pIdx->head[b]] = item;
+  }
+  pIdx->head[b] = item;
+}
+
+void _spatial_unlink(spatial_index_t* pIdx, size_t item) {
+  if (pIdx->prev[item] != SPATIAL_NONE) {
+    pIdx->next[pIdx->prev[item]] = pIdx->next[item];
+  } else {
+    pIdx->head[_spatial_bucket(pIdx, pIdx->pos[item])] = pIdx->next[item];
+  }
+  if (pIdx->next[item] != SPATIAL_NONE) {
+    pIdx->prev[pIdx->next[item]] = pIdx->prev[item];
+  }
+}
+
+float _spatial_distance(pos_t a, pos_t b) {
+  compass_t c;
+  float d;
+  gps_direction(a, b, &c, &d);
+  return d;
+}
+
+int _spatial_cmp(const void* a, const void* b) {
+  size_t ia = *(const size_t*)a;
+  size_t ib = *(const size_t*)b;
+  return (ia > ib) - (ia < ib);
+}
+
+/**********************************/
+// Public functions implementations.
+
+bool spatial_init(spatial_index_t* pIdx,
+                  const map_t* pMap,
+                  const pos_t* pos,
+                  size_t nbItems) {
+  pIdx->side = _spatial_side;
+  pIdx->nbX = (pMap->x + pIdx->side - 1) / pIdx->side;
+  pIdx->nbY = (pMap->y + pIdx->side - 1) / pIdx->side;
+  pIdx->nbItems = nbItems;
+
+  // NOTE: +1 so that no malloc(0) is done.
+  pIdx->head = (size_t*)malloc((pIdx->nbX * pIdx->nbY + 1) * sizeof(size_t));
+  pIdx->pos = (pos_t*)malloc((nbItems + 1) * sizeof(pos_t));
+  pIdx->next = (size_t*)malloc((nbItems + 1) * sizeof(size_t));
+  pIdx->prev = (size_t*)malloc((nbItems + 1) * sizeof(size_t));
+  if ((pIdx->head == NULL) || (pIdx->pos == NULL) || (pIdx->next == NULL) ||
+      (pIdx->prev == NULL)) {
+    spatial_delete(pIdx);
+    return false;
+  }
+
+  for (size_t b = 0; b < pIdx->nbX * pIdx->nbY; ++b) {
+    pIdx->head[b] = SPATIAL_NONE;
+  }
+  // Insert in reverse order: each bucket list is then sorted by index.
+  for (size_t i = nbItems; i > 0; --i) {
+    pIdx->pos[i - 1] = pos[i - 1];
+    _spatial_link(pIdx, i - 1);
+  }
+  return true;
+}
+
+void spatial_delete(spatial_index_t* pIdx) {
+  free(pIdx->head);
+  pIdx->head = NULL;
+  free(pIdx->pos);
+  pIdx->pos = NULL;
+  free(pIdx->next);
+  pIdx->next = NULL;
+  free(pIdx->prev);
+  pIdx->prev = NULL;
+  pIdx->nbItems = 0;
+}
+
+void spatial_move(spatial_index_t* pIdx, size_t item, pos_t p) {
+  if (_spatial_bucket(pIdx, pIdx->pos[item]) == _spatial_bucket(pIdx, p)) {
+    pIdx->pos[item] = p;
+    return;
+  }
+  _spatial_unlink(pIdx, item);
+  pIdx->pos[item] = p;
+  _spatial_link(pIdx, item);
+}
+
+size_t spatial_closest(const spatial_index_t* pIdx, pos_t source) {
+  size_t best = SPATIAL_NONE;
+  float bestDist = -1;
+
+  long long int bx = (long long int)(source.x / pIdx->side);
+  long long int by = (long long int)(source.y / pIdx->side);
+  long long int nbX = (long long int)pIdx->nbX;
+  long long int nbY = (long long int)pIdx->nbY;
+  long long int maxRing = (nbX > nbY) ? nbX : nbY;
+
+  for (long long int r = 0; r <= maxRing; ++r) {
+    if ((best != SPATIAL_NONE) && (r > 0)) {
+      // Nothing in this ring can be closer than this (strictly farther
+      // items can not win, equal ones may win on their index).
+      long long int gap = (r - 1) * (long long int)pIdx->side + 1;
+      float ringDist = (float)gap * 10;
+      if (ringDist > bestDist) {
+        break;
+      }
+    }
+    for (long long int y = by - r; y <= by + r; ++y) {
+      if ((y < 0) || (y >= nbY)) {
+        continue;
+      }
+      // Only the border of the ring (whole rows at top and bottom).
+      long long int step = ((y == by - r) || (y == by + r)) ? 1 : 2 * r;
+      for (long long int x = bx - r; x <= bx + r; x += step) {
+        if ((x < 0) || (x >= nbX)) {
+          continue;
+        }
+        size_t item = pIdx->head[(size_t)(y * nbX + x)];
+        while (item != SPATIAL_NONE) {
+          float d = _spatial_distance(source, pIdx->pos[item]);
+          if ((bestDist < 0) || (d < bestDist) ||
+              ((d == bestDist) && (item < best))) {
+            bestDist = d;
+            best = item;
+          }
+          item = pIdx->next[item];
+        }
+      }
+    }
+  }
+  return best;
+}
+
+size_t spatial_around(const spatial_index_t* pIdx, pos_t p, size_t* items) {
+  size_t nb = 0;
+  size_t xMin = (p.x > 0) ? p.x - 1 : 0;
+  size_t yMin = (p.y > 0) ? p.y - 1 : 0;
+  size_t bxMax = (p.x + 1) / pIdx->side;
+  size_t byMax = (p.y + 1) / pIdx->side;
+  if (bxMax >= pIdx->nbX) {
+    bxMax = pIdx->nbX - 1;
+  }
+  if (byMax >= pIdx->nbY) {
+    byMax = pIdx->nbY - 1;
+  }
+
+  for (size_t by = yMin / pIdx->side; by <= byMax; ++by) {
+    for (size_t bx = xMin / pIdx->side; bx <= bxMax; ++bx) {
+      size_t item = pIdx->head[by * pIdx->nbX + bx];
+      while (item != SPATIAL_NONE) {
+        pos_t q = pIdx->pos[item];
+        size_t dx = (q.x > p.x) ? q.x - p.x : p.x - q.x;
+        size_t dy = (q.y > p.y) ? q.y - p.y : p.y - q.y;
+        if (dx + dy <= 1) {
+          items[nb++] = item;
+        }
+        item = pIdx->next[item];
+      }
+    }
+  }
+
+  qsort(items, nb, sizeof(size_t), &_spatial_cmp);
+  return nb;
+}
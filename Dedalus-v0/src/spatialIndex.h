@@ -0,0 +1,95 @@
+/**
+ * @file spatialIndex.h
+ * @brief Uniform grid index of positions (characters, exits...).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "map.h"
+
+/**
+ * @brief Marker for "no item" in the index lists.
+ *
+ */
+#define SPATIAL_NONE ((size_t)-1)
+
+/**
+ * @brief A set of items (identified by their index in an external array)
+ * dispatched in square buckets of the map according to their position.
+ *
+ * Each bucket is a doubly linked list threaded through the items, so moving
+ * an item is O(1) and never allocates.
+ */
+typedef struct spatial_index {
+  size_t side;     ///< Side of a bucket (in cells).
+  size_t nbX;      ///< Number of buckets per row.
+  size_t nbY;      ///< Number of buckets per column.
+  size_t* head;    ///< First item of each bucket (SPATIAL_NONE if empty).
+  size_t nbItems;  ///< Number of items.
+  pos_t* pos;      ///< Position of each item.
+  size_t* next;    ///< Next item in the same bucket.
+  size_t* prev;    ///< Previous item in the same bucket.
+} spatial_index_t;
+
+/**
+ * @brief Build an index of positions.
+ *
+ * @param[out] pIdx The index to build.
+ * @param[in] pMap The map (for its size).
+ * @param[in] pos Initial position of each item.
+ * @param[in] nbItems Number of items.
+ * @return true The index is built.
+ * @return false Allocation failed.
+ */
+bool spatial_init(spatial_index_t* pIdx,
+                  const map_t* pMap,
+                  const pos_t* pos,
+                  size_t nbItems);
+
+/**
+ * @brief Clear an index.
+ *
+ * @param[in,out] pIdx The index to clear.
+ */
+void spatial_delete(spatial_index_t* pIdx);
+
+/**
+ * @brief Update the position of an item.
+ *
+ * @param[in,out] pIdx The index.
+ * @param[in] item The item that moved.
+ * @param[in] p Its new position.
+ */
+void spatial_move(spatial_index_t* pIdx, size_t item, pos_t p);
+
+/**
+ * @brief Find the item closest to a position (euclidian distance).
+ *
+ * @param[in] pIdx The index.
+ * @param[in] source The position to start from.
+ * @return size_t The closest item (smallest index in case of a tie), or
+ * SPATIAL_NONE if the index is empty.
+ * @note Same result as a linear scan with gps_direction() distances.
+ */
+size_t spatial_closest(const spatial_index_t* pIdx, pos_t source);
+
+/**
+ * @brief List the items at a position or next to it (4-neighbourhood).
+ *
+ * @param[in] pIdx The index.
+ * @param[in] p The position.
+ * @param[out] items Array (at least nbItems long) of the items found, sorted
+ * by increasing index.
+ * @return size_t Number of items found.
+ */
+size_t spatial_around(const spatial_index_t* pIdx, pos_t p, size_t* items);
+
+#endif  // End of SPATIAL_INDEX_H
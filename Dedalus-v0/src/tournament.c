@@ -0,0 +1,497 @@
+/**
+ * @file tournament.c
+ * @brief Run many headless games of a map on all cores and report endings.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <getopt.h>   /* Getopt */
+#include <limits.h>   // INT_MAX
+#include <pthread.h>  // pthread_create
+#include <stdbool.h>  // bool, true, false
+#include <stdio.h>    // printf
+#include <stdlib.h>   // malloc
+#include <string.h>   // strcmp
+#include <time.h>     // time
+#include <unistd.h>   // sysconf
+
+#include "ai.h"
+#include "ai/ai_random.h"
+#include "config.h"   // configuration
+#include "display.h"  // fatal errors and ending names
+#include "game.h"     // game setting
+#include "map.h"      // manage the map
+
+/**
+ * @brief Number of possible character endings (see ending_char_t).
+ *
+ */
+#define TOURNAMENT_NB_ENDINGS (EC_WIN + 1)
+
+/**
+ * @brief Result of a player in one game.
+ *
+ */
+typedef struct tournament_player {
+  ending_char_t ending;  ///< Personal ending of the player.
+  ending_t result;       ///< Ending of the player (with its team).
+  double health;         ///< Health at the end of the game.
+} tournament_player_t;
+
+/**
+ * @brief Result of one game.
+ *
+ */
+typedef struct tournament_game {
+  bool ok;                         ///< The game could be initialised.
+  unsigned long seed;              ///< Seed of the game.
+  int steps;                       ///< Number of steps played.
+  ending_t result;                 ///< Ending for the game master.
+  size_t nbMinotaur;               ///< Number of Minotaurs.
+  size_t nbMinotaurAlive;          ///< Number of Minotaurs alive at the end.
+  size_t nbPlayer;                 ///< Number of players.
+  tournament_player_t* playerA;    ///< Results of the players.
+} tournament_game_t;
+
+/**
+ * @brief A tournament: the same map played many times.
+ *
+ */
+typedef struct tournament {
+  const map_t* pMap;           ///< The map (never changed, games use copies).
+  config_t config;             ///< Configuration of every game.
+  tournament_game_t* gameA;    ///< Results of the games.
+  size_t nbGames;              ///< Number of games.
+  size_t next;                 ///< Next game to play.
+  pthread_mutex_t lock;        ///< Protects next.
+} tournament_t;
+
+/**
+ * @brief Parse parameters.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @param[out] pConfig Configuration of the games.
+ * @param[out] pNbGames Number of games.
+ * @param[out] pNbThreads Number of threads (0: all cores).
+ * @param[out] pJson Report in JSON (CSV else).
+ * @param[out] pOutput Report file (NULL for stdout).
+ */
+void read_parameters(int argc,
+                     char* argv[],
+                     config_t* pConfig,
+                     size_t* pNbGames,
+                     size_t* pNbThreads,
+                     bool* pJson,
+                     const char** pOutput);
+
+/**
+ * @brief Display the program usage.
+ *
+ */
+void usage();
+
+/**
+ * @brief Play one game of the tournament and keep its results.
+ *
+ * @param[in,out] pT The tournament.
+ * @param[in] i Index of the game.
+ */
+void _tournament_play(tournament_t* pT, size_t i);
+
+/**
+ * @brief Play games until there is none left.
+ *
+ * @param[in,out] arg The tournament.
+ * @return void* Always NULL.
+ */
+void* _tournament_worker(void* arg);
+
+/**
+ * @brief Write the results as CSV (one row per player of each game).
+ *
+ * @param[in,out] stream Where it should be written.
+ * @param[in] pT The tournament.
+ */
+void _tournament_write_csv(FILE* stream, const tournament_t* pT);
+
+/**
+ * @brief Write the results and their aggregation as JSON.
+ *
+ * @param[in,out] stream Where it should be written.
+ * @param[in] pT The tournament.
+ */
+void _tournament_write_json(FILE* stream, const tournament_t* pT);
+
+/**
+ * @brief Write a string as a JSON string.
+ *
+ * @param[in,out] stream Where it should be written.
+ * @param[in] s The string.
+ */
+void _tournament_write_json_string(FILE* stream, const char* s);
+
+/**
+ * @brief Aggregate results over all games.
+ *
+ * @param[in] pT The tournament.
+ * @param[out] endings Number of players for each character ending.
+ * @param[out] pMeanSteps Mean number of steps per game.
+ * @param[out] pMeanHealth Mean health of players at the end.
+ */
+void _tournament_aggregate(const tournament_t* pT,
+                           size_t endings[TOURNAMENT_NB_ENDINGS],
+                           double* pMeanSteps,
+                           double* pMeanHealth);
+
+/**
+ * @brief Main of the tournament.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv Array of parameters.
+ * @return int Tournament success.
+ */
+int main(int argc, char* argv[]) {
+  // Game i is seeded with seed + i (the seed changes at each run by default)
+  config_t config = config_init();
+  config.seed = (unsigned long)time(NULL);
+  size_t nbGames = 100;
+  size_t nbThreads = 0;
+  bool json = false;
+  const char* output = NULL;
+  read_parameters(argc, argv, &config, &nbGames, &nbThreads, &json, &output);
+  config.headless = true;
+  config.interactive = false;
+  config.delay = 0;
+
+  map_t map;
+  if (!map_reader(config.mapFile, &map)) {
+    display_fatal_error(stderr, "Invalid map !\n");
+    return EXIT_FAILURE;
+  }
+
+  if (nbThreads == 0) {
+    long nbCores = sysconf(_SC_NPROCESSORS_ONLN);
+    nbThreads = (nbCores > 0) ? (size_t)nbCores : 1;
+  }
+  if (nbThreads > nbGames) {
+    nbThreads = (nbGames > 0) ? nbGames : 1;
+  }
+
+  tournament_t t;
+  t.pMap = &map;
+  t.config = config;
+  t.nbGames = nbGames;
+  t.next = 0;
+  t.gameA =
+      (tournament_game_t*)calloc(nbGames + 1, sizeof(tournament_game_t));
+  if ((t.gameA == NULL) || (pthread_mutex_init(&(t.lock), NULL) != 0)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    return EXIT_FAILURE;
+  }
+
+  // The main thread plays as well
+  pthread_t threadA[nbThreads];
+  for (size_t i = 1; i < nbThreads; ++i) {
+    if (pthread_create(&(threadA[i]), NULL, &_tournament_worker, &t) != 0) {
+      display_fatal_error(stderr, "Error: can not create thread!");
+      return EXIT_FAILURE;
+    }
+  }
+  _tournament_worker(&t);
+  for (size_t i = 1; i < nbThreads; ++i) {
+    pthread_join(threadA[i], NULL);
+  }
+  pthread_mutex_destroy(&(t.lock));
+
+  bool ok = true;
+  for (size_t i = 0; i < nbGames; ++i) {
+    ok = ok && t.gameA[i].ok;
+  }
+  if (!ok) {
+    display_fatal_error(stderr, "Wrong map (no player or no exit)!\n");
+  } else {
+    FILE* stream = stdout;
+    if (output != NULL) {
+      stream = fopen(output, "w");
+      if (stream == NULL) {
+        display_fatal_error(stderr, "Error: can not open the report file!\n");
+        return EXIT_FAILURE;
+      }
+    }
+    if (json) {
+      _tournament_write_json(stream, &t);
+    } else {
+      _tournament_write_csv(stream, &t);
+    }
+    if (output != NULL) {
+      fclose(stream);
+    }
+
+    size_t endings[TOURNAMENT_NB_ENDINGS];
+    double meanSteps = 0;
+    double meanHealth = 0;
+    _tournament_aggregate(&t, endings, &meanSteps, &meanHealth);
+    fprintf(stderr, "%zu games on %zu threads, mean steps %.2f, mean health "
+            "%.2f\n", nbGames, nbThreads, meanSteps, meanHealth);
+  }
+
+  // Clear at the end
+  for (size_t i = 0; i < nbGames; ++i) {
+    free(t.gameA[i].playerA);
+  }
+  free(t.gameA);
+  map_delete(&map);
+  config_delete(&config);
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void _tournament_play(tournament_t* pT, size_t i) {
+  tournament_game_t* pRes = &(pT->gameA[i]);
+
+  // Each game plays on its own copy of the map
+  map_t map;
+  if (!map_copy(&map, pT->pMap)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+  config_t config = pT->config;
+  config.seed += i;
+  pRes->seed = config.seed;
+
+  game_t game;
+  pRes->ok = game_init(&game, &config, config.mapFile, &map, 100,
+                       ai_new(ai_random_get_name()), 10,
+                       ai_new(ai_random_get_name()));
+  if (pRes->ok) {
+    game_start(&game);
+
+    pRes->steps = game.steps;
+    pRes->result = game_ending_gm(&game);
+    pRes->nbMinotaur = game.nbMinotaur;
+    pRes->nbMinotaurAlive = game.nbMinotaurAlive;
+    pRes->nbPlayer = game.nbPlayer;
+    pRes->playerA = (tournament_player_t*)malloc(
+        (game.nbPlayer + 1) * sizeof(tournament_player_t));
+    if (pRes->playerA == NULL) {
+      display_fatal_error(stderr, "Error: malloc failed!");
+      exit(EXIT_FAILURE);
+    }
+    for (size_t p = 0; p < game.nbPlayer; ++p) {
+      const character_t* pC = &(game.playerA[p]);
+      pRes->playerA[p].ending = pC->ending;
+      pRes->playerA[p].result = game_ending_player(&game, pC);
+      pRes->playerA[p].health = pC->health;
+    }
+  }
+  // NOTE: the map is cleared with the game
+  game_delete(&game);
+}
+
+void* _tournament_worker(void* arg) {
+  tournament_t* pT = (tournament_t*)arg;
+  bool done = false;
+  while (!done) {
+    pthread_mutex_lock(&(pT->lock));
+    size_t i = pT->next;
+    if (i < pT->nbGames) {
+      ++(pT->next);
+    }
+    pthread_mutex_unlock(&(pT->lock));
+
+    done = (i >= pT->nbGames);
+    if (!done) {
+      _tournament_play(pT, i);
+    }
+  }
+  return NULL;
+}
+
+void _tournament_write_csv(FILE* stream, const tournament_t* pT) {
+  fprintf(stream, "game,seed,steps,result,minotaurs,minotaurs_alive,player,"
+          "ending,player_result,health\n");
+  for (size_t i = 0; i < pT->nbGames; ++i) {
+    const tournament_game_t* pG = &(pT->gameA[i]);
+    for (size_t p = 0; p < pG->nbPlayer; ++p) {
+      const tournament_player_t* pP = &(pG->playerA[p]);
+      fprintf(stream, "%zu,%lu,%d,%s,%zu,%zu,%zu,%s,%s,%.1f\n", i, pG->seed,
+              pG->steps, display_ending_name(pG->result), pG->nbMinotaur,
+              pG->nbMinotaurAlive, p, character_ending_name(pP->ending),
+              display_ending_name(pP->result), pP->health);
+    }
+  }
+}
+
+void _tournament_write_json_string(FILE* stream, const char* s) {
+  fputc('"', stream);
+  for (; *s != '\0'; ++s) {
+    if ((*s == '"') || (*s == '\\')) {
+      fputc('\\', stream);
+    }
+    fputc(*s, stream);
+  }
+  fputc('"', stream);
+}
+
+void _tournament_write_json(FILE* stream, const tournament_t* pT) {
+  fprintf(stream, "{\n  \"map\": ");
+  _tournament_write_json_string(stream, pT->config.mapFile);
+  fprintf(stream, ",\n  \"games\": [");
+  for (size_t i = 0; i < pT->nbGames; ++i) {
+    const tournament_game_t* pG = &(pT->gameA[i]);
+    fprintf(stream,
+            "%s\n    {\"game\": %zu, \"seed\": %lu, \"steps\": %d, "
+            "\"result\": \"%s\", \"minotaurs\": %zu, \"minotaursAlive\": %zu, "
+            "\"players\": [",
+            (i == 0) ? "" : ",", i, pG->seed, pG->steps,
+            display_ending_name(pG->result), pG->nbMinotaur,
+            pG->nbMinotaurAlive);
+    for (size_t p = 0; p < pG->nbPlayer; ++p) {
+      const tournament_player_t* pP = &(pG->playerA[p]);
+      fprintf(stream,
+              "%s{\"ending\": \"%s\", \"result\": \"%s\", \"health\": %.1f}",
+              (p == 0) ? "" : ", ", character_ending_name(pP->ending),
+              display_ending_name(pP->result), pP->health);
+    }
+    fprintf(stream, "]}");
+  }
+
+  size_t endings[TOURNAMENT_NB_ENDINGS];
+  double meanSteps = 0;
+  double meanHealth = 0;
+  _tournament_aggregate(pT, endings, &meanSteps, &meanHealth);
+  fprintf(stream,
+          "\n  ],\n  \"summary\": {\"games\": %zu, \"meanSteps\": %.2f, "
+          "\"meanHealth\": %.2f, \"endings\": {",
+          pT->nbGames, meanSteps, meanHealth);
+  for (size_t e = 0; e < TOURNAMENT_NB_ENDINGS; ++e) {
+    fprintf(stream, "%s\"%s\": %zu", (e == 0) ? "" : ", ",
+            character_ending_name((ending_char_t)e), endings[e]);
+  }
+  fprintf(stream, "}}\n}\n");
+}
+
+void _tournament_aggregate(const tournament_t* pT,
+                           size_t endings[TOURNAMENT_NB_ENDINGS],
+                           double* pMeanSteps,
+                           double* pMeanHealth) {
+  for (size_t e = 0; e < TOURNAMENT_NB_ENDINGS; ++e) {
+    endings[e] = 0;
+  }
+  double steps = 0;
+  double health = 0;
+  size_t nbPlayers = 0;
+  for (size_t i = 0; i < pT->nbGames; ++i) {
+    const tournament_game_t* pG = &(pT->gameA[i]);
+    steps += pG->steps;
+    for (size_t p = 0; p < pG->nbPlayer; ++p) {
+      ++(endings[pG->playerA[p].ending]);
+      health += pG->playerA[p].health;
+      ++nbPlayers;
+    }
+  }
+  *pMeanSteps = (pT->nbGames > 0) ? steps / (double)pT->nbGames : 0;
+  *pMeanHealth = (nbPlayers > 0) ? health / (double)nbPlayers : 0;
+}
+
+void read_parameters(int argc,
+                     char* argv[],
+                     config_t* pConfig,
+                     size_t* pNbGames,
+                     size_t* pNbThreads,
+                     bool* pJson,
+                     const char** pOutput) {
+  /* Parameters parsing */
+  int c = 0;
+  int errflg = 0;
+  int mandatory = 0;
+  unsigned long tmp = 0;
+
+  while ((c = getopt(argc, argv, "hglm:M:n:j:s:f:o:")) != -1) {
+    switch (c) {
+      case 'h':  // help.
+        usage();
+        exit(EXIT_SUCCESS);
+        break;
+      case 'm':  // map file.
+        pConfig->mapFile = optarg;
+        ++mandatory;
+        break;
+      case 'M':  // max moves for players.
+        tmp = strtoul(optarg, NULL, 0);
+        if (tmp > INT_MAX) {
+          ++errflg;
+        }
+        pConfig->maxMoves = (int)tmp;
+        break;
+      case 'g':  // maze-aware GPS.
+        pConfig->mazeGps = true;
+        break;
+      case 'l':  // loop-erased Ariadne strings.
+        pConfig->eraseLoops = true;
+        break;
+      case 'n':  // number of games.
+        *pNbGames = strtoul(optarg, NULL, 0);
+        break;
+      case 's':  // seed of the first game.
+        pConfig->seed = strtoul(optarg, NULL, 0);
+        break;
+      case 'j':  // number of threads.
+        *pNbThreads = strtoul(optarg, NULL, 0);
+        break;
+      case 'f':  // report format.
+        if (strcmp(optarg, "json") == 0) {
+          *pJson = true;
+        } else if (strcmp(optarg, "csv") == 0) {
+          *pJson = false;
+        } else {
+          ++errflg;
+        }
+        break;
+      case 'o':  // report file.
+        *pOutput = optarg;
+        break;
+      case ':': /* option without operand */
+        fprintf(stderr, "Option -%c requires an operand\n", optopt);
+        ++errflg;
+        break;
+      case '?':
+        fprintf(stderr, "Unrecognized option: -%c\n", optopt);
+        ++errflg;
+    }
+  }
+  if (mandatory != 1) {
+    fprintf(stderr, "ERROR: mandatory option is missing (-m).\n");
+    ++errflg;
+  }
+
+  if (errflg) {
+    usage();
+    exit(EXIT_FAILURE);
+  }
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: ./DedalusTournament [-h] -m arg [-n arg] [-j arg] [-s arg] "
+          "[-M arg] [-g] [-l] [-f csv|json] [-o arg]\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Options: \n");
+  fprintf(stderr, "\t -m arg \t (Mandatory) file of the map.\n");
+  fprintf(stderr, "\t -n arg \t [100] Number of games.\n");
+  fprintf(stderr, "\t -j arg \t [0] Number of threads (0: all cores).\n");
+  fprintf(stderr,
+          "\t -s arg \t [time] Seed of the first game (+1 for each game).\n");
+  fprintf(stderr, "\t -M arg \t [1000] Maximum number of steps for players.\n");
+  fprintf(stderr,
+          "\t -g     \t [false] Maze-aware GPS (path distance to target).\n");
+  fprintf(stderr,
+          "\t -l     \t [false] Erase loops from the Ariadne strings.\n");
+  fprintf(stderr, "\t -f arg \t [csv] Report format (csv or json).\n");
+  fprintf(stderr, "\t -o arg \t [stdout] Report file.\n");
+  fprintf(stderr, "\t -h     \t Display this message.	\n");
+}
@@ -13,6 +13,7 @@
 #include "ai.h"
 #include "ai/ai_random.h"
 #include "ai/ai_shall_not_pass.h"
+#include "ai/ai_wall_follower.h"
 
 ai_t ai_new(const char* name) {
   ai_t res;
@@ -21,6 +22,8 @@ ai_t ai_new(const char* name) {
     res = ai_random_new();
   } else if (strncmp(name, ai_shall_not_pass_get_name(), len) == 0) {
     res = ai_shall_not_pass_new();
+  } else if (strncmp(name, ai_wall_follower_get_name(), len) == 0) {
+    res = ai_wall_follower_new();
   } else {
     res = ai_shall_not_pass_new();
   }
@@ -10,9 +10,6 @@
  */
 
 #include <stdbool.h>  // bool, true, false
-#include <stdlib.h>   // rand
-#include <time.h>     // time
-#include <unistd.h>   // usleep
 
 #include "ai_random.h"
 
@@ -26,6 +23,7 @@
  * @param[in] comp Unused parameter.
  * @param[in] distance Unused parameter.
  * @param[in] ariane Unused parameter.
+ * @param[in,out] rng Random generator of the character.
  * @return compass_t The selected direction.
  */
 compass_t _ai_random_policy(bool north,
@@ -34,18 +32,13 @@ compass_t _ai_random_policy(bool north,
                             bool west,
                             compass_t comp,
                             float distance,
-                            string ariane) {
+                            string ariane,
+                            rng_t* rng) {
   // remove unused param
   (void)comp;
   (void)distance;
   (void)ariane;
 
-  // reinit the srand
-  srand((unsigned int) (time(NULL) * getpid() * rand()));
-
-  // Random thinking
-  usleep((unsigned int) ((rand() % 100) * 1000));
-
   if (!north && !east && !south && !west) {
     return Stay;
   }
@@ -54,7 +47,7 @@ compass_t _ai_random_policy(bool north,
   bool ok = false;
 
   do {
-    switch (rand() % 4) {
+    switch (rng_below(rng, 4)) {
       case 0:
         move = North;
         ok = north;
@@ -86,6 +79,7 @@ const char* ai_random_get_name() {
 ai_t ai_random_new() {
   ai_t res;
   res.policy = &_ai_random_policy;
+  res.coroutine = NULL;
   res.name = ai_random_get_name();
   return res;
 }
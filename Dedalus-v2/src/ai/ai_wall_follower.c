@@ -0,0 +1,104 @@
+/**
+ * @file ai_wall_follower.c
+ * @brief Artificial Intelligence following the wall on its right hand.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdbool.h>  // bool, true, false
+
+#include "aiCoroutine.h"
+#include "ai_wall_follower.h"
+#include "gps.h"  // compass_t
+
+/**
+ * @brief Turn right if possible, else go ahead, else turn left, else go back.
+ *
+ * @param[in] north Is it possible to go north?
+ * @param[in] east Is it possible to go east?
+ * @param[in] south Is it possible to go south?
+ * @param[in] west Is it possible to go west?
+ * @param[in] heading Direction of the last move (North, East, South or West).
+ * @return compass_t The selected direction (Stay if walled in).
+ */
+compass_t _ai_wall_follower_turn(bool north,
+                                 bool east,
+                                 bool south,
+                                 bool west,
+                                 compass_t heading) {
+  const bool openA[8] = {north, false, east, false, south, false, west, false};
+  // Right, ahead, left and back (a quarter turn is two compass points)
+  const int turnA[4] = {2, 0, 6, 4};
+  for (size_t i = 0; i < 4; ++i) {
+    compass_t move = (compass_t)(((int)heading + turnA[i]) % 8);
+    if (openA[move]) {
+      return move;
+    }
+  }
+  return Stay;
+}
+
+/**
+ * @brief Follow the wall from the direction of the target (no memory).
+ *
+ * @param[in] north Is it possible to go north?
+ * @param[in] east Is it possible to go east?
+ * @param[in] south Is it possible to go south?
+ * @param[in] west Is it possible to go west?
+ * @param[in] comp Direction of the target.
+ * @param[in] distance Unused parameter.
+ * @param[in] ariane Unused parameter.
+ * @param[in,out] rng Unused parameter.
+ * @return compass_t The selected direction.
+ */
+compass_t _ai_wall_follower_policy(bool north,
+                                   bool east,
+                                   bool south,
+                                   bool west,
+                                   compass_t comp,
+                                   float distance,
+                                   string ariane,
+                                   rng_t* rng) {
+  // remove unused param
+  (void)distance;
+  (void)ariane;
+  (void)rng;
+
+  // The diagonals are rounded counterclockwise
+  compass_t heading = (comp == Stay) ? North : (compass_t)((int)comp / 2 * 2);
+  return _ai_wall_follower_turn(north, east, south, west, heading);
+}
+
+/**
+ * @brief Follow the wall, remembering the heading between the steps.
+ *
+ * @param[in,out] pCo The coroutine of the AI.
+ */
+void _ai_wall_follower_body(coro_t* pCo) {
+  compass_t heading = North;  // kept from one step to the next
+  const coro_view_t* pView = coro_view(pCo);
+  while (true) {
+    compass_t move = _ai_wall_follower_turn(pView->north, pView->east,
+                                            pView->south, pView->west,
+                                            heading);
+    if (move != Stay) {
+      heading = move;
+    }
+    pView = coro_yield(pCo, move);
+  }
+}
+
+const char* ai_wall_follower_get_name() {
+  return "Wall Follower";
+}
+
+ai_t ai_wall_follower_new() {
+  ai_t res;
+  res.policy = &_ai_wall_follower_policy;
+  res.coroutine = &_ai_wall_follower_body;
+  res.name = ai_wall_follower_get_name();
+  return res;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file ai_wall_follower.h
+ * @brief Artificial Intelligence following the wall on its right hand.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#ifndef AI_WALL_FOLLOWER_H
+#define AI_WALL_FOLLOWER_H
+
+#include "../ai.h"
+
+/**
+ * @brief Get the name of the wall follower AI class.
+ *
+ * @return const char* The name of the AI.
+ */
+const char* ai_wall_follower_get_name();
+
+/**
+ * @brief Create a new AI that keeps its right hand on a wall.
+ *
+ * @return ai_t The new AI.
+ *
+ * Its heading is a local of its coroutine body, kept from one step to the
+ * next by the coroutines backend. The other backends call its policy, which
+ * does not remember anything and heads to the target instead.
+ */
+ai_t ai_wall_follower_new();
+
+#endif  // End of AI_WALL_FOLLOWER_H
@@ -13,12 +13,74 @@
 #include "display.h"
 #include "gps.h"
 
+#include <stdint.h>  // SIZE_MAX
 #include <stdio.h>   // printf
-#include <stdlib.h>  // malloc, rand, srand
-#include <string.h>  // strcpy, strlen
+#include <stdlib.h>  // malloc, realloc, free
+
+/**
+ * @brief Number of moves of the first buffer of a string.
+ *
+ */
+#define STRING_FIRST_CAPACITY 64
+
+/**
+ * @brief Size of the first depth table of a string erasing its loops.
+ *
+ */
+#define STRING_FIRST_DEPTH_CAPACITY 128
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Get a move of the string, starting from the first move made.
+ *
+ * @param[in] s The string.
+ * @param[in] k Index of the move (0 for the first move made).
+ * @return compass_t The move.
+ */
+compass_t _string_get(const string s, size_t k);
+
+/**
+ * @brief Double the capacity of a string (its cells too with loop erasure).
+ *
+ * @param[in, out] pS The string.
+ * @return true Modification ok.
+ * @return false Internal error. Operation failed.
+ */
+bool _string_grow(string* pS);
+
+/**
+ * @brief Find the slot of a cell in the depth table.
+ *
+ * @param[in] s The string (with loop erasure).
+ * @param[in] cell Index of the cell in the map.
+ * @return size_t The slot of the cell, or the free slot where it would go.
+ */
+size_t _string_depth_slot(const string s, size_t cell);
+
+/**
+ * @brief Rebuild the depth table with a new size.
+ *
+ * @param[in, out] pS The string (with loop erasure).
+ * @param[in] capacity New size of the table (a power of two).
+ * @return true Modification ok.
+ * @return false Internal error. Operation failed.
+ */
+bool _string_depth_resize(string* pS, size_t capacity);
+
+/**********************************/
+//  Public functions implementation
 
 string string_new() {
-  return NULL;
+  string s;
+  s.moves = NULL;
+  s.size = 0;
+  s.capacity = 0;
+  s.cellA = NULL;
+  s.depthTable = NULL;
+  s.depthCapacity = 0;
+  return s;
 }
 
 void string_delete(string* pS) {
@@ -26,49 +88,55 @@ void string_delete(string* pS) {
     // error
     return;
   }
-  while (*pS != NULL) {
-    link_t* pHead = *pS;
-    *pS = pHead->next;
-    free(pHead);
-  }
+  free(pS->moves);
+  free(pS->cellA);
+  free(pS->depthTable);
+  *pS = string_new();
 }
 
 bool string_remove_link(string* pS) {
-  string plink = *pS;
-
-  if (*pS == NULL) {
+  if (pS->size == 0) {
     return false;
   }
 
-  *pS = (*pS)->next;
-  free(plink);
+  // The buffer is kept for the next moves
+  if (pS->cellA != NULL) {
+    // Cells are removed in the reverse order of their insertion, so no probe
+    // sequence goes through the freed slot.
+    pS->depthTable[_string_depth_slot(*pS, pS->cellA[pS->size])] = SIZE_MAX;
+  }
+  --(pS->size);
   return true;
 }
 
 bool string_add_link(string* pS, compass_t c) {
-  string plink = (string)malloc(sizeof(link_t));
-
-  if (plink == NULL) {
+  if ((pS->size == pS->capacity) && !_string_grow(pS)) {
     return false;
   }
 
-  plink->c = c;
-  plink->next = *pS;
-  *pS = plink;
+  unsigned char* pByte = &(pS->moves[pS->size / 2]);
+  if (pS->size % 2 == 0) {
+    *pByte = (unsigned char)c;
+  } else {
+    *pByte = (unsigned char)((*pByte & 0x0F) | ((unsigned)c << 4));
+  }
+  ++(pS->size);
   return true;
 }
 
 bool string_can_go_back(const string s) {
   bool res = false;
 
-  if (string_size(s) >= 2) {
-    if (s->c == North && (s->next)->c == South) {
+  if (s.size >= 2) {
+    compass_t last = _string_get(s, s.size - 1);
+    compass_t previous = _string_get(s, s.size - 2);
+    if (last == North && previous == South) {
       res = true;
-    } else if (s->c == South && (s->next)->c == North) {
+    } else if (last == South && previous == North) {
       res = true;
-    } else if (s->c == East && (s->next)->c == West) {
+    } else if (last == East && previous == West) {
       res = true;
-    } else if (s->c == West && (s->next)->c == East) {
+    } else if (last == West && previous == East) {
       res = true;
     }
   }
@@ -77,13 +145,104 @@ bool string_can_go_back(const string s) {
 }
 
 size_t string_size(const string s) {
-  size_t size = 0;
-  string tmp = s;
+  return s.size;
+}
+
+compass_t string_move(const string s, size_t i) {
+  return _string_get(s, s.size - 1 - i);
+}
 
-  while (tmp != NULL) {
-    ++size;
-    tmp = tmp->next;
+bool string_erase_loops_init(string* pS, size_t cell) {
+  if ((pS->capacity == 0) && !_string_grow(pS)) {
+    return false;
+  }
+  pS->cellA = (size_t*)malloc((pS->capacity + 1) * sizeof(size_t));
+  if (pS->cellA == NULL) {
+    return false;
+  }
+  pS->cellA[0] = cell;
+  return _string_depth_resize(pS, STRING_FIRST_DEPTH_CAPACITY);
+}
+
+bool string_erases_loops(const string s) {
+  return s.cellA != NULL;
+}
+
+bool string_walk(string* pS, compass_t c, size_t cell) {
+  size_t slot = _string_depth_slot(*pS, cell);
+  if (pS->depthTable[slot] != SIZE_MAX) {
+    // Back on the string: cut the loop (a Stay is an empty loop)
+    size_t depth = pS->depthTable[slot];
+    while (pS->size > depth) {
+      string_remove_link(pS);
+    }
+    return true;
+  }
+
+  // Keep the load factor of the table under 1/2
+  if ((2 * (pS->size + 2) > pS->depthCapacity) &&
+      !_string_depth_resize(pS, 2 * pS->depthCapacity)) {
+    return false;
+  }
+  if (!string_add_link(pS, c)) {
+    return false;
+  }
+  pS->cellA[pS->size] = cell;
+  pS->depthTable[_string_depth_slot(*pS, cell)] = pS->size;
+  return true;
+}
+
+/**********************************/
+//  Local functions implementation
+
+compass_t _string_get(const string s, size_t k) {
+  unsigned char byte = s.moves[k / 2];
+  return (compass_t)((k % 2 == 0) ? (byte & 0x0F) : (byte >> 4));
+}
+
+bool _string_grow(string* pS) {
+  size_t capacity =
+      (pS->capacity == 0) ? STRING_FIRST_CAPACITY : 2 * pS->capacity;
+  unsigned char* moves = (unsigned char*)realloc(pS->moves, (capacity + 1) / 2);
+  if (moves == NULL) {
+    return false;
   }
+  pS->moves = moves;
+  if (pS->cellA != NULL) {
+    size_t* cellA =
+        (size_t*)realloc(pS->cellA, (capacity + 1) * sizeof(size_t));
+    if (cellA == NULL) {
+      return false;
+    }
+    pS->cellA = cellA;
+  }
+  pS->capacity = capacity;
+  return true;
+}
 
-  return size;
+size_t _string_depth_slot(const string s, size_t cell) {
+  size_t mask = s.depthCapacity - 1;
+  size_t h = (cell * 0x9E3779B97F4A7C15ull) & mask;
+  while ((s.depthTable[h] != SIZE_MAX) && (s.cellA[s.depthTable[h]] != cell)) {
+    h = (h + 1) & mask;
+  }
+  return h;
+}
+
+bool _string_depth_resize(string* pS, size_t capacity) {
+  size_t* depthTable = (size_t*)malloc(capacity * sizeof(size_t));
+  if (depthTable == NULL) {
+    return false;
+  }
+  free(pS->depthTable);
+  pS->depthTable = depthTable;
+  pS->depthCapacity = capacity;
+  for (size_t h = 0; h < capacity; ++h) {
+    pS->depthTable[h] = SIZE_MAX;
+  }
+  // Insert by increasing depth, as string_remove_link expects
+  for (size_t depth = 0; depth <= pS->size; ++depth) {
+    pS->depthTable[_string_depth_slot(*pS, pS->cellA[depth])] = depth;
+  }
+  return true;
 }
@@ -222,7 +222,7 @@ character_t character_init(map_content_t type,
   c.targetCompass = Stay;
   c.targetDistance = 0;
 
-  c.ariadne = NULL;
+  c.ariadne = string_new();
   c.ai = ai;
   c.walkOn = PATH;
 
@@ -260,10 +260,12 @@ character_t character_init(map_content_t type,
   c.ending = EC_NO_ENDING;
 
   c.pMask = NULL;
+  rng_seed(&(c.rng), 0, 0);  // NOTE: seeded by the game
+  c.nbOverrun = 0;
   return c;
 }
 
-compass_t character_propose_move(const character_t* pC,
+compass_t character_propose_move(character_t* pC,
                                  const map_t* pMap,
                                  bool* pCheated) {
   bool goNorth = _character_can_go(*pMap, pC->pos, North);
@@ -273,11 +275,40 @@ compass_t character_propose_move(const character_t* pC,
 
   compass_t move =
       (*(pC->ai.policy))(goNorth, goEast, goSouth, goWest, pC->targetCompass,
-                         pC->targetDistance, pC->ariadne);
+                         pC->targetDistance, pC->ariadne, &(pC->rng));
   *pCheated = !_character_is_valid_move(move, goNorth, goEast, goSouth, goWest);
   return move;
 }
 
+bool character_can_go(const character_t* pC, const map_t* pMap, compass_t c) {
+  return _character_can_go(*pMap, pC->pos, c);
+}
+
+bool character_is_valid_move(const character_t* pC,
+                             const map_t* pMap,
+                             compass_t move) {
+  bool goNorth = _character_can_go(*pMap, pC->pos, North);
+  bool goEast = _character_can_go(*pMap, pC->pos, East);
+  bool goSouth = _character_can_go(*pMap, pC->pos, South);
+  bool goWest = _character_can_go(*pMap, pC->pos, West);
+
+  return _character_is_valid_move(move, goNorth, goEast, goSouth, goWest);
+}
+
+void character_record_move(character_t* pC,
+                           const map_t* pMap,
+                           compass_t move) {
+  if (string_erases_loops(pC->ariadne)) {
+    string_walk(&(pC->ariadne), move, pC->pos.y * pMap->x + pC->pos.x);
+  } else {
+    if (string_can_go_back(pC->ariadne)) {
+      string_remove_link(&(pC->ariadne));
+      string_remove_link(&(pC->ariadne));
+    }
+    string_add_link(&(pC->ariadne), move);
+  }
+}
+
 void character_play(character_t* pC,
                     compass_t move,
                     pos_t targetPos,
@@ -288,12 +319,7 @@ void character_play(character_t* pC,
   (void)steps;  // Unused;
 
   _character_make_move(pMap, pC, move, pExited);
-
-  if (string_can_go_back(pC->ariadne)) {
-    string_remove_link(&(pC->ariadne));
-    string_remove_link(&(pC->ariadne));
-  }
-  string_add_link(&(pC->ariadne), move);
+  character_record_move(pC, pMap, move);
 
   // Update info
   gps_direction(pC->pos, targetPos, &(pC->targetCompass),
@@ -325,6 +351,28 @@ void character_is_out(map_t* pMap, character_t* pC) {
   pMap->m[pC->pos.y][pC->pos.x] = EXIT;
 }
 
+const char* character_ending_name(ending_char_t ending) {
+  switch (ending) {
+    case EC_NO_ENDING:
+      return "no_ending";
+    case EC_KILL_BY_M:
+      return "kill_by_minotaur";
+    case EC_STARVE_MINOTAUR:
+      return "starve_minotaur";
+    case EC_STARVE_NO_MINOTAUR:
+      return "starve_no_minotaur";
+    case EC_CHEAT_MINOTAUR:
+      return "cheat_minotaur";
+    case EC_CHEAT_NO_MINOTAUR:
+      return "cheat_no_minotaur";
+    case EC_ESCAPE:
+      return "escape";
+    case EC_WIN:
+      return "win";
+  }
+  return "unknown";
+}
+
 void character_delete(map_t* pMap, character_t* pC) {
   pC->name = NULL;
   pC->id = -1;
@@ -32,6 +32,18 @@ config_t config_init() {
   conf.delay = 100000;
   conf.interactive = true;
   conf.maxMoves = 1000;
+  conf.eraseLoops = false;
+  conf.backend = BACKEND_WORKERS;
+  conf.nbThreads = 0;
+  conf.moveTimeout = 1000;
+  conf.moveClock = BUDGET_WALL;
+  conf.overrun = OVERRUN_STAY;
+  conf.headless = false;
+  conf.bench = false;
+  conf.profile = false;
+  conf.traceFile = NULL;
+  conf.thinking = true;
+  conf.seed = 0;
 
   conf.displayPidA = NULL;
   conf.nbDisplay = 0;
@@ -14,6 +14,8 @@
 #include <stdbool.h>    // bool, true, false
 #include <sys/types.h>  // pid_t
 
+#include "moveOptions.h"  // backend_t, budget_clock_t, overrun_t
+
 // Configuration
 extern const bool
     COLOR;  ///< Game in vintage colors if true and in B&W otherwise
@@ -32,9 +34,22 @@ typedef struct config {
   bool debug;     ///< Display in debug mode (no cleaning)?
   bool gameInfo;  ///< Display more game informations?
 
-  int delay;         ///< Time (in us) between frames.
-  bool interactive;  ///< Ask for interactive actions from GM.
-  int maxMoves;      ///< Maximum number of moves for players.
+  int delay;           ///< Time (in us) between frames.
+  bool interactive;    ///< Ask for interactive actions from GM.
+  int maxMoves;        ///< Maximum number of moves for players.
+  bool eraseLoops;     ///< Ariadne strings without loops.
+  backend_t backend;   ///< How the AIs are asked for their moves.
+  size_t nbThreads;    ///< Threads asking AIs for moves (0: one per CPU).
+  int moveTimeout;     ///< Time (in ms) given to an AI for a move.
+  bool thinking;       ///< Simulate AIs thinking time (display only).
+  unsigned long seed;  ///< Seed of the random generators of the game.
+  bool headless;       ///< No display, no terminal nor delay (batch runs).
+  bool bench;          ///< Play the game with each backend (see backend_t).
+  bool profile;            ///< Time the phases of the steps.
+  const char* traceFile;   ///< Where to trace the steps (NULL for none).
+
+  budget_clock_t moveClock;  ///< Clock measuring the time of a move.
+  overrun_t overrun;         ///< Penalty of an AI too slow for a move.
 
   size_t nbDisplay;    ///< Number of display for players.
   pid_t* displayPidA;  ///< Array of pid of terminals to display players.
@@ -444,11 +444,9 @@ void _display_map(FILE* stream, const map_t* pMap, const map_t* pMask) {
 }
 
 void _display_string(FILE* stream, const string s) {
-  string tS = s;
   fprintf(stream, "%s", _display_player_to_string());
-  while (tS != NULL) {
-    fprintf(stream, "-%s", gps_compass_to_string(tS->c));
-    tS = tS->next;
+  for (size_t i = 0; i < string_size(s); ++i) {
+    fprintf(stream, "-%s", gps_compass_to_string(string_move(s, i)));
   }
 }
 
@@ -923,6 +921,28 @@ void display_ending(FILE* stream, ending_t ending) {
   }
 }
 
+const char* display_ending_name(ending_t ending) {
+  switch (ending) {
+    case EG_LOOSE:
+      return "loose";
+    case EG_NEXT_LEVEL_AND_ALIVE:
+      return "next_level_and_alive";
+    case EG_NEXT_LEVEL_BUT_DEAD:
+      return "next_level_but_dead";
+    case EG_WIN_AND_ALIVE:
+      return "win_and_alive";
+    case EG_KILL_MINOTAUR_BUT_DEAD:
+      return "kill_minotaur_but_dead";
+    case EG_WIN_BUT_DEAD:
+      return "win_but_dead";
+    case EG_GM_WIN:
+      return "gm_win";
+    case EG_GM_LOOSE:
+      return "gm_loose";
+  }
+  return "unknown";
+}
+
 void display_fight_iteration(const map_t* pMap,
                              const character_t* pC1,
                              const character_t* pC2,
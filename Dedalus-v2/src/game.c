@@ -10,13 +10,15 @@
  *
  */
 
-#include <stdio.h>   // printf
+#include <stdint.h>  // UINT64_MAX
+#include <stdio.h>   // printf, snprintf
 #include <string.h>  // strcpy, strlen
 #include <unistd.h>  // usleep
 
-#include "display.h"  // outputs of the game
-#include "game.h"     // public defintions
-#include "gps.h"      // pos_t
+#include "display.h"     // outputs of the game
+#include "game.h"        // public defintions
+#include "gps.h"         // pos_t
+#include "moveSolver.h"  // conflicts of the moves
 #include <sys/types.h>
 #include <sys/wait.h>
 
@@ -24,16 +26,6 @@
 /**********************************/
 // Declaration of local functions.
 
-/**
- * @brief Structure to store moves propositions.
- *
- */
-typedef struct moves_prop {
-  character_t* c;  ///< Pointer to the character concerned.
-  compass_t move;  ///< The move proposition
-  bool cheated;    ///< Is this a cheat move.
-} moves_prop_t;
-
 /**
  * @brief Initialize a moves propositions array.
  *
@@ -46,34 +38,6 @@ void _game_init_moves_prop(const game_t* pGame,
                            moves_prop_t** pMoves,
                            size_t* pNbChar);
 
-/**
- * @brief Get all moves propositions for each character.
- *
- * @param[in] pGame The game considered.
- * @param[in,out] pMoves An initialized vector of propositions.
- * @param[in] nbChar Number of character considered.
- * @note The array pMoves must be initialized before the call.
- */
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar);
-
-/**
- * @brief Solve conflicts between an array of move propositions.
- *
- * @param[in] pGame The game considered.
- * @param[in,out] moves The array of moves propositions to clear.
- * @param[in] nbChar Number of character considered.
- *
- * The "moves" arrays will be cleaned to remove conflicts.
- * A conflict occurs when two characters want to go at the same position.
- * In this version only one character will move (players firsts and in order
- * of declaration after).
- */
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar);
-
 /**
  * @brief Set a character as dead for this game.
  *
@@ -173,6 +137,14 @@ void _game_play_characters(game_t* pGame,
  */
 void _game_play_refresh_ui(const game_t* pGame);
 
+/**
+ * @brief Turn on loop erasure for the Ariadne string of a character.
+ *
+ * @param[in] pMap The map.
+ * @param[in,out] pC The character (at its start position).
+ */
+void _game_erase_loops_init(const map_t* pMap, character_t* pC);
+
 /**
  * @brief Compute the end game status (win or loose) for the game master.
  *
@@ -193,6 +165,14 @@ ending_t _game_ending_gm(const game_t* pGame);
  */
 ending_t _game_ending_player(const game_t* pGame, const character_t* pC);
 
+/**
+ * @brief Print the AIs that were out of time (nothing if none was).
+ *
+ * @param[in,out] stream Where to print.
+ * @param[in] pGame The game.
+ */
+void _game_report_overruns(FILE* stream, const game_t* pGame);
+
 /*****************************/
 // Functions implementation.
 
@@ -211,12 +191,14 @@ void _game_init_moves_prop(const game_t* pGame,
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     (*pMoves)[i].c = &(pGame->playerA[i]);
     (*pMoves)[i].cheated = false;
+    (*pMoves)[i].overrun = false;
     (*pMoves)[i].move = Stay;
   }
   size_t offset = pGame->nbPlayer;
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
     (*pMoves)[i + offset].c = &(pGame->minotaurA[i]);
     (*pMoves)[i + offset].cheated = false;
+    (*pMoves)[i + offset].overrun = false;
     (*pMoves)[i + offset].move = Stay;
   }
 }
@@ -262,13 +244,25 @@ bool _game_should_fight(const character_t* pC1, const character_t* pC2) {
 void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   size_t i = 0;
   while ((pC1->health > 0) && (pC2->health > 0)) {
-    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
-    usleep((unsigned int)pGame->delay);
+    if (!pGame->headless) {
+      if (i == 0) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+        // The introduction is an animation of its own
+        pacer_resume(&(pGame->pacer));
+      } else if (pacer_frame(&(pGame->pacer))) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+      }
+      pacer_wait(&(pGame->pacer));
+    }
     ++i;
     --(pC1->health);
     --(pC2->health);
   }
-  display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  if (!pGame->headless) {
+    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  }
   
   if (pC1->health <= 0) {
     _game_death_caractere(pGame, pC1);
@@ -277,8 +271,12 @@ void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   if (pC2->health <= 0) {
     _game_death_caractere(pGame, pC2);
   }
+  if (pGame->headless) {
+    return;
+  }
   display_wait_user(DISPLAY, "Press any key to continue...",
                     pGame->interactive);
+  pacer_resume(&(pGame->pacer));
   
   // refresh display
   display_fight_clear(pC1->stream);
@@ -349,156 +347,6 @@ pos_t _game_character_target(game_t* pGame, const character_t* pC) {
   }
   return target;
 }
-/*  Version avec Waitpid avec gain de vitesse BOI */
-
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar) {
-  pid_t pid[nbChar];
-  //printf("nbChar : %d\n",(int)nbChar);
-  compass_t move;
-  bool cheated;
-  int status;
-  for (size_t i=0;i < nbChar;i++) {
-    character_t* pC = pMoves[i].c;
-    
-    pid[i]=fork();
-    if(pid[i]==-1){
-      printf("ggmp failed \n");
-      exit(EXIT_FAILURE);
-    }
-    if(pid[i]==0){
-    //  printf("i : %d\n",(int)i); 
-      move = character_propose_move(pC, pGame->pMap, &cheated);
-      move=(int)move+cheated*10;
-      exit(move);
-    }
-  }
-  for(size_t i=0;i < nbChar;i++){
-      //printf("i : %d\n",(int)i); 
-      waitpid(pid[i],&status,0);
-      if(WIFEXITED(status)){
-        
-        status=WEXITSTATUS(status);
-        //printf("status : %d\n",status);
-        pMoves[i].move=status%10;
-        pMoves[i].cheated=status/10;
-        //printf("move : %d cheated : %d\n",pMoves[i].move,pMoves[i].cheated);
-      }
-    }
-}
-
-/* Version avec Wait sans gain de vitesse  */
-/*
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar) {
-  pid_t pid[nbChar];
-  //printf("nbChar : %d\n",(int)nbChar);
-  compass_t move;
-  bool cheated;
-  int status;
-  for (size_t i=0;i < nbChar;i++) {
-    character_t* pC = pMoves[i].c;
-    
-    pid[i]=fork();
-    if(pid[i]==-1){
-      printf("ggmp failed \n");
-      exit(EXIT_FAILURE);
-    }
-    if(pid[i]==0){
-      //  printf("i : %d\n",(int)i); 
-      move = character_propose_move(pC, pGame->pMap, &cheated);
-      move=(int)move+cheated*10;
-      exit(move);
-    }
-  }
-    for(size_t i=0;i < nbChar;i++){
-      //printf("i : %d\n",(int)i); 
-        wait(&status);
-        if(WIFEXITED(status)){
-        status=WEXITSTATUS(status);
-        //printf("status : %d\n",status);
-        pMoves[i].move=status%10;
-        pMoves[i].cheated=status/10;
-        //printf("move : %d cheated : %d\n",pMoves[i].move,pMoves[i].cheated);
-      }
-    }
-  }
-*/
-
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar) {
-  (void)pGame;  // unused
-  
-  // Solve all conflicts
-  bool conflictFound = false;
-  do {
-    pos_t* usedPositions = NULL;
-    size_t nbPosUsed = 0;
-    // Fix position of staying char
-    for (size_t i = 0; i < nbChar; ++i) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      if ((moves[i].move == Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // reserve position. We are sure there is no conflict.
-        ++nbPosUsed;
-        usedPositions =
-        (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        usedPositions[nbPosUsed - 1] = pC->pos;
-      }
-    }
-    
-    // Search conflict for others but stop at first conflict
-    // Just one conflict at a time in order to be sure that refusing a move for
-    // a character will not create another conflict.
-    conflictFound = false;
-    size_t i = 0;
-    while ((!conflictFound) && (i < nbChar)) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      // We only consider moving characters since those staying are already
-      // managed.
-      if ((moves[i].move != Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // Compute target position
-        pos_t nextPos = gps_compute_move(pC->pos, moves[i].move);
-        
-        // Check if we have a conflict
-        size_t j = 0;
-        while ((!conflictFound) && (j < nbPosUsed)) {
-          conflictFound = ((usedPositions[j].x == nextPos.x) &&
-            (usedPositions[j].y == nextPos.y));
-          ++j;
-        }
-        ++nbPosUsed;
-        usedPositions =
-        (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        if (conflictFound) {
-          moves[i].move = Stay;
-          usedPositions[nbPosUsed - 1] = pC->pos;
-        } else {
-          // Reserve the position
-          usedPositions[nbPosUsed - 1] = nextPos;
-        }
-      }
-      ++i;
-    }
-    
-    free(usedPositions);
-  } while (conflictFound);
-}
-
 void _game_play_character(game_t* pGame,
                           character_t* pC,
                           compass_t move,
@@ -555,7 +403,9 @@ void _game_play_characters(game_t* pGame,
 }
 
 void _game_play_refresh_ui(const game_t* pGame) {
-  // Play all characters
+  if (pGame->headless) {
+    return;
+  }
   
   // Display current state for game master
   display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
@@ -597,6 +447,31 @@ ending_t _game_ending_player(const game_t* pGame, const character_t* pC) {
   return ending;
 }
 
+void _game_report_overruns(FILE* stream, const game_t* pGame) {
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+}
+
+void _game_erase_loops_init(const map_t* pMap, character_t* pC) {
+  if (!string_erase_loops_init(&(pC->ariadne),
+                               pC->pos.y * pMap->x + pC->pos.x)) {
+    display_fatal_error(stderr, "Error: malloc failed!");
+    exit(EXIT_FAILURE);
+  }
+}
+
 /**********************************/
 // Public functions implementations.
 
@@ -614,7 +489,20 @@ bool game_init(game_t* pGame,
   pGame->gameInfo = pConf->gameInfo;
   pGame->steps = 0;
   pGame->delay = pConf->delay;
-  pGame->interactive = pConf->interactive;
+  pGame->interactive = pConf->interactive && !pConf->headless;
+  pGame->headless = pConf->headless;
+  pGame->thinking = pConf->thinking;
+  pGame->seed = pConf->seed;
+  // One stream per generator: 2i for player i, 2i+1 for Minotaur i and the
+  // last one for thinking times.
+  rng_seed(&(pGame->thinkRng), pGame->seed, UINT64_MAX >> 1);
+  budget_t budget;
+  budget.ms = pConf->moveTimeout;
+  budget.clock = pConf->moveClock;
+  backend_init(&(pGame->backend), pConf->backend, pConf->nbThreads, &budget,
+               pConf->overrun);
+  pGame->pProfiler = NULL;
+  pacer_start(&(pGame->pacer), pGame->headless ? 0 : pGame->delay);
   
   bool ok = true;
   
@@ -638,6 +526,10 @@ bool game_init(game_t* pGame,
     pGame->minotaurA[i] = character_init(MINOTAUR, (pid_t)(-i - 1), false,
                                          "Minotaur", mDefHealth, mAi);
     pGame->minotaurA[i].pos = mAPos[i];
+    rng_seed(&(pGame->minotaurA[i].rng), pGame->seed, 2 * i + 1);
+    if (pConf->eraseLoops) {
+      _game_erase_loops_init(pMap, &(pGame->minotaurA[i]));
+    }
     pGame->minotaurA[i].pMask = map_mask_init(pMap);
     map_mask_add(pGame->minotaurA[i].pMask, mAPos[i]);
     
@@ -659,28 +551,36 @@ bool game_init(game_t* pGame,
   config_t config=config_init(); //-------------------------
   pid_t display[pGame->nbPlayer]; //------------------------------------
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    // Get the display to use with this player.
-    usleep((unsigned int)pGame->delay);
-    display[i]=fork();
-    if(display[i]==-1){
-      return EXIT_FAILURE;
-    }
-    if(display[i]==0){
-      char geometry[20];
-      if(i<4){
-        sprintf(geometry,"80x23+%d+0",(int)(i%4)*400);
-      }else{
-        sprintf(geometry,"80x23+%d-0",(int)(i%4)*400);
+    // No terminal in batch mode
+    display[i] = (pid_t)(-i - 1);
+    if (!pGame->headless) {
+      // Get the display to use with this player.
+      usleep((unsigned int)pGame->delay);
+      display[i]=fork();
+      if(display[i]==-1){
+        return EXIT_FAILURE;
+      }
+      if(display[i]==0){
+        char geometry[20];
+        if(i<4){
+          sprintf(geometry,"80x23+%d+0",(int)(i%4)*400);
+        }else{
+          sprintf(geometry,"80x23+%d-0",(int)(i%4)*400);
+        }
+        execlp("xterm","xterm","-geometry",geometry,NULL);
       }
-      execlp("xterm","xterm","-geometry",geometry,NULL);
+      usleep((unsigned int)pGame->delay);
+      config_add_display(&config, display[i]+2); //--------------------------
     }
-    usleep((unsigned int)pGame->delay);
-    config_add_display(&config, display[i]+2); //------------------------------------
     
     // Init player
-    pGame->playerA[i] =
-      character_init(PLAYER, display[i], true, "Theseus", pDefHealth, pAi);
+    pGame->playerA[i] = character_init(PLAYER, display[i], !pGame->headless,
+                                       "Theseus", pDefHealth, pAi);
     pGame->playerA[i].pos = pAPos[i];
+    rng_seed(&(pGame->playerA[i].rng), pGame->seed, 2 * i);
+    if (pConf->eraseLoops) {
+      _game_erase_loops_init(pMap, &(pGame->playerA[i]));
+    }
     pGame->playerA[i].pMask = map_mask_init(pMap);
     map_mask_add(pGame->playerA[i].pMask, pAPos[i]);
     // NOTE: Targets are not set yet
@@ -722,63 +622,157 @@ bool game_init(game_t* pGame,
                   &(pC->targetCompass), &(pC->targetDistance));
   }
   
+  // Timings of the steps, with a line per character in the report
+  if (pConf->profile) {
+    pGame->pProfiler = profiler_new(pGame->nbPlayer + pGame->nbMinotaur,
+                                    pConf->traceFile);
+    if (pGame->pProfiler == NULL) {
+      display_fatal_error(stderr, "Error: can not start the profiler!\n");
+      exit(EXIT_FAILURE);
+    }
+    char name[64];
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      snprintf(name, sizeof(name), "%s %zu (%s)", pGame->playerA[i].name, i,
+               pGame->playerA[i].ai.name);
+      profiler_policy_name(pGame->pProfiler, i, name);
+    }
+    for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+      snprintf(name, sizeof(name), "%s %zu (%s)", pGame->minotaurA[i].name, i,
+               pGame->minotaurA[i].ai.name);
+      profiler_policy_name(pGame->pProfiler, pGame->nbPlayer + i, name);
+    }
+  }
+  
   return ok;
 }
 
 void game_start(game_t* pGame) {
   // Print UI
-  
-  // Initial display for game master
-  display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
-                pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
-                pGame->gameInfo, false);
-  
-  // Initial display for each player
-  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    const character_t* pC = &(pGame->playerA[i]);
-    display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
-                      pGame->delay, pGame->maxMoves, pGame->gameInfo, true,
-                      false);
+  if (!pGame->headless) {
+    // Initial display for game master
+    display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
+                  pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
+                  pGame->gameInfo, false);
+    
+    // Initial display for each player
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      const character_t* pC = &(pGame->playerA[i]);
+      display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
+                        pGame->delay, pGame->maxMoves, pGame->gameInfo, true,
+                        false);
+    }
   }
   
   size_t nbChar = 0;
   moves_prop_t* moves = NULL;
   _game_init_moves_prop(pGame, &moves, &nbChar);
+  moves_solver_t solver;
+  solver_init(&solver, nbChar);
   
+  // Threads and workers are kept for the whole game
+  backend_start(&(pGame->backend), pGame->pMap, pGame->pProfiler, moves,
+                nbChar);
+  
+  profiler_t* pProf = pGame->pProfiler;
+  pacer_t* pPacer = &(pGame->pacer);
+  pacer_start(pPacer, pGame->headless ? 0 : pGame->delay);
   do {
     // Play characters
     pGame->steps += 1;
-    usleep((unsigned int)pGame->delay);
+    if (!pGame->headless) {
+      pacer_wait(pPacer);
+    }
+    uint64_t t = profiler_step_begin(pProf);
     
     // Fights
     _game_fight_manager(pGame);
+    t = profiler_lap(pProf, PROFILER_FIGHT_BEFORE, t);
     
     // Get characters move propositions
-    _game_get_moves_propositions(pGame, moves, nbChar);
+    backend_propose(&(pGame->backend), moves, nbChar);
+    // Random thinking (display only, never changes the game): the AIs think
+    // together, so the step lasts as long as the slowest one.
+    if (pGame->thinking && !pGame->headless) {
+      uint32_t thinkingTime = 0;
+      for (size_t i = 0; i < nbChar; ++i) {
+        uint32_t t = rng_below(&(pGame->thinkRng), 100);
+        thinkingTime = (t > thinkingTime) ? t : thinkingTime;
+      }
+      usleep((unsigned int)(thinkingTime * 1000));
+    }
+    t = profiler_lap(pProf, PROFILER_PROPOSALS, t);
     // Solve confilcts
-    _gave_solve_moves_conflicts(pGame, moves, nbChar);
+    solver_solve(&solver, pGame->pMap, moves, nbChar);
+    t = profiler_lap(pProf, PROFILER_SOLVE, t);
     
     // Play characters
     _game_play_characters(pGame, moves, nbChar);
+    t = profiler_lap(pProf, PROFILER_PLAY, t);
     
-    // refresh displays
-    _game_play_refresh_ui(pGame);
+    // refresh displays (not while the steps run late)
+    if (pacer_frame(pPacer)) {
+      _game_play_refresh_ui(pGame);
+    }
+    t = profiler_lap(pProf, PROFILER_UI, t);
     
     // Fights
     _game_fight_manager(pGame);
+    t = profiler_lap(pProf, PROFILER_FIGHT_AFTER, t);
+    profiler_step_end(pProf, pGame->steps, t);
     
   } while (pGame->nbPlayerOnBoard > 0);
   
+  backend_stop(&(pGame->backend), nbChar);
+  if (!pGame->headless && (pPacer->skipRow > 0)) {
+    // The last frame was skipped, the final state is always shown
+    _game_play_refresh_ui(pGame);
+  }
   free(moves);
+  solver_delete(&solver);
   nbChar = 0;
+  profiler_report(pProf, stderr);
   
   // The end
+  if (pGame->headless) {
+    return;
+  }
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     const character_t* pC = &(pGame->playerA[i]);
     // Last display for each player
     display_ending(pGame->playerA[i].stream, _game_ending_player(pGame, pC));
   }
   display_ending(DISPLAY, _game_ending_gm(pGame));
+  _game_report_overruns(DISPLAY, pGame);
+  pacer_report(pPacer, stderr);
+}
+
+void game_summary(FILE* stream, const game_t* pGame) {
+  size_t nbOut = 0;
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    if (pGame->playerA[i].type == EXIT) {
+      ++nbOut;
+    }
+  }
+  fprintf(stream,
+          "game map=%s seed=%lu steps=%d result=%s players=%zu alive=%zu "
+          "out=%zu minotaurs=%zu minotaursAlive=%zu\n",
+          pGame->gameName, pGame->seed, pGame->steps,
+          display_ending_name(_game_ending_gm(pGame)), pGame->nbPlayer,
+          pGame->nbPlayerAlive, nbOut, pGame->nbMinotaur,
+          pGame->nbMinotaurAlive);
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    fprintf(stream,
+            "player id=%zu ending=%s result=%s health=%.1f overruns=%zu\n", i,
+            character_ending_name(pC->ending),
+            display_ending_name(_game_ending_player(pGame, pC)), pC->health,
+            pC->nbOverrun);
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    fprintf(stream, "minotaur id=%zu health=%.1f overruns=%zu\n", i,
+            pC->health, pC->nbOverrun);
+  }
 }
 
 void game_delete(game_t* pGame) {
@@ -809,6 +803,10 @@ void game_delete(game_t* pGame) {
   pGame->maxMoves = 0;
   pGame->steps = 0;
   pGame->delay = 0;
+  pGame->headless = false;
+  
+  profiler_delete(pGame->pProfiler);
+  pGame->pProfiler = NULL;
   
   map_delete(pGame->pMap);
   pGame->pMap = NULL;
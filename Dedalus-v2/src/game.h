@@ -14,6 +14,9 @@
 #include "character.h"
 #include "config.h"
 #include "map.h"
+#include "moveBackend.h"
+#include "pacer.h"
+#include "profiler.h"
 
 /**
  * @brief Default display stream for the Game Master.
@@ -42,8 +45,15 @@ typedef struct game {
   bool gameInfo;           ///< Display more precise game informations.
   int maxMoves;            ///< Maximum number of moves per player.
   int steps;               ///< Number of steps since the beginning of the game.
-  int delay;               ///< Delay (in us) between tow steps.
+  int delay;               ///< Time (in us) between the starts of two steps.
   bool interactive;        ///< Ask for interactive actions from GM.
+  bool thinking;           ///< Simulate AIs thinking time (display only).
+  unsigned long seed;      ///< Seed of the random generators of the game.
+  rng_t thinkRng;          ///< Generator of thinking times (not of the AIs).
+  bool headless;           ///< No display, no terminal nor delay (batch runs).
+  moves_backend_t backend;  ///< How the AIs are asked for their moves.
+  profiler_t* pProfiler;    ///< Timings of the steps (NULL if not profiled).
+  pacer_t pacer;            ///< Pace of the steps and fights (if displayed).
 } game_t;
 
 /**
@@ -73,9 +83,21 @@ bool game_init(game_t* pGame,
  * @brief Run an initialised game.
  *
  * @param[in, out] pGame The game to start.
+ * @note The backend asking the AIs for their moves (see backend_t) is started
+ * before the first step and stopped after the last one.
  */
 void game_start(game_t* pGame);
 
+/**
+ * @brief Print a compact summary of a finished game.
+ *
+ * @param[in,out] stream Where it should be printed.
+ * @param[in] pGame The finished game.
+ *
+ * One line for the game, then one line per player, as key=value fields.
+ */
+void game_summary(FILE* stream, const game_t* pGame);
+
 /**
  * @brief Clear all allocated content of a game.
  *
@@ -135,6 +135,26 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize) {
   return mapLoaded;
 }
 
+bool map_view_init(map_t* pView, char* rows, size_t x, size_t y) {
+  pView->x = x;
+  pView->y = y;
+  pView->m = (char**)malloc((y + 1) * sizeof(char*));
+  if (pView->m == NULL) {
+    return false;
+  }
+  for (size_t r = 0; r < y; ++r) {
+    pView->m[r] = &(rows[r * (x + 1)]);
+  }
+  return true;
+}
+
+void map_view_delete(map_t* pView) {
+  free(pView->m);
+  pView->m = NULL;
+  pView->x = 0;
+  pView->y = 0;
+}
+
 map_t* map_mask_init(const map_t* pMap) {
   map_t* pMask = (map_t*)malloc(1 * sizeof(map_t));
   pMask->x = pMap->x;
@@ -69,6 +69,25 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize);
  */
 void map_delete(map_t* pMap);
 
+/**
+ * @brief View rows of x + 1 chars (a copy of a map) as a read only map.
+ *
+ * @param[out] pView The view (the rows are not copied).
+ * @param[in] rows The rows, one after the other.
+ * @param[in] x Number of columns.
+ * @param[in] y Number of rows.
+ * @return true The view is ready (see map_view_delete()).
+ * @return false Out of memory.
+ */
+bool map_view_init(map_t* pView, char* rows, size_t x, size_t y);
+
+/**
+ * @brief Clear a view (its rows are left as they are).
+ *
+ * @param[in,out] pView The view to clear.
+ */
+void map_view_delete(map_t* pView);
+
 /**
  * @brief Build an empty display mask from a map.
  *
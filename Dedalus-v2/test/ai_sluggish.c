@@ -0,0 +1,77 @@
+/**
+ * @file ai_sluggish.c
+ * @brief AI always out of time (to check the time budget of the moves).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <stdbool.h>  // bool, true, false
+#include <time.h>     // clock_gettime
+
+#include "ai_sluggish.h"
+
+/**
+ * @brief Spin, then go to the first open direction (north, east, south, west).
+ *
+ * @param[in] north Is it possible to go north?
+ * @param[in] east Is it possible to go east?
+ * @param[in] south Is it possible to go south?
+ * @param[in] west Is it possible to go west?
+ * @param[in] comp Unused parameter.
+ * @param[in] distance Unused parameter.
+ * @param[in] ariane Unused parameter.
+ * @param[in,out] rng Unused parameter.
+ * @return compass_t The selected direction.
+ */
+compass_t _ai_sluggish_policy(bool north,
+                              bool east,
+                              bool south,
+                              bool west,
+                              compass_t comp,
+                              float distance,
+                              string ariane,
+                              rng_t* rng) {
+  // remove unused param
+  (void)comp;
+  (void)distance;
+  (void)ariane;
+  (void)rng;
+
+  // Busy: the time also runs on the CPU clock
+  struct timespec start;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  long ms = 0;
+  while (ms < AI_SLUGGISH_MS) {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ms = (now.tv_sec - start.tv_sec) * 1000 +
+         (now.tv_nsec - start.tv_nsec) / 1000000;
+  }
+
+  compass_t move = Stay;
+  if (north) {
+    move = North;
+  } else if (east) {
+    move = East;
+  } else if (south) {
+    move = South;
+  } else if (west) {
+    move = West;
+  }
+  return move;
+}
+
+const char* ai_sluggish_get_name() {
+  return "Sluggish";
+}
+
+ai_t ai_sluggish_new() {
+  ai_t res;
+  res.policy = &_ai_sluggish_policy;
+  res.coroutine = NULL;
+  res.name = ai_sluggish_get_name();
+  return res;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file ai_sluggish.h
+ * @brief AI always out of time (to check the time budget of the moves).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Only built into the tests: no game can pick it by its name.
+ */
+#ifndef AI_SLUGGISH_H
+#define AI_SLUGGISH_H
+
+#include "ai.h"
+
+/**
+ * @brief Time (in ms) the sluggish AI spins before each move.
+ *
+ */
+#define AI_SLUGGISH_MS 100
+
+/**
+ * @brief Get the name of the sluggish AI class.
+ *
+ * @return const char* The name of the AI.
+ */
+const char* ai_sluggish_get_name();
+
+/**
+ * @brief Create a new AI that spins AI_SLUGGISH_MS (on the wall and the CPU
+ * clocks) before going to the first open direction.
+ *
+ * @return ai_t The new AI.
+ */
+ai_t ai_sluggish_new();
+
+#endif  // End of AI_SLUGGISH_H
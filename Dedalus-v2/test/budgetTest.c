@@ -0,0 +1,119 @@
+/**
+ * @file budgetTest.c
+ * @brief Check the time budget of the moves with each backend.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * The players of a map play the sluggish AI, always out of time, with each
+ * backend, clock and penalty. Each player must have overruns and:
+ * - never leave its position with the stay penalty,
+ * - end as a cheater with the cheat penalty.
+ * The fork and workers backends kill the AI at its deadline, the others let
+ * it finish: both must give the same results.
+ */
+
+#include <stdbool.h>  // bool, true, false
+#include <stdio.h>    // printf
+#include <stdlib.h>   // EXIT_SUCCESS
+
+#include "ai.h"
+#include "ai/ai_random.h"
+#include "ai_sluggish.h"
+#include "config.h"
+#include "display.h"
+#include "game.h"
+#include "map.h"
+
+/**
+ * @brief Time (in ms) given to an AI for a move (far below AI_SLUGGISH_MS).
+ *
+ */
+#define BUDGET_TEST_MS 5
+
+/**
+ * @brief Play a game of sluggish players and check the penalty.
+ *
+ * @param[in,out] pConfig Configuration of the game (backend, clock, penalty).
+ * @return true The players overran and got the penalty.
+ * @return false Something is wrong (printed on stdout).
+ */
+bool budget_test(config_t* pConfig);
+
+/**
+ * @brief Main of the test.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv The map (without minotaurs, so nobody kills the players).
+ * @return int EXIT_SUCCESS if every game passed.
+ */
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s map\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  config_t config = config_init();
+  config.mapFile = argv[1];
+  config.headless = true;
+  config.interactive = false;
+  config.thinking = false;
+  config.maxMoves = 3;
+  config.moveTimeout = BUDGET_TEST_MS;
+  config.seed = 1;
+
+  bool ok = true;
+  for (size_t b = 0; b < BACKEND_NB; ++b) {
+    for (size_t c = 0; c < BUDGET_NB; ++c) {
+      for (size_t o = 0; o < OVERRUN_NB; ++o) {
+        config.backend = (backend_t)b;
+        config.moveClock = (budget_clock_t)c;
+        config.overrun = (overrun_t)o;
+        ok = budget_test(&config) && ok;
+      }
+    }
+  }
+
+  config_delete(&config);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+bool budget_test(config_t* pConfig) {
+  map_t map;
+  if (!map_reader(pConfig->mapFile, &map, pConfig->mapMaxXSize)) {
+    display_fatal_error(stderr, "Invalid map !\n");
+    exit(EXIT_FAILURE);
+  }
+  game_t game;
+  if (!game_init(&game, pConfig, pConfig->mapFile, &map, 100,
+                 ai_sluggish_new(), 10,
+                 ai_new(ai_random_get_name()))) {
+    display_fatal_error(stderr, "Wrong map (no player or no exit)!\n");
+    exit(EXIT_FAILURE);
+  }
+
+  pos_t startA[game.nbPlayer + 1];
+  for (size_t i = 0; i < game.nbPlayer; ++i) {
+    startA[i] = game.playerA[i].pos;
+  }
+  game_start(&game);
+
+  bool ok = true;
+  for (size_t i = 0; i < game.nbPlayer; ++i) {
+    const character_t* pC = &(game.playerA[i]);
+    bool cheater = (pC->ending == EC_CHEAT_MINOTAUR) ||
+                   (pC->ending == EC_CHEAT_NO_MINOTAUR);
+    bool stayed = (pC->pos.x == startA[i].x) && (pC->pos.y == startA[i].y);
+    bool penalty = (pConfig->overrun == OVERRUN_CHEAT) ? cheater
+                                                       : (stayed && !cheater);
+    ok = ok && (pC->nbOverrun > 0) && penalty;
+  }
+  printf("%-12s %-5s %-6s %s\n", options_backend_name(pConfig->backend),
+         (pConfig->moveClock == BUDGET_CPU) ? "cpu" : "wall",
+         (pConfig->overrun == OVERRUN_CHEAT) ? "cheat" : "stay",
+         ok ? "ok" : "FAILED");
+
+  game_delete(&game);
+  return ok;
+}
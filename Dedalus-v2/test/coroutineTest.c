@@ -0,0 +1,76 @@
+/**
+ * @file coroutineTest.c
+ * @brief Check that a coroutine keeps the state of its AI between steps.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * The players of a map play the wall follower with the coroutines backend.
+ * Its heading only lives in its coroutine: on the test map a wall follower
+ * that forgets it at each step goes back and forth in the first corridor,
+ * one that keeps it escapes. Each player must escape, never out of time.
+ */
+
+#include <stdbool.h>  // bool, true, false
+#include <stdio.h>    // printf
+#include <stdlib.h>   // EXIT_SUCCESS
+
+#include "ai.h"
+#include "ai/ai_shall_not_pass.h"
+#include "ai/ai_wall_follower.h"
+#include "config.h"
+#include "display.h"
+#include "game.h"
+#include "map.h"
+
+/**
+ * @brief Main of the test.
+ *
+ * @param[in] argc Number of parameters.
+ * @param[in] argv The map (without minotaurs, so nobody kills the players).
+ * @return int EXIT_SUCCESS if every player escaped.
+ */
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s map\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  config_t config = config_init();
+  config.mapFile = argv[1];
+  config.headless = true;
+  config.interactive = false;
+  config.thinking = false;
+  config.maxMoves = 100;
+  config.backend = BACKEND_COROUTINES;
+  config.seed = 1;
+
+  map_t map;
+  if (!map_reader(config.mapFile, &map, config.mapMaxXSize)) {
+    display_fatal_error(stderr, "Invalid map !\n");
+    exit(EXIT_FAILURE);
+  }
+  game_t game;
+  if (!game_init(&game, &config, config.mapFile, &map, 100,
+                 ai_new(ai_wall_follower_get_name()), 10,
+                 ai_new(ai_shall_not_pass_get_name()))) {
+    display_fatal_error(stderr, "Wrong map (no player or no exit)!\n");
+    exit(EXIT_FAILURE);
+  }
+  game_start(&game);
+
+  bool ok = true;
+  for (size_t i = 0; i < game.nbPlayer; ++i) {
+    const character_t* pC = &(game.playerA[i]);
+    bool escaped = (pC->ending == EC_ESCAPE) || (pC->ending == EC_WIN);
+    printf("player %zu: %s in %d steps, %zu overruns\n", i,
+           character_ending_name(pC->ending), game.steps, pC->nbOverrun);
+    ok = ok && escaped && (pC->nbOverrun == 0);
+  }
+  printf("%s\n", ok ? "ok" : "FAILED");
+
+  game_delete(&game);
+  config_delete(&config);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
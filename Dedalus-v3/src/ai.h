@@ -12,6 +12,9 @@
 #define IA_H
 
 #include "ariadneString.h"
+#include "rng.h"
+
+struct coro;
 
 /**
  * @brief Structure of a AI for a character.
@@ -25,7 +28,11 @@ typedef struct ai {
                       bool west,
                       compass_t comp,
                       float distance,
-                      string ariane);  ///< Policy of the AI.
+                      string ariane,
+                      rng_t* rng);  ///< Policy of the AI.
+  /// Stateful body of the AI, run by the coroutines backend (NULL: its
+  /// policy is called at each step, see aiCoroutine.h).
+  void (*coroutine)(struct coro* pCo);
 } ai_t;
 
 /**
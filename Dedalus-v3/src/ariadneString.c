@@ -12,6 +12,7 @@
 #include "ariadneString.h"
 #include "display.h"
 #include "gps.h"
+#include "sharedHeap.h"
 
 #include <stdio.h>   // printf
 #include <stdlib.h>  // malloc, rand, srand
@@ -29,7 +30,7 @@ void string_delete(string* pS) {
   while (*pS != NULL) {
     link_t* pHead = *pS;
     *pS = pHead->next;
-    free(pHead);
+    shared_free(pHead);
   }
 }
 
@@ -41,12 +42,12 @@ bool string_remove_link(string* pS) {
   }
 
   *pS = (*pS)->next;
-  free(plink);
+  shared_free(plink);
   return true;
 }
 
 bool string_add_link(string* pS, compass_t c) {
-  string plink = (string)malloc(sizeof(link_t));
+  string plink = (string)shared_malloc(sizeof(link_t));
 
   if (plink == NULL) {
     return false;
@@ -32,6 +32,13 @@ config_t config_init() {
   conf.delay = 100000;
   conf.interactive = true;
   conf.maxMoves = 1000;
+  conf.backend = BACKEND_THREADS;
+  conf.nbThreads = 0;
+  conf.moveTimeout = 1000;
+  conf.moveClock = BUDGET_WALL;
+  conf.overrun = OVERRUN_STAY;
+  conf.seed = 0;
+  conf.headless = false;
 
   conf.displayPidA = NULL;
   conf.nbDisplay = 0;
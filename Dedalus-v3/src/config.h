@@ -14,6 +14,8 @@
 #include <stdbool.h>    // bool, true, false
 #include <sys/types.h>  // pid_t
 
+#include "moveOptions.h"  // backend_t, budget_clock_t, overrun_t
+
 // Configuration
 extern const bool
     COLOR;  ///< Game in vintage colors if true and in B&W otherwise
@@ -32,9 +34,17 @@ typedef struct config {
   bool debug;     ///< Display in debug mode (no cleaning)?
   bool gameInfo;  ///< Display more game informations?
 
-  int delay;         ///< Time (in us) between frames.
-  bool interactive;  ///< Ask for interactive actions from GM.
-  int maxMoves;      ///< Maximum number of moves for players.
+  int delay;           ///< Time (in us) between frames.
+  bool interactive;    ///< Ask for interactive actions from GM.
+  int maxMoves;        ///< Maximum number of moves for players.
+  backend_t backend;   ///< How the AIs are asked (sequential, fork, threads).
+  size_t nbThreads;    ///< Threads of a turn asking AIs (0: one per CPU).
+  int moveTimeout;     ///< Time (in ms) given to an AI for a move.
+  unsigned long seed;  ///< Seed of the random generators of the AIs.
+
+  budget_clock_t moveClock;  ///< Clock measuring the time of a move.
+  overrun_t overrun;         ///< Penalty of an AI too slow for a move.
+  bool headless;             ///< No display, no terminal nor delay (batch runs).
 
   size_t nbDisplay;    ///< Number of display for players.
   pid_t* displayPidA;  ///< Array of pid of terminals to display players.
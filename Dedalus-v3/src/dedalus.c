@@ -25,10 +25,11 @@
 #include "ai.h"
 #include "ai/ai_random.h"
 #include "ai/ai_shall_not_pass.h"
-#include "config.h"   // configuration
-#include "display.h"  // Wait user and info
-#include "game.h"     // game setting
-#include "map.h"      // manage the map
+#include "config.h"      // configuration
+#include "display.h"     // Wait user and info
+#include "game.h"        // game setting
+#include "map.h"         // manage the map
+#include "sharedHeap.h"  // shared game state
 
 /**
  * @brief Parse parameters to build the configuration of the game.
@@ -56,9 +57,16 @@ int main(int argc, char* argv[]) {
   // INIT Srand
   srand((unsigned int)time(NULL));
 
-  // acquiring program parameters
+  // acquiring program parameters (the seed changes at each run by default)
   config_t config = config_init();
+  config.seed = (unsigned long)time(NULL);
   read_parameters(argc, argv, &config);
+
+  // The game state is shared by the processes of the turns
+  if (!shared_heap_init(SHARED_HEAP_SIZE)) {
+    display_fatal_error(stderr, "Error: can not map the shared heap!\n");
+    return EXIT_FAILURE;
+  }
   
   map_t map;
   bool mapLoaded = map_reader(config.mapFile, &map, config.mapMaxXSize);
@@ -78,17 +86,30 @@ int main(int argc, char* argv[]) {
   }
   
   // Start game
-  display_wait_user(stdout, "Press any key to start...", game.interactive);
-  game_start(&game);
+  if (config.headless) {
+    game_start(&game);
+    game_summary(stdout, &game);
+  } else {
+    display_wait_user(stdout, "Press any key to start...", game.interactive);
+    game_start(&game);
 
-  display_wait_user(stdout, "Press any key to finish...", game.interactive);
+    display_wait_user(stdout, "Press any key to finish...", game.interactive);
+  }
 
   // Clear at the end
   game_delete(&game);
+  bool headless = config.headless;
   config_delete(&config);
+  shared_heap_delete();
+  if (headless) {
+    // No terminal to close
+    return EXIT_SUCCESS;
+  }
   /*for(i=0;i<nbPlayer;i++){
     kill(pid_fils[i],SIGKILL);
   }*/
+  // The outputs not flushed yet would be lost by exec
+  fflush(NULL);
   execlp("killall","killall","xterm",NULL);
   return EXIT_SUCCESS;
 }
@@ -100,7 +121,7 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
   int mandatory = 0;
   unsigned long tmp = 0;
 
-  while ((c = getopt(argc, argv, "had:m:M:p:")) != -1) {
+  while ((c = getopt(argc, argv, "habcd:e:m:M:p:P:R:s:t:T:")) != -1) {
     switch (c) {
       case 'h':  // help.
         usage();
@@ -124,9 +145,49 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
         }
         pConfig->delay = (int)tmp;
         break;
+      case 'R':  // steps per second.
+        tmp = strtoul(optarg, NULL, 0);
+        if ((tmp < 1) || (tmp > 1000000)) {
+          ++errflg;
+        } else {
+          pConfig->delay = (int)(1000000 / tmp);
+        }
+        break;
       case 'a':  // automatic mode (not interactive).
         pConfig->interactive = false;
         break;
+      case 'b':  // batch mode (headless).
+        pConfig->headless = true;
+        pConfig->interactive = false;
+        break;
+      case 's':  // seed.
+        pConfig->seed = strtoul(optarg, NULL, 0);
+        break;
+      case 't':  // number of threads asking AIs for moves.
+        pConfig->nbThreads = strtoul(optarg, NULL, 0);
+        break;
+      case 'e':  // backend asking AIs for moves.
+        if (!options_backend_parse(optarg, &(pConfig->backend))) {
+          fprintf(stderr, "Unknown backend: %s\n", optarg);
+          ++errflg;
+        }
+        break;
+      case 'T':  // time given to an AI for a move.
+        tmp = strtoul(optarg, NULL, 0);
+        if ((tmp < 1) || (tmp > INT_MAX)) {
+          ++errflg;
+        }
+        pConfig->moveTimeout = (int)tmp;
+        break;
+      case 'c':  // time of the AIs on the CPU clock.
+        pConfig->moveClock = BUDGET_CPU;
+        break;
+      case 'P':  // penalty of an AI out of time.
+        if (!options_overrun_parse(optarg, &(pConfig->overrun))) {
+          fprintf(stderr, "Unknown penalty: %s\n", optarg);
+          ++errflg;
+        }
+        break;
       case ':': /* option without operand */
         fprintf(stderr, "Option -%c requires an operand\n", optopt);
         ++errflg;
@@ -149,14 +210,38 @@ void read_parameters(int argc, char* argv[], config_t* pConfig) {
 
 void usage() {
   fprintf(stderr,
-          "Usage: ./Dedalus [-h] -m arg [-M arg] [-d arg] [-a] [-p arg -p arg  "
-          "...]    \n");
+          "Usage: ./Dedalus [-h] -m arg [-M arg] [-d arg] [-R arg] [-s arg] "
+          "[-t arg] [-e arg] [-T arg] [-c] [-P arg] [-a] [-b] "
+          "[-p arg -p arg  ...]    \n");
   fprintf(stderr, "\n");
   fprintf(stderr, "Options: \n");
   fprintf(stderr, "\t -m arg \t (Mandatory) file of the map.\n");
   fprintf(stderr, "\t -p arg \t (Multiple) PID of the player terminal.\n");
-  fprintf(stderr, "\t -d arg \t [100000] Delay (in μs).\n");
+  fprintf(stderr,
+          "\t -d arg \t [100000] Period (in μs) of a step, whatever it "
+          "takes.\n");
+  fprintf(stderr, "\t -R arg \t [10] Steps per second (sets -d).\n");
+  fprintf(stderr, "\t -s arg \t [time] Seed of the random generators.\n");
+  fprintf(stderr,
+          "\t -t arg \t [0] Threads of a turn asking AIs for moves (0: one "
+          "per CPU, at most one per character).\n");
+  fprintf(stderr,
+          "\t -e arg \t [threads] Backend asking AIs for moves: sequential, "
+          "fork or threads (only fork stops a hung AI, the workers and the "
+          "coroutines do not outlive a turn).\n");
+  fprintf(stderr,
+          "\t -T arg \t [1000] Time (in ms) given to an AI for a move (an AI "
+          "process still running 50 ms later is killed).\n");
+  fprintf(stderr,
+          "\t -c     \t [false] Time of the AIs on the CPU clock (not the "
+          "wall clock).\n");
+  fprintf(stderr,
+          "\t -P arg \t [stay] Penalty of an AI out of time: stay or "
+          "cheat.\n");
   fprintf(stderr, "\t -a     \t [false] Automatic mode (not interactive).\n");
+  fprintf(stderr,
+          "\t -b     \t [false] Batch mode: no display, terminal nor delay, "
+          "print a summary.\n");
   fprintf(stderr, "\t -M arg \t [1000] Maximum number of steps for players.\n");
   fprintf(stderr, "\t -h     \t Display this message.	\n");
 }
@@ -923,6 +923,28 @@ void display_ending(FILE* stream, ending_t ending) {
   }
 }
 
+const char* display_ending_name(ending_t ending) {
+  switch (ending) {
+    case EG_LOOSE:
+      return "loose";
+    case EG_NEXT_LEVEL_AND_ALIVE:
+      return "next_level_and_alive";
+    case EG_NEXT_LEVEL_BUT_DEAD:
+      return "next_level_but_dead";
+    case EG_WIN_AND_ALIVE:
+      return "win_and_alive";
+    case EG_KILL_MINOTAUR_BUT_DEAD:
+      return "kill_minotaur_but_dead";
+    case EG_WIN_BUT_DEAD:
+      return "win_but_dead";
+    case EG_GM_WIN:
+      return "gm_win";
+    case EG_GM_LOOSE:
+      return "gm_loose";
+  }
+  return "unknown";
+}
+
 void display_fight_iteration(const map_t* pMap,
                              const character_t* pC1,
                              const character_t* pC2,
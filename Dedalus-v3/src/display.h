@@ -89,6 +89,14 @@ void display_ui_player(const char* level,
  */
 void display_ending(FILE* stream, ending_t ending);
 
+/**
+ * @brief Short name of an ending (for machine readable outputs).
+ *
+ * @param[in] ending The ending type.
+ * @return const char* The name of the ending.
+ */
+const char* display_ending_name(ending_t ending);
+
 /**
  * @brief Display on iteration of a fight.
  *
@@ -10,13 +10,19 @@
 *
 */
 
-#include <stdio.h>   // printf
-#include <string.h>  // strcpy, strlen
-#include <unistd.h>  // usleep
-
-#include "display.h"  // outputs of the game
-#include "game.h"     // public defintions
-#include "gps.h"      // pos_t
+#include <errno.h>      // EINTR
+#include <semaphore.h>  // turns of the workers
+#include <signal.h>     // kill
+#include <stdio.h>      // printf
+#include <string.h>     // strcpy, strlen
+#include <time.h>       // clock_gettime
+#include <unistd.h>     // usleep
+
+#include "display.h"     // outputs of the game
+#include "game.h"        // public defintions
+#include "gps.h"         // pos_t
+#include "moveSolver.h"  // conflicts of the moves
+#include "sharedHeap.h"  // state shared by the turns
 #include <sys/types.h>
 #include <sys/wait.h>
 
@@ -24,16 +30,6 @@
 /**********************************/
 // Declaration of local functions.
 
-/**
-* @brief Structure to store moves propositions.
-*
-*/
-typedef struct moves_prop {
-  character_t* c;  ///< Pointer to the character concerned.
-  compass_t move;  ///< The move proposition
-  bool cheated;    ///< Is this a cheat move.
-} moves_prop_t;
-
 /**
 * @brief Initialize a moves propositions array.
 *
@@ -46,34 +42,6 @@ void _game_init_moves_prop(const game_t* pGame,
                            moves_prop_t** pMoves,
                            size_t* pNbChar);
 
-/**
-* @brief Get all moves propositions for each character.
-*
-* @param[in] pGame The game considered.
-* @param[in,out] pMoves An initialized vector of propositions.
-* @param[in] nbChar Number of character considered.
-* @note The array pMoves must be initialized before the call.
-*/
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar);
-
-/**
-* @brief Solve conflicts between an array of move propositions.
-*
-* @param[in] pGame The game considered.
-* @param[in,out] moves The array of moves propositions to clear.
-* @param[in] nbChar Number of character considered.
-*
-* The "moves" arrays will be cleaned to remove conflicts.
-* A conflict occurs when two characters want to go at the same position.
-* In this version only one character will move (players firsts and in order
-* of declaration after).
-*/
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar);
-
 /**
 * @brief Set a character as dead for this game.
 *
@@ -193,6 +161,76 @@ ending_t _game_ending_gm(const game_t* pGame);
 */
 ending_t _game_ending_player(const game_t* pGame, const character_t* pC);
 
+/**
+* @brief Turns shared by the game master and its worker processes.
+*
+* Worker i plays the steps i, i + nbWorker, ... : the game master hands the
+* turn to a worker then waits for the end of its step.
+*/
+typedef struct game_turns {
+  sem_t done;     ///< Posted by a worker at the end of its step.
+  bool over;      ///< The game is over, workers must leave.
+  sem_t turnA[];  ///< Posted by the game master to start a step of a worker.
+} game_turns_t;
+
+/**
+* @brief Play one step of the game.
+*
+* @param[in,out] pGame The game to change.
+* @param[in,out] pBackend How the AIs are asked for their moves.
+* @param[in,out] pSolver Working memory of the conflict solver.
+* @param[in,out] moves An initialized vector of propositions.
+* @param[in] nbChar Number of character considered.
+*/
+void _game_step(game_t* pGame,
+                moves_backend_t* pBackend,
+                moves_solver_t* pSolver,
+                moves_prop_t* moves,
+                size_t nbChar);
+
+/**
+* @brief Main loop of a worker process: play a step each time it gets the
+* turn, until the game is over.
+*
+* @param[in,out] pGame The game to change (in the shared heap).
+* @param[in,out] pTurns The turns (in the shared heap).
+* @param[in] w Index of the worker.
+* @param[in,out] pSolver Working memory of the conflict solver (a private
+* copy in each worker).
+* @param[in,out] moves An initialized vector of propositions.
+* @param[in] nbChar Number of character considered.
+* @note Never returns. A thread pool does not outlive a fork: with the threads
+* backend each worker starts its own pool.
+*/
+void _game_turn_worker(game_t* pGame,
+                       game_turns_t* pTurns,
+                       size_t w,
+                       moves_solver_t* pSolver,
+                       moves_prop_t* moves,
+                       size_t nbChar);
+
+/**
+* @brief Print the AIs that were out of time (nothing if none was).
+ *
+* @param[in,out] stream Where to print.
+* @param[in] pGame The game.
+*/
+void _game_report_overruns(FILE* stream, const game_t* pGame);
+
+/**
+* @brief Wait for the end of the step of a worker.
+*
+* @param[in,out] pTurns The turns.
+* @param[in] workerA Pids of the workers.
+* @param[in] nbWorker Number of workers.
+* @note If a worker died, the others are killed and it exits with a fatal
+* error. The other children (the terminals of the players) may exit: a closed
+* display does not stop the game.
+*/
+void _game_wait_turn(game_turns_t* pTurns,
+                     const pid_t* workerA,
+                     size_t nbWorker);
+
 /*****************************/
 // Functions implementation.
 
@@ -211,12 +249,14 @@ void _game_init_moves_prop(const game_t* pGame,
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     (*pMoves)[i].c = &(pGame->playerA[i]);
     (*pMoves)[i].cheated = false;
+    (*pMoves)[i].overrun = false;
     (*pMoves)[i].move = Stay;
   }
   size_t offset = pGame->nbPlayer;
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
     (*pMoves)[i + offset].c = &(pGame->minotaurA[i]);
     (*pMoves)[i + offset].cheated = false;
+    (*pMoves)[i + offset].overrun = false;
     (*pMoves)[i + offset].move = Stay;
   }
 }
@@ -262,13 +302,25 @@ bool _game_should_fight(const character_t* pC1, const character_t* pC2) {
 void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   size_t i = 0;
   while ((pC1->health > 0) && (pC2->health > 0)) {
-    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
-    usleep((unsigned int)pGame->delay);
+    if (!pGame->headless) {
+      if (i == 0) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+        // The introduction is an animation of its own
+        pacer_resume(&(pGame->pacer));
+      } else if (pacer_frame(&(pGame->pacer))) {
+        display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay,
+                                i);
+      }
+      pacer_wait(&(pGame->pacer));
+    }
     ++i;
     --(pC1->health);
     --(pC2->health);
   }
-  display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  if (!pGame->headless) {
+    display_fight_iteration(pGame->pMap, pC1, pC2, (size_t)pGame->delay, i);
+  }
   
   if (pC1->health <= 0) {
     _game_death_caractere(pGame, pC1);
@@ -277,8 +329,12 @@ void _game_fight(game_t* pGame, character_t* pC1, character_t* pC2) {
   if (pC2->health <= 0) {
     _game_death_caractere(pGame, pC2);
   }
+  if (pGame->headless) {
+    return;
+  }
   display_wait_user(DISPLAY, "Press any key to continue...",
                     pGame->interactive);
+  pacer_resume(&(pGame->pacer));
   
   // refresh display
   display_fight_clear(pC1->stream);
@@ -350,157 +406,6 @@ pos_t _game_character_target(game_t* pGame, const character_t* pC) {
   return target;
 }
 
-/*  Version avec Waitpid avec gain de vitesse BOI */
-
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-                                  size_t nbChar) {
-  pid_t pid[nbChar];
-  //printf("nbChar : %d\n",(int)nbChar);
-  compass_t move;
-  bool cheated;
-  int status;
-  for (size_t i=0;i < nbChar;i++) {
-    character_t* pC = pMoves[i].c;
-    
-    pid[i]=fork();
-    if(pid[i]==-1){
-      printf("ggmp failed \n");
-      exit(EXIT_FAILURE);
-    }
-    if(pid[i]==0){
-      //  printf("i : %d\n",(int)i); 
-      move = character_propose_move(pC, pGame->pMap, &cheated);
-      move=(int)move+cheated*10;
-      exit(move);
-    }
-  }
-  for(size_t i=0;i < nbChar;i++){
-    //printf("i : %d\n",(int)i); 
-    waitpid(pid[i],&status,0);
-    if(WIFEXITED(status)){
-      
-      status=WEXITSTATUS(status);
-      //printf("status : %d\n",status);
-      pMoves[i].move=status%10;
-      pMoves[i].cheated=status/10;
-      //printf("move : %d cheated : %d\n",pMoves[i].move,pMoves[i].cheated);
-    }
-  }
-}
-
-
-/* Version avec Wait sans gain de vitesse  */
-/*
-void _game_get_moves_propositions(game_t* pGame,
-                                  moves_prop_t* pMoves,
-size_t nbChar) {
-pid_t pid[nbChar];
-//printf("nbChar : %d\n",(int)nbChar);
-compass_t move;
-bool cheated;
-int status;
-for (size_t i=0;i < nbChar;i++) {
-character_t* pC = pMoves[i].c;
-
-pid[i]=fork();
-if(pid[i]==-1){
-printf("ggmp failed \n");
-exit(EXIT_FAILURE);
-}
-if(pid[i]==0){
-//  printf("i : %d\n",(int)i); 
-move = character_propose_move(pC, pGame->pMap, &cheated);
-move=(int)move+cheated*10;
-exit(move);
-}
-}
-for(size_t i=0;i < nbChar;i++){
-//printf("i : %d\n",(int)i); 
-wait(&status);
-if(WIFEXITED(status)){
-status=WEXITSTATUS(status);
-//printf("status : %d\n",status);
-pMoves[i].move=status%10;
-pMoves[i].cheated=status/10;
-//printf("move : %d cheated : %d\n",pMoves[i].move,pMoves[i].cheated);
-}
-}
-}
-*/
-
-void _gave_solve_moves_conflicts(const game_t* pGame,
-                                 moves_prop_t* moves,
-                                 size_t nbChar) {
-  (void)pGame;  // unused
-  
-  // Solve all conflicts
-  bool conflictFound = false;
-  do {
-    pos_t* usedPositions = NULL;
-    size_t nbPosUsed = 0;
-    // Fix position of staying char
-    for (size_t i = 0; i < nbChar; ++i) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      if ((moves[i].move == Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // reserve position. We are sure there is no conflict.
-        ++nbPosUsed;
-        usedPositions =
-        (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        usedPositions[nbPosUsed - 1] = pC->pos;
-      }
-    }
-    
-    // Search conflict for others but stop at first conflict
-    // Just one conflict at a time in order to be sure that refusing a move for
-    // a character will not create another conflict.
-    conflictFound = false;
-    size_t i = 0;
-    while ((!conflictFound) && (i < nbChar)) {
-      character_t* pC = moves[i].c;
-      // Only alive characters are interested
-      // We only consider moving characters since those staying are already
-      // managed.
-      if ((moves[i].move != Stay) &&
-          ((pC->type == PLAYER) || (pC->type == MINOTAUR))) {
-        // Compute target position
-        pos_t nextPos = gps_compute_move(pC->pos, moves[i].move);
-        
-        // Check if we have a conflict
-        size_t j = 0;
-        while ((!conflictFound) && (j < nbPosUsed)) {
-          conflictFound = ((usedPositions[j].x == nextPos.x) &&
-            (usedPositions[j].y == nextPos.y));
-          ++j;
-        }
-        ++nbPosUsed;
-        usedPositions =
-        (pos_t*)realloc(usedPositions, nbPosUsed * sizeof(pos_t));
-        if (usedPositions == NULL) {
-          display_fatal_error(stderr, "Error: can not realloc usedPosition!");
-          exit(EXIT_FAILURE);
-        }
-        if (conflictFound) {
-          moves[i].move = Stay;
-          usedPositions[nbPosUsed - 1] = pC->pos;
-        } else {
-          // Reserve the position
-          usedPositions[nbPosUsed - 1] = nextPos;
-        }
-      }
-      ++i;
-    }
-    
-    free(usedPositions);
-  } while (conflictFound);
-}
-
 void _game_play_character(game_t* pGame,
                           character_t* pC,
                           compass_t move,
@@ -557,7 +462,9 @@ void _game_play_characters(game_t* pGame,
 }
 
 void _game_play_refresh_ui(const game_t* pGame) {
-  // Play all characters
+  if (pGame->headless) {
+    return;
+  }
   
   // Display current state for game master
   display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
@@ -602,6 +509,115 @@ ending_t _game_ending_player(const game_t* pGame, const character_t* pC) {
 /**********************************/
 // Public functions implementations.
 
+void _game_step(game_t* pGame,
+                moves_backend_t* pBackend,
+                moves_solver_t* pSolver,
+                moves_prop_t* moves,
+                size_t nbChar) {
+  pGame->steps += 1;
+  // The deadline was left in the shared heap by the previous turn
+  pacer_wait(&(pGame->pacer));
+
+  // Fights
+  _game_fight_manager(pGame);
+
+  // Get characters move propositions
+  backend_propose(pBackend, moves, nbChar);
+
+  // Solve confilcts
+  solver_solve(pSolver, pGame->pMap, moves, nbChar);
+
+  // Play characters
+  _game_play_characters(pGame, moves, nbChar);
+
+  // refresh displays (not while the steps run late)
+  if (pacer_frame(&(pGame->pacer))) {
+    _game_play_refresh_ui(pGame);
+  }
+
+  // Fights
+  _game_fight_manager(pGame);
+}
+
+void _game_turn_worker(game_t* pGame,
+                       game_turns_t* pTurns,
+                       size_t w,
+                       moves_solver_t* pSolver,
+                       moves_prop_t* moves,
+                       size_t nbChar) {
+  moves_backend_t* pBackend = &(pGame->backend);
+  moves_backend_t pool;
+  if (pBackend->backend == BACKEND_THREADS) {
+    pool = *pBackend;
+    backend_start(&pool, pGame->pMap, NULL, moves, nbChar);
+    pBackend = &pool;
+  }
+  while (true) {
+    while (sem_wait(&(pTurns->turnA[w])) == -1) {
+      if (errno != EINTR) {
+        _exit(EXIT_FAILURE);
+      }
+    }
+    if (pTurns->over) {
+      if (pBackend == &pool) {
+        backend_stop(&pool, nbChar);
+      }
+      _exit(EXIT_SUCCESS);
+    }
+    _game_step(pGame, pBackend, pSolver, moves, nbChar);
+    // The outputs of the step must be seen before the next one
+    fflush(NULL);
+    sem_post(&(pTurns->done));
+  }
+}
+
+void _game_report_overruns(FILE* stream, const game_t* pGame) {
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    if (pC->nbOverrun > 0) {
+      fprintf(stream, "%s (%s) was out of time for %zu moves.\n", pC->name,
+              pC->ai.name, pC->nbOverrun);
+    }
+  }
+}
+
+void _game_wait_turn(game_turns_t* pTurns,
+                     const pid_t* workerA,
+                     size_t nbWorker) {
+  while (true) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += 1;
+    if (sem_timedwait(&(pTurns->done), &deadline) == 0) {
+      return;
+    }
+    if ((errno != EINTR) && (errno != ETIMEDOUT)) {
+      break;
+    }
+    // Still running ? (only the workers, not the terminals)
+    bool died = false;
+    for (size_t i = 0; (i < nbWorker) && !died; ++i) {
+      int status;
+      died = (waitpid(workerA[i], &status, WNOHANG) > 0);
+    }
+    if (died) {
+      break;
+    }
+  }
+  for (size_t i = 0; i < nbWorker; ++i) {
+    kill(workerA[i], SIGKILL);
+  }
+  display_fatal_error(stderr, "Error: a turn worker died!\n");
+  exit(EXIT_FAILURE);
+}
+
 bool game_init(game_t* pGame,
                config_t* pConf,
                const char* gameName,
@@ -616,7 +632,24 @@ bool game_init(game_t* pGame,
   pGame->gameInfo = pConf->gameInfo;
   pGame->steps = 0;
   pGame->delay = pConf->delay;
-  pGame->interactive = pConf->interactive;
+  pGame->interactive = pConf->interactive && !pConf->headless;
+  pGame->headless = pConf->headless;
+  pGame->seed = pConf->seed;
+  // The turns are processes: the AI workers and the coroutines keep a state
+  // that the next turn would not see (the threads are started by each turn).
+  if ((pConf->backend == BACKEND_WORKERS) ||
+      (pConf->backend == BACKEND_COROUTINES)) {
+    display_fatal_error(stderr, "Error: the turns only ask the AIs "
+                                "sequentially, in threads or in forked "
+                                "processes!\n");
+    exit(EXIT_FAILURE);
+  }
+  budget_t budget;
+  budget.ms = pConf->moveTimeout;
+  budget.clock = pConf->moveClock;
+  backend_init(&(pGame->backend), pConf->backend, pConf->nbThreads, &budget,
+               pConf->overrun);
+  pacer_start(&(pGame->pacer), pGame->headless ? 0 : pGame->delay);
   
   bool ok = true;
   
@@ -633,13 +666,14 @@ bool game_init(game_t* pGame,
     // if no exit, then it must be a final level
     ok = false;
   }
-  // NOTE: malloc(0) return NULL so it is ok
+  // NOTE: characters are changed by the turns, they live in the shared heap
   pGame->minotaurA =
-    (character_t*)malloc(pGame->nbMinotaur * sizeof(character_t));
+    (character_t*)shared_malloc(pGame->nbMinotaur * sizeof(character_t));
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
     pGame->minotaurA[i] = character_init(MINOTAUR, (pid_t)(-i - 1), false,
                                          "Minotaur", mDefHealth, mAi);
     pGame->minotaurA[i].pos = mAPos[i];
+    rng_seed(&(pGame->minotaurA[i].rng), pGame->seed, 2 * i + 1);
     pGame->minotaurA[i].pMask = map_mask_init(pMap);
     map_mask_add(pGame->minotaurA[i].pMask, mAPos[i]);
     
@@ -657,32 +691,38 @@ bool game_init(game_t* pGame,
     // Need at least one player
     ok = false;
   }
-  pGame->playerA = (character_t*)malloc(pGame->nbPlayer * sizeof(character_t));
+  pGame->playerA =
+    (character_t*)shared_malloc(pGame->nbPlayer * sizeof(character_t));
   config_t config=config_init(); //-------------------------
   pid_t display[pGame->nbPlayer]; //------------------------------------
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    // Get the display to use with this player.
-    usleep((unsigned int)pGame->delay);
-    display[i]=fork();
-    if(display[i]==-1){
-      return EXIT_FAILURE;
-    }
-    if(display[i]==0){
-      char geometry[20];
-      if(i<4){
-        sprintf(geometry,"80x23+%d+0",(int)(i%4)*400);
-      }else{
-        sprintf(geometry,"80x23+%d-0",(int)(i%4)*400);
+    // No terminal in batch mode
+    display[i] = (pid_t)(-i - 1);
+    if (!pGame->headless) {
+      // Get the display to use with this player.
+      usleep((unsigned int)pGame->delay);
+      display[i]=fork();
+      if(display[i]==-1){
+        return EXIT_FAILURE;
       }
-      execlp("xterm","xterm","-geometry",geometry,NULL);
+      if(display[i]==0){
+        char geometry[20];
+        if(i<4){
+          sprintf(geometry,"80x23+%d+0",(int)(i%4)*400);
+        }else{
+          sprintf(geometry,"80x23+%d-0",(int)(i%4)*400);
+        }
+        execlp("xterm","xterm","-geometry",geometry,NULL);
+      }
+      usleep((unsigned int)pGame->delay);
+      config_add_display(&config, display[i]+2); //--------------------------
     }
-    usleep((unsigned int)pGame->delay);
-    config_add_display(&config, display[i]+2); //------------------------------------
     
     // Init player
-    pGame->playerA[i] =
-      character_init(PLAYER, display[i], true, "Theseus", pDefHealth, pAi);
+    pGame->playerA[i] = character_init(PLAYER, display[i], !pGame->headless,
+                                       "Theseus", pDefHealth, pAi);
     pGame->playerA[i].pos = pAPos[i];
+    rng_seed(&(pGame->playerA[i].rng), pGame->seed, 2 * i);
     pGame->playerA[i].pMask = map_mask_init(pMap);
     map_mask_add(pGame->playerA[i].pMask, pAPos[i]);
     // NOTE: Targets are not set yet
@@ -729,76 +769,100 @@ bool game_init(game_t* pGame,
 
 void game_start(game_t* pGame) {
   // Print UI
-  
-  // Initial display for game master
-  display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
-                pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
-                pGame->gameInfo, false);
-  
-  // Initial display for each player
-  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
-    const character_t* pC = &(pGame->playerA[i]);
-    display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
-                      pGame->delay, pGame->maxMoves, pGame->gameInfo, true,
-                      false);
+  if (!pGame->headless) {
+    // Initial display for game master
+    display_ui_gm(DISPLAY, pGame->gameName, pGame->pMap, pGame->nbPlayerAlive,
+                  pGame->nbPlayerOnBoard, pGame->nbMinotaurAlive, pGame->delay,
+                  pGame->gameInfo, false);
+    
+    // Initial display for each player
+    for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+      const character_t* pC = &(pGame->playerA[i]);
+      display_ui_player(pGame->gameName, pC->ai.name, pGame->pMap, pC,
+                        pGame->delay, pGame->maxMoves, pGame->gameInfo, true,
+                        false);
+    }
   }
   
-  size_t nbChar = 0;
+  // The state changed by the steps is in the shared heap (map, masks,
+  // characters, Ariadne strings), the game itself is moved there.
+  game_t* pShared = (game_t*)shared_malloc(sizeof(game_t));
+  size_t nbChar = pGame->nbPlayer + pGame->nbMinotaur;
+  game_turns_t* pTurns = (game_turns_t*)shared_malloc(
+      sizeof(game_turns_t) + nbChar * sizeof(sem_t));
+  if ((pShared == NULL) || (pTurns == NULL) ||
+      !shared_heap_contains(pShared)) {
+    display_fatal_error(stderr, "Error: the game is not in a shared heap!\n");
+    exit(EXIT_FAILURE);
+  }
+  *pShared = *pGame;
+  pTurns->over = false;
+  sem_init(&(pTurns->done), 1, 0);
+  for (size_t i = 0; i < nbChar; ++i) {
+    sem_init(&(pTurns->turnA[i]), 1, 0);
+  }
+
   moves_prop_t* moves = NULL;
-  _game_init_moves_prop(pGame, &moves, &nbChar);
-  
-  
-  pid_t tab[nbChar];  //Tableau d etat des persos
-  for(size_t i=0;i<nbChar;i++){
-    tab[i]=0;
+  _game_init_moves_prop(pShared, &moves, &nbChar);
+  moves_solver_t solver;
+  solver_init(&solver, nbChar);
+  // Shared memory of the backend is mapped before the turns are forked (the
+  // thread pools are started by the turns)
+  if (pShared->backend.backend != BACKEND_THREADS) {
+    backend_start(&(pShared->backend), pShared->pMap, NULL, moves, nbChar);
+  }
+
+  // One worker per character, forked once for the whole game
+  fflush(NULL);
+  pid_t workerA[nbChar];
+  for (size_t i = 0; i < nbChar; ++i) {
+    workerA[i] = fork();
+    if (workerA[i] == -1) {
+      display_fatal_error(stderr, "Error: can not fork a turn worker!\n");
+      exit(EXIT_FAILURE);
+    }
+    if (workerA[i] == 0) {
+      _game_turn_worker(pShared, pTurns, i, &solver, moves, nbChar);
+    }
   }
-  
+
+  pacer_start(&(pShared->pacer), pShared->headless ? 0 : pShared->delay);
+  size_t w = 0;
   do {
-    int status;
-    for (size_t i=0;i<nbChar;i++){
-      if(tab[i]==0){
-        tab[i]=fork();
-        if (tab[i]==-1){
-          exit(EXIT_FAILURE);
-        }
-        if(tab[i]==0){
-          getchar();
-          // Play characters
-          pGame->steps += 1;
-          usleep((unsigned int)pGame->delay);
-          
-          // Fights
-          _game_fight_manager(pGame);
-          // Get characters move propositions
-          _game_get_moves_propositions(pGame, moves, nbChar);
-          
-          // Solve confilcts
-          _gave_solve_moves_conflicts(pGame, moves, nbChar);
-          
-          // Play characters
-          _game_play_characters(pGame, moves, nbChar);
-          
-          // refresh displays
-          _game_play_refresh_ui(pGame);
-          
-          // Fights
-          _game_fight_manager(pGame);
-          printf("je suis %d",(int)i);
-          exit(tab[i]);
-        }else{
-          wait(&status);
-          status=WEXITSTATUS(status);
-          tab[i]=0;
-          printf("status %d\n ",status);
-        }
-      }
-    }
-  } while (pGame->nbPlayerOnBoard > 0);
-  
+    sem_post(&(pTurns->turnA[w]));
+    _game_wait_turn(pTurns, workerA, nbChar);
+    w = (w + 1) % nbChar;
+  } while (pShared->nbPlayerOnBoard > 0);
+
+  // Release the workers
+  pTurns->over = true;
+  for (size_t i = 0; i < nbChar; ++i) {
+    sem_post(&(pTurns->turnA[i]));
+  }
+  for (size_t i = 0; i < nbChar; ++i) {
+    waitpid(workerA[i], NULL, 0);
+    sem_destroy(&(pTurns->turnA[i]));
+  }
+  sem_destroy(&(pTurns->done));
+  shared_free(pTurns);
+  if (pShared->backend.backend != BACKEND_THREADS) {
+    backend_stop(&(pShared->backend), nbChar);
+  }
+
+  *pGame = *pShared;
+  shared_free(pShared);
   free(moves);
+  solver_delete(&solver);
   nbChar = 0;
+  if (pGame->pacer.skipRow > 0) {
+    // The last frame was skipped, the final state is always shown
+    _game_play_refresh_ui(pGame);
+  }
   
   // The end
+  if (pGame->headless) {
+    return;
+  }
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     const character_t* pC = &(pGame->playerA[i]);
     // Last display for each player
@@ -806,6 +870,37 @@ void game_start(game_t* pGame) {
   }
   //fclose(f);
   display_ending(DISPLAY, _game_ending_gm(pGame));
+  _game_report_overruns(DISPLAY, pGame);
+  pacer_report(&(pGame->pacer), stderr);
+}
+
+void game_summary(FILE* stream, const game_t* pGame) {
+  size_t nbOut = 0;
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    if (pGame->playerA[i].type == EXIT) {
+      ++nbOut;
+    }
+  }
+  fprintf(stream,
+          "game map=%s seed=%lu steps=%d result=%s players=%zu alive=%zu "
+          "out=%zu minotaurs=%zu minotaursAlive=%zu\n",
+          pGame->gameName, pGame->seed, pGame->steps,
+          display_ending_name(_game_ending_gm(pGame)), pGame->nbPlayer,
+          pGame->nbPlayerAlive, nbOut, pGame->nbMinotaur,
+          pGame->nbMinotaurAlive);
+  for (size_t i = 0; i < pGame->nbPlayer; ++i) {
+    const character_t* pC = &(pGame->playerA[i]);
+    fprintf(stream,
+            "player id=%zu ending=%s result=%s health=%.1f overruns=%zu\n", i,
+            character_ending_name(pC->ending),
+            display_ending_name(_game_ending_player(pGame, pC)), pC->health,
+            pC->nbOverrun);
+  }
+  for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
+    const character_t* pC = &(pGame->minotaurA[i]);
+    fprintf(stream, "minotaur id=%zu health=%.1f overruns=%zu\n", i,
+            pC->health, pC->nbOverrun);
+  }
 }
 
 void game_delete(game_t* pGame) {
@@ -818,7 +913,7 @@ void game_delete(game_t* pGame) {
   for (size_t i = 0; i < pGame->nbPlayer; ++i) {
     character_delete(pGame->pMap, &(pGame->playerA[i]));
   }
-  free(pGame->playerA);
+  shared_free(pGame->playerA);
   pGame->playerA = NULL;
   pGame->nbPlayer = 0;
   pGame->nbPlayerAlive = 0;
@@ -827,7 +922,7 @@ void game_delete(game_t* pGame) {
   for (size_t i = 0; i < pGame->nbMinotaur; ++i) {
     character_delete(pGame->pMap, &(pGame->minotaurA[i]));
   }
-  free(pGame->minotaurA);
+  shared_free(pGame->minotaurA);
   pGame->minotaurA = NULL;
   pGame->nbMinotaur = 0;
   pGame->nbMinotaurAlive = 0;
@@ -836,6 +931,7 @@ void game_delete(game_t* pGame) {
   pGame->maxMoves = 0;
   pGame->steps = 0;
   pGame->delay = 0;
+  pGame->headless = false;
   
   map_delete(pGame->pMap);
   pGame->pMap = NULL;
@@ -16,6 +16,7 @@
 #include "config.h"
 #include "display.h"
 #include "map.h"
+#include "sharedHeap.h"
 
 /**********************************/
 // Declaration of local functions.
@@ -63,10 +64,10 @@ void map_delete(map_t* pMap) {
   }
 
   for (size_t l = 0; l < pMap->y; ++l) {
-    free(pMap->m[l]);
+    shared_free(pMap->m[l]);
     pMap->m[l] = NULL;
   }
-  free(pMap->m);
+  shared_free(pMap->m);
   pMap->m = NULL;
   pMap->x = 0;
   pMap->y = 0;
@@ -98,8 +99,8 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize) {
   while (mapLoaded && !feof(pf)) {
     if (pMap->x == strlen(buffer)) {
       pMap->y = pMap->y + 1;
-      pMap->m = (char**)realloc(pMap->m, pMap->y * sizeof(char*));
-      pMap->m[pMap->y - 1] = (char*)malloc(nbColumn * sizeof(char));
+      pMap->m = (char**)shared_realloc(pMap->m, pMap->y * sizeof(char*));
+      pMap->m[pMap->y - 1] = (char*)shared_malloc(nbColumn * sizeof(char));
       strncpy((pMap->m)[pMap->y - 1], buffer, nbColumn);
       buffer[0] = '\0';  // flush the buffer
       if ((pMap->m[pMap->y - 1][nbColumn - 1] != '\0') ||
@@ -116,8 +117,8 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize) {
   // If buffer not empty
   if (mapLoaded && (pMap->x == strlen(buffer))) {
     pMap->y = pMap->y + 1;
-    pMap->m = (char**)realloc(pMap->m, pMap->y * sizeof(char*));
-    pMap->m[pMap->y - 1] = (char*)malloc(nbColumn * sizeof(char));
+    pMap->m = (char**)shared_realloc(pMap->m, pMap->y * sizeof(char*));
+    pMap->m[pMap->y - 1] = (char*)shared_malloc(nbColumn * sizeof(char));
     strncpy((pMap->m)[pMap->y - 1], buffer, nbColumn);
     if (pMap->m[pMap->y - 1][nbColumn - 1] != '\0') {
       fprintf(stderr, "Problem here: %s:%d\n", __FILE__, __LINE__);
@@ -135,14 +136,35 @@ bool map_reader(const char* filename, map_t* pMap, size_t mapMaxXSize) {
   return mapLoaded;
 }
 
+bool map_view_init(map_t* pView, char* rows, size_t x, size_t y) {
+  pView->x = x;
+  pView->y = y;
+  // A private view (never shared by the turns)
+  pView->m = (char**)malloc((y + 1) * sizeof(char*));
+  if (pView->m == NULL) {
+    return false;
+  }
+  for (size_t r = 0; r < y; ++r) {
+    pView->m[r] = &(rows[r * (x + 1)]);
+  }
+  return true;
+}
+
+void map_view_delete(map_t* pView) {
+  free(pView->m);
+  pView->m = NULL;
+  pView->x = 0;
+  pView->y = 0;
+}
+
 map_t* map_mask_init(const map_t* pMap) {
-  map_t* pMask = (map_t*)malloc(1 * sizeof(map_t));
+  map_t* pMask = (map_t*)shared_malloc(1 * sizeof(map_t));
   pMask->x = pMap->x;
   pMask->y = pMap->y;
 
-  pMask->m = (char**)malloc(pMask->y * sizeof(char*));
+  pMask->m = (char**)shared_malloc(pMask->y * sizeof(char*));
   for (size_t i = 0; i < pMask->y; ++i) {
-    pMask->m[i] = (char*)calloc(pMask->x, sizeof(char));
+    pMask->m[i] = (char*)shared_calloc(pMask->x, sizeof(char));
   }
 
   return pMask;
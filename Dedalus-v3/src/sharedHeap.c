@@ -0,0 +1,219 @@
+/**
+ * @file sharedHeap.c
+ * @brief Heap shared by the processes of a game.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <pthread.h>   // process-shared mutex
+#include <stdint.h>    // uintptr_t
+#include <string.h>    // memcpy, memset
+#include <sys/mman.h>  // mmap
+
+#include "sharedHeap.h"
+
+/**
+ * @brief Size of the header of a block (keeps blocks aligned for any type).
+ *
+ */
+#define SHARED_HEADER 16
+
+/**
+ * @brief Smallest block (log2).
+ *
+ */
+#define SHARED_MIN_CLASS 5
+
+/**
+ * @brief Number of block sizes (log2 of the largest one).
+ *
+ */
+#define SHARED_NB_CLASS 48
+
+/**
+ * @brief Header of a block.
+ *
+ */
+typedef union shared_block {
+  struct {
+    size_t cls;                       ///< The block is of 2^cls bytes.
+    union shared_block* next;         ///< Next free block of the same size.
+  } h;                                ///< The header.
+  unsigned char pad[SHARED_HEADER];   ///< Alignment of the data.
+} shared_block_t;
+
+/**
+ * @brief The heap, at the beginning of the mapping.
+ *
+ */
+typedef struct shared_heap {
+  pthread_mutex_t lock;                    ///< Shared by all the processes.
+  size_t size;                             ///< Size of the mapping.
+  size_t used;                             ///< Bytes already cut in blocks.
+  shared_block_t* freeA[SHARED_NB_CLASS];  ///< Free blocks of each size.
+} shared_heap_t;
+
+/**
+ * @brief The heap of the process (NULL if none).
+ *
+ */
+static shared_heap_t* _shared_heap = NULL;
+
+/**********************************/
+// Declaration of local functions.
+
+/**
+ * @brief Smallest block size for some data.
+ *
+ * @param[in] size Size of the data.
+ * @return size_t log2 of the block size, SHARED_NB_CLASS if too big.
+ */
+size_t _shared_class(size_t size);
+
+/**********************************/
+//  Public functions implementation
+
+bool shared_heap_init(size_t size) {
+  if ((_shared_heap != NULL) || (size < 2 * sizeof(shared_heap_t))) {
+    return false;
+  }
+  void* base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (base == MAP_FAILED) {
+    return false;
+  }
+
+  shared_heap_t* pHeap = (shared_heap_t*)base;
+  memset(pHeap, 0, sizeof(shared_heap_t));
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  int err = pthread_mutex_init(&(pHeap->lock), &attr);
+  pthread_mutexattr_destroy(&attr);
+  if (err != 0) {
+    munmap(base, size);
+    return false;
+  }
+  pHeap->size = size;
+  // Blocks start after the heap, aligned as their header
+  pHeap->used = (sizeof(shared_heap_t) + SHARED_HEADER - 1) &
+                ~(size_t)(SHARED_HEADER - 1);
+  _shared_heap = pHeap;
+  return true;
+}
+
+void shared_heap_delete() {
+  if (_shared_heap == NULL) {
+    return;
+  }
+  pthread_mutex_destroy(&(_shared_heap->lock));
+  munmap(_shared_heap, _shared_heap->size);
+  _shared_heap = NULL;
+}
+
+bool shared_heap_contains(const void* p) {
+  if (_shared_heap == NULL) {
+    return false;
+  }
+  uintptr_t begin = (uintptr_t)_shared_heap;
+  uintptr_t addr = (uintptr_t)p;
+  return (addr >= begin) && (addr < begin + _shared_heap->size);
+}
+
+void* shared_malloc(size_t size) {
+  if (_shared_heap == NULL) {
+    return malloc(size);
+  }
+  size_t cls = _shared_class(size);
+  if (cls >= SHARED_NB_CLASS) {
+    return NULL;
+  }
+  size_t blockSize = (size_t)1 << cls;
+
+  shared_block_t* pBlock = NULL;
+  pthread_mutex_lock(&(_shared_heap->lock));
+  if (_shared_heap->freeA[cls] != NULL) {
+    pBlock = _shared_heap->freeA[cls];
+    _shared_heap->freeA[cls] = pBlock->h.next;
+  } else if (blockSize <= _shared_heap->size - _shared_heap->used) {
+    pBlock = (shared_block_t*)((char*)_shared_heap + _shared_heap->used);
+    _shared_heap->used += blockSize;
+  }
+  pthread_mutex_unlock(&(_shared_heap->lock));
+
+  if (pBlock == NULL) {
+    return NULL;  // Full
+  }
+  pBlock->h.cls = cls;
+  pBlock->h.next = NULL;
+  return (char*)pBlock + SHARED_HEADER;
+}
+
+void* shared_calloc(size_t nb, size_t size) {
+  if (_shared_heap == NULL) {
+    return calloc(nb, size);
+  }
+  if ((size != 0) && (nb > ((size_t)-1) / size)) {
+    return NULL;
+  }
+  void* p = shared_malloc(nb * size);
+  if (p != NULL) {
+    // A recycled block is not clean
+    memset(p, 0, nb * size);
+  }
+  return p;
+}
+
+void* shared_realloc(void* p, size_t size) {
+  if (p == NULL) {
+    return shared_malloc(size);
+  }
+  if (!shared_heap_contains(p)) {
+    return realloc(p, size);
+  }
+  const shared_block_t* pBlock =
+      (const shared_block_t*)((char*)p - SHARED_HEADER);
+  size_t capacity = ((size_t)1 << pBlock->h.cls) - SHARED_HEADER;
+  if (size <= capacity) {
+    return p;
+  }
+  void* pNew = shared_malloc(size);
+  if (pNew == NULL) {
+    return NULL;
+  }
+  memcpy(pNew, p, capacity);
+  shared_free(p);
+  return pNew;
+}
+
+void shared_free(void* p) {
+  if (p == NULL) {
+    return;
+  }
+  if (!shared_heap_contains(p)) {
+    free(p);
+    return;
+  }
+  shared_block_t* pBlock = (shared_block_t*)((char*)p - SHARED_HEADER);
+  pthread_mutex_lock(&(_shared_heap->lock));
+  pBlock->h.next = _shared_heap->freeA[pBlock->h.cls];
+  _shared_heap->freeA[pBlock->h.cls] = pBlock;
+  pthread_mutex_unlock(&(_shared_heap->lock));
+}
+
+/**********************************/
+//  Local functions implementation
+
+size_t _shared_class(size_t size) {
+  if (size > ((size_t)1 << (SHARED_NB_CLASS - 1)) - SHARED_HEADER) {
+    return SHARED_NB_CLASS;
+  }
+  size_t cls = SHARED_MIN_CLASS;
+  while (((size_t)1 << cls) < size + SHARED_HEADER) {
+    ++cls;
+  }
+  return cls;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file sharedHeap.h
+ * @brief Heap shared by the processes of a game.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * The heap is a single anonymous shared mapping, created before any fork: a
+ * block is at the same address in every process and a change made by one
+ * process is seen by all the others. Blocks are rounded to powers of two and
+ * recycled by size; the heap is protected by a process-shared mutex.
+ *
+ * Without heap, or for a block that is not in it, the functions fall back on
+ * the standard allocator: a block can always be given to shared_free().
+ */
+#ifndef SHARED_HEAP_H
+#define SHARED_HEAP_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @brief Default size of the heap (only the touched pages use memory).
+ *
+ */
+#define SHARED_HEAP_SIZE ((size_t)1 << 30)
+
+/**
+ * @brief Create the heap of the process.
+ *
+ * @param[in] size Size of the mapping (in bytes).
+ * @return true The heap is created.
+ * @return false A heap already exists or the mapping failed.
+ * @note Processes forked afterwards share the heap.
+ */
+bool shared_heap_init(size_t size);
+
+/**
+ * @brief Unmap the heap (all its blocks are lost).
+ *
+ */
+void shared_heap_delete();
+
+/**
+ * @brief Says if a pointer is in the heap.
+ *
+ * @param[in] p The pointer.
+ * @return true p is in the heap.
+ * @return false There is no heap or p is outside it.
+ */
+bool shared_heap_contains(const void* p);
+
+/**
+ * @brief Allocate a block in the heap (as malloc).
+ *
+ * @param[in] size Size of the block.
+ * @return void* The block, NULL if the heap is full.
+ */
+void* shared_malloc(size_t size);
+
+/**
+ * @brief Allocate a zeroed array in the heap (as calloc).
+ *
+ * @param[in] nb Number of elements.
+ * @param[in] size Size of an element.
+ * @return void* The array, NULL if the heap is full.
+ */
+void* shared_calloc(size_t nb, size_t size);
+
+/**
+ * @brief Resize a block (as realloc).
+ *
+ * @param[in] p The block (may be NULL).
+ * @param[in] size Its new size.
+ * @return void* The resized block, NULL if the heap is full (p is kept).
+ * @note A block stays in its heap: a block of the standard allocator is
+ * resized by realloc.
+ */
+void* shared_realloc(void* p, size_t size);
+
+/**
+ * @brief Free a block (as free).
+ *
+ * @param[in] p The block (may be NULL).
+ */
+void shared_free(void* p);
+
+#endif  // End of SHARED_HEAP_H